@@ -32,6 +32,9 @@ static kint32_t fwk_gpc_of_init(struct fwk_device_node *sprt_node, struct fwk_de
 static kuint32_t g_iHal_gic_cnts = 0;
 static srt_ca7_gic_t sgrt_gic_global_data[CA7_MAX_GIC_NR] = {0};
 
+/*!< resolved on fwk_gpc_of_init, so that IRQ dispatch does not need to search domain by name */
+static struct fwk_irq_domain *sprt_gpc_irq_domain = mrt_nullptr;
+
 const struct fwk_of_device_id sgrt_fwk_irq_intcs_table[] =
 {
     { .compatible = "arm,cortex-a7-gic", .data = fwk_gic_of_init },
@@ -136,6 +139,10 @@ static void fwk_gic_initial(srt_ca7_gic_t *sprt_gic)
     for (i = 0; i < irqRegs; i++)
         mrt_writel(0xffffffffU, &sprt_dest->D_ICENABLER[i]);
 
+    /*!< SPI: default priority, so that fwk_request_irq() can set the others higher or lower */
+    for (i = 32; i < sprt_gic->gic_irqs; i++)
+        mrt_writeb(mrt_bit_mask(FWK_IRQ_PRIORITY_DEFAULT, 0xffU, 8 - __CA7_GIC_PRIO_BITS), &sprt_dest->D_IPRIORITYR[i]);
+
     /*!< Make all interrupts have higher priority */
     mrt_writel(mrt_bit_mask(0xffU, 0xffU, 8 - __CA7_GIC_PRIO_BITS), &sprt_cpu->C_PMR);
 
@@ -232,11 +239,13 @@ srt_ca7_gic_t *fwk_get_gic_data(kuint32_t gic_nr)
  */
 kint32_t fwk_gic_to_gpc_irq(kint32_t hwirq)
 {
+    struct fwk_irq_domain *sprt_domain = sprt_gpc_irq_domain;
+
     hwirq -= 32;
-    if (hwirq < 0)
-        return hwirq;
+    if ((hwirq < 0) || !sprt_domain)
+        return -1;
 
-    return fwk_irq_get_by_domain_name("gpc", hwirq);
+    return (hwirq < sprt_domain->hwirq_max) ? sprt_domain->revmap[hwirq] : -1;
 }
 
 /*!
@@ -355,6 +364,44 @@ static kbool_t gpc_irq_chip_is_enabled(struct fwk_irq_data *sprt_data)
     return !!mrt_getbit_fromwords(sprt_data->hwirq + 32, &sprt_dest->D_ISENABLER);
 }
 
+/*!
+ * @brief   set IRQ priority
+ * @param   sprt_data, priority
+ * @retval  none
+ * @note    GICD_IPRIORITYR: only the high __CA7_GIC_PRIO_BITS bits are implemented
+ */
+static void gpc_irq_chip_set_priority(struct fwk_irq_data *sprt_data, kuint32_t priority)
+{
+    srt_ca7_gic_t *sprt_gic = fwk_get_gic_data(0);
+    srt_ca7_gic_des_t *sprt_dest;
+
+    if (!sprt_data || (sprt_data->hwirq < 0))
+        return;
+
+    sprt_dest = mrt_get_gic_destributor(sprt_gic);
+    mrt_writeb(mrt_bit_mask(priority, 0xffU, 8U - __CA7_GIC_PRIO_BITS), &sprt_dest->D_IPRIORITYR[sprt_data->hwirq + 32]);
+}
+
+/*!
+ * @brief   resend IRQ
+ * @param   sprt_data
+ * @retval  true if it is set pending again
+ * @note    used to replay an interrupt which arrived while lazily disabled
+ */
+static kbool_t gpc_irq_chip_retrigger(struct fwk_irq_data *sprt_data)
+{
+    srt_ca7_gic_t *sprt_gic = fwk_get_gic_data(0);
+    srt_ca7_gic_des_t *sprt_dest;
+
+    if (!sprt_data || (sprt_data->hwirq < 0))
+        return false;
+
+    sprt_dest = mrt_get_gic_destributor(sprt_gic);
+    mrt_setbit_towords(sprt_data->hwirq + 32, &sprt_dest->D_ISPENDR);
+
+    return true;
+}
+
 /*!
  * @brief   allocate irq_domain for gpc
  * @param   sprt_domain
@@ -376,6 +423,8 @@ kint32_t gpc_irq_domain_alloc(struct fwk_irq_domain *sprt_domain, kuint32_t virq
     sprt_gc->sgrt_chip.irq_disable = gpc_irq_chip_disable;
     sprt_gc->sgrt_chip.irq_ack = gpc_irq_chip_ack;
     sprt_gc->sgrt_chip.irq_is_enabled = gpc_irq_chip_is_enabled;
+    sprt_gc->sgrt_chip.irq_set_priority = gpc_irq_chip_set_priority;
+    sprt_gc->sgrt_chip.irq_retrigger = gpc_irq_chip_retrigger;
 
     fwk_irq_setup_generic_chip(virq, nr_irqs, sprt_gc, mrt_nullptr);
 
@@ -432,6 +481,8 @@ kint32_t fwk_gpc_of_init(struct fwk_device_node *sprt_node, struct fwk_device_no
     if (!isValid(sprt_domain))
         return -ER_FAILD;
 
+    sprt_gpc_irq_domain = sprt_domain;
+
     return ER_NORMAL;
 }
 
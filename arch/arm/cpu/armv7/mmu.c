@@ -0,0 +1,93 @@
+/*
+ * ARM V7 MMU Management
+ *
+ * File Name:   mmu.c
+ * Author:      Yang Yujun
+ * E-mail:      <yujiantianhu@163.com>
+ * Created on:  2024.06.08
+ *
+ * Copyright (c) 2024   Yang Yujun <yujiantianhu@163.com>
+ *
+ */
+
+/*!< The includes */
+#include <configs/configs.h>
+#include <asm/mmu.h>
+
+/*!< API function */
+/*!
+ * @brief   get L1 translation table
+ * @param   none
+ * @retval  none
+ * @note    it is built by "_mmu_page_init" (head-common.S)
+ */
+static kuint32_t *mmu_get_l1_table(void)
+{
+	return (kuint32_t *)&__mmu_table_start;
+}
+
+/*!
+ * @brief   check if mmu is enabled
+ * @param   none
+ * @retval  none
+ * @note    none
+ */
+kbool_t mmu_is_enabled(void)
+{
+	return !!(__get_cp15_sctlr() & CP15_SCTLR_BIT_M);
+}
+
+/*!
+ * @brief   get section descriptor
+ * @param   virt
+ * @retval  descriptor (0: unmapped)
+ * @note    none
+ */
+kuint32_t mmu_get_section(kuaddr_t virt)
+{
+	return mmu_get_l1_table()[virt >> MMU_SECTION_SHIFT];
+}
+
+/*!
+ * @brief   map sections
+ * @param   virt, phys, size
+ * @param   attr: MMU_SECT_NORMAL, MMU_SECT_NORMAL_NC, MMU_SECT_DEVICE, or 0 (unmap)
+ * @retval  none
+ * @note    virt and phys are aligned down by 1MB
+ */
+void mmu_section_map(kuaddr_t virt, kuaddr_t phys, kusize_t size, kuint32_t attr)
+{
+	kuint32_t *ptr_table = mmu_get_l1_table();
+	kuaddr_t end = virt + size;
+	kuint32_t idx;
+
+	virt &= ~(MMU_SECTION_SIZE - 1);
+	phys &= ~(MMU_SECTION_SIZE - 1);
+
+	for (; virt < end; virt += MMU_SECTION_SIZE, phys += MMU_SECTION_SIZE)
+	{
+		idx = virt >> MMU_SECTION_SHIFT;
+		ptr_table[idx] = attr ? (phys | attr) : 0;
+
+		/*!< write the entry back for table walk, and then drop the old translation */
+		__set_cp15_dccmvac((kuaddr_t)&ptr_table[idx]);
+		mrt_dsb();
+		__set_cp15_tlbimva(virt);
+	}
+
+	mrt_dsb();
+	mrt_isb();
+}
+
+/*!
+ * @brief   unmap sections
+ * @param   virt, size
+ * @retval  none
+ * @note    access to the area will cause data abort
+ */
+void mmu_section_unmap(kuaddr_t virt, kusize_t size)
+{
+	mmu_section_map(virt, 0, size, 0);
+}
+
+/* end of file */
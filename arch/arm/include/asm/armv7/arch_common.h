@@ -73,5 +73,78 @@ static inline void set_irq_priority(kint32_t irqNumber, kuint32_t priority)
     mrt_set_irq_pri(irqNumber, priority);
 }
 
+/*!
+ * @brief   get D-Cache line size
+ * @param   none
+ * @retval  bytes of one line
+ * @note    CTR.DminLine: bit[19:16], log2 of the number of words
+ */
+static inline kuint32_t hw_dcache_line_size(void)
+{
+    return 4U << ((__get_cp15_ctr() >> 16) & 0xfU);
+}
+
+/*!
+ * @brief   clean D-Cache by address range
+ * @param   start, end
+ * @retval  none
+ * @note    write dirty lines back to memory, such as before device reads memory (DMA_TO_DEVICE)
+ */
+static inline void hw_dcache_clean_range(kuaddr_t start, kuaddr_t end)
+{
+    kuint32_t line = hw_dcache_line_size();
+
+    for (start &= ~(line - 1); start < end; start += line)
+        __set_cp15_dccmvac(start);
+
+    mrt_dsb();
+}
+
+/*!
+ * @brief   invalidate D-Cache by address range
+ * @param   start, end
+ * @retval  none
+ * @note    discard lines, such as after device writes memory (DMA_FROM_DEVICE);
+ *          the partial lines at both ends are cleaned first, data out of the range is kept
+ */
+static inline void hw_dcache_inv_range(kuaddr_t start, kuaddr_t end)
+{
+    kuint32_t line = hw_dcache_line_size();
+
+    if (start & (line - 1))
+    {
+        start &= ~(line - 1);
+        __set_cp15_dccimvac(start);
+        start += line;
+    }
+
+    if ((end & (line - 1)) && (end > start))
+    {
+        end &= ~(line - 1);
+        __set_cp15_dccimvac(end);
+    }
+
+    for (; start < end; start += line)
+        __set_cp15_dcimvac(start);
+
+    mrt_dsb();
+}
+
+/*!
+ * @brief   clean and invalidate D-Cache by address range
+ * @param   start, end
+ * @retval  none
+ * @note    none
+ */
+static inline void hw_dcache_flush_range(kuaddr_t start, kuaddr_t end)
+{
+    kuint32_t line = hw_dcache_line_size();
+
+    for (start &= ~(line - 1); start < end; start += line)
+        __set_cp15_dccimvac(start);
+
+    mrt_dsb();
+}
+
 
 #endif /* __ARCH_COMMON_H */
@@ -41,6 +41,11 @@
 /*!< 64bytes */
 #define ARCH_FRAME_SIZE                 (68)
 
+/*!< IRQ nesting: every level runs its handler in SVC mode on its own stack, not on the thread stack */
+#define ARCH_IRQ_NEST_MAX               (8)
+#define ARCH_IRQ_STACK_SHIFT            (12)
+#define ARCH_IRQ_STACK_SIZE             (1 << ARCH_IRQ_STACK_SHIFT)                         /*!< 4KB per level */
+
 /*!< CPSR */
 /*!< 
  * Equaling to  "mrs r0, cpsr \n orr r0, r0, #CPSR_BIT_I \n msr cpsr, r0" 
@@ -102,6 +107,9 @@
 #define WRITE_CP15_BP(Rn)               WRITE_CP15_REGISTER(0, Rn, c7,  c5,  6)
 #define WRITE_CP15_DSB(Rn)              WRITE_CP15_REGISTER(0, Rn, c7,  c10, 4)
 #define WRITE_CP15_ISB(Rn)              WRITE_CP15_REGISTER(0, Rn, c7,  c5,  4)
+#define WRITE_CP15_TTBR0(Rn)            WRITE_CP15_REGISTER(0, Rn, c2,  c0,  0)
+#define WRITE_CP15_TTBCR(Rn)            WRITE_CP15_REGISTER(0, Rn, c2,  c0,  2)
+#define WRITE_CP15_DACR(Rn)             WRITE_CP15_REGISTER(0, Rn, c3,  c0,  0)
 
 #define CP15_SCTLR_BIT_M	            (1 << 0)	        /*!< MMU enable */
 #define CP15_SCTLR_BIT_A	            (1 << 1)	        /*!< Alignment abort enable */
@@ -131,4 +139,31 @@
 #define CP15_SCTLR_BIT_AFE	            (1 << 29)	        /*!< Access flag enable */
 #define CP15_SCTLR_BIT_TE	            (1 << 30)	        /*!< Thumb exception enable */
 
+/*!< MMU: short-descriptor translation table, 1MB section */
+#define MMU_SECTION_SHIFT               (20)
+#define MMU_SECTION_SIZE                (1 << MMU_SECTION_SHIFT)
+#define MMU_L1_ENTRIES                  (4096)
+#define MMU_L1_TABLE_SIZE               (MMU_L1_ENTRIES << 2)   /*!< 16KB, the base must be aligned by 16KB */
+
+#define MMU_SECT_TYPE                   (0x2)               /*!< bit[1:0] = 0b10: section */
+#define MMU_SECT_B                      (1 << 2)            /*!< bufferable */
+#define MMU_SECT_C                      (1 << 3)            /*!< cacheable */
+#define MMU_SECT_XN                     (1 << 4)            /*!< execute-never */
+#define MMU_SECT_DOMAIN(x)              ((x) << 5)
+#define MMU_SECT_AP_RW                  (0x3 << 10)         /*!< AP[2:0] = 0b011: read/write, for PL1 and PL0 */
+#define MMU_SECT_TEX(x)                 ((x) << 12)
+#define MMU_SECT_S                      (1 << 16)           /*!< shareable */
+
+/*!< TEX:C:B = 001:1:1, normal, outer and inner write-back, write-allocate */
+#define MMU_SECT_NORMAL                 (MMU_SECT_TYPE | MMU_SECT_AP_RW | MMU_SECT_TEX(1) | MMU_SECT_C | MMU_SECT_B)
+/*!< TEX:C:B = 001:0:0, normal, non-cacheable */
+#define MMU_SECT_NORMAL_NC              (MMU_SECT_TYPE | MMU_SECT_AP_RW | MMU_SECT_TEX(1) | MMU_SECT_XN)
+/*!< TEX:C:B = 000:0:1, shareable device */
+#define MMU_SECT_DEVICE                 (MMU_SECT_TYPE | MMU_SECT_AP_RW | MMU_SECT_B | MMU_SECT_XN)
+
+/*!< TTBR0: table walk is inner (IRGN = 0b01) and outer (RGN = 0b01) write-back, write-allocate */
+#define MMU_TTBR_WALK_WBWA              ((1 << 6) | (1 << 3))
+/*!< DACR: all domains are client, access permission is checked */
+#define MMU_DACR_ALL_CLIENT             (0x55555555)
+
 #endif /* __ASM_CONFIG_H */
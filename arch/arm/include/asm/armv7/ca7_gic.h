@@ -40,6 +40,20 @@ typedef struct ca7_gic
 #define __CA7_GIC_PRIO_BITS                         5   
 #define __CA7_GIC_MAX_IRQS                          1020
 
+/*!< GICD_CTLR */
+#define CA7_GICD_CTLR_ENABLE_GRP0                   mrt_bit(0)
+#define CA7_GICD_CTLR_ENABLE_GRP1                   mrt_bit(1)
+
+/*!< GICC_CTLR (secure view) */
+#define CA7_GICC_CTLR_ENABLE_GRP0                   mrt_bit(0)
+#define CA7_GICC_CTLR_ENABLE_GRP1                   mrt_bit(1)
+#define CA7_GICC_CTLR_ACKCTL                        mrt_bit(2)      /*!< secure IAR/EOIR handle group1 too */
+#define CA7_GICC_CTLR_FIQEN                         mrt_bit(3)      /*!< group0 is signaled as FIQ */
+#define CA7_GICC_CTLR_CBPR                          mrt_bit(4)      /*!< GICC_BPR controls group1 too */
+
+/*!< group0 (FIQ) lines take the highest priority, so that they are signaled over any running IRQ */
+#define CA7_GIC_FIQ_PRIORITY                        (0)
+
 typedef struct ca7_gic_des
 {
     /*!< distributor */
@@ -289,4 +303,105 @@ static inline kuint32_t local_irq_getPriority(kuint32_t irq_number)
     return (kuint32_t)mrt_getbit_u8(0xffU, 8U - __CA7_GIC_PRIO_BITS, &sprt_dest->D_IPRIORITYR[hwirq]);
 }
 
+/*!
+ * @brief   gic set priority mask
+ * @param   priority
+ * @retval  none
+ * @note    only the interrupts with higher priority (lower value) than "priority" are signaled
+ */
+static inline void local_irq_setPriorityMask(kuint32_t priority)
+{
+    srt_ca7_gic_t *sprt_gic = fwk_get_gic_data(0);
+    srt_ca7_gic_cpu_t *sprt_cpu;
+
+    sprt_cpu = mrt_get_gic_interface(sprt_gic);
+    mrt_writel(mrt_bit_mask(priority, 0xffU, 8U - __CA7_GIC_PRIO_BITS), &sprt_cpu->C_PMR);
+}
+
+/*!
+ * @brief   gic get priority mask
+ * @param   none
+ * @retval  priority
+ * @note    none
+ */
+static inline kuint32_t local_irq_getPriorityMask(void)
+{
+    srt_ca7_gic_t *sprt_gic = fwk_get_gic_data(0);
+    srt_ca7_gic_cpu_t *sprt_cpu;
+
+    sprt_cpu = mrt_get_gic_interface(sprt_gic);
+    return mrt_mask(sprt_cpu->C_PMR, 0xffU) >> (8U - __CA7_GIC_PRIO_BITS);
+}
+
+/*!
+ * @brief   gic raise priority mask
+ * @param   priority
+ * @retval  the previous priority mask, for local_irq_setPriorityMask()
+ * @note    block the interrupts whose priority is "priority" or lower, but never unblock any
+ */
+static inline kuint32_t local_irq_raisePriorityMask(kuint32_t priority)
+{
+    kuint32_t old = local_irq_getPriorityMask();
+
+    if (priority < old)
+        local_irq_setPriorityMask(priority);
+
+    return old;
+}
+
+/*!
+ * @brief   gic set group
+ * @param   irq_number, group: 0 (FIQ) or 1 (IRQ)
+ * @retval  none
+ * @note    only valid after local_fiq_initial()
+ */
+static inline void local_irq_setGroup(kint32_t irq_number, kuint32_t group)
+{
+    srt_ca7_gic_t *sprt_gic = fwk_get_gic_data(0);
+    srt_ca7_gic_des_t *sprt_dest;
+    kint32_t hwirq;
+
+    hwirq = fwk_gpc_to_gic_irq(irq_number);
+    if (hwirq < 0)
+        return;
+
+    sprt_dest = mrt_get_gic_destributor(sprt_gic);
+    if (group)
+        mrt_setbit_towords(hwirq, &sprt_dest->D_IGROUPR);
+    else
+        mrt_clrbit_towords(hwirq, &sprt_dest->D_IGROUPR);
+}
+
+/*!
+ * @brief   gic split interrupts into FIQ and IRQ
+ * @param   none
+ * @retval  error code
+ * @note    all interrupts are moved to group1 (IRQ), and group0 is signaled as FIQ;
+ *          the groups can only be configured in secure state, otherwise GICD_IGROUPR reads as zero
+ */
+static inline kint32_t local_fiq_initial(void)
+{
+    srt_ca7_gic_t *sprt_gic = fwk_get_gic_data(0);
+    srt_ca7_gic_des_t *sprt_dest;
+    srt_ca7_gic_cpu_t *sprt_cpu;
+    kuint32_t i, irqRegs;
+
+    sprt_dest = mrt_get_gic_destributor(sprt_gic);
+    sprt_cpu = mrt_get_gic_interface(sprt_gic);
+    irqRegs = mrt_mask(sprt_dest->D_TYPER, 0x1fU) + 1;
+
+    for (i = 0; i < irqRegs; i++)
+        mrt_writel(0xffffffffU, &sprt_dest->D_IGROUPR[i]);
+
+    /*!< read back: the write is ignored in non-secure state */
+    if (!(*(volatile kuint32_t *)&sprt_dest->D_IGROUPR[0]))
+        return -ER_NSUPPORT;
+
+    mrt_writel(CA7_GICD_CTLR_ENABLE_GRP0 | CA7_GICD_CTLR_ENABLE_GRP1, &sprt_dest->D_CTLR);
+    mrt_writel(CA7_GICC_CTLR_ENABLE_GRP0 | CA7_GICC_CTLR_ENABLE_GRP1 | CA7_GICC_CTLR_ACKCTL |
+                CA7_GICC_CTLR_FIQEN | CA7_GICC_CTLR_CBPR, &sprt_cpu->C_CTLR);
+
+    return ER_NORMAL;
+}
+
 #endif /* __CA7_GIC_H */
@@ -354,6 +354,88 @@ static inline void __set_cp15_isb(kuint32_t result)
     );
 }
 
+/*!
+ * @brief  	__get_cp15_ctr
+ * @param  	none
+ * @retval 	none
+ * @note   	read cp15 CTR (Cache Type Register)
+ */
+static inline kuint32_t __get_cp15_ctr(void)
+{
+    kuint32_t result;
+
+    __asm__ __volatile__ (
+        " mrc p15, 0, %0, c0, c0, 1  "
+        : "=r"(result)
+    );
+
+    return result;
+}
+
+/*!
+ * @brief  	__set_cp15_dccmvac
+ * @param  	none
+ * @retval 	none
+ * @note   	clean D-Cache line by MVA to PoC
+ */
+static inline void __set_cp15_dccmvac(kuint32_t address)
+{
+    __asm__ __volatile__ (
+        " mcr p15, 0, %0, c7, c10, 1 "
+        :
+        : "r"(address)
+        : "memory"
+    );
+}
+
+/*!
+ * @brief  	__set_cp15_dcimvac
+ * @param  	none
+ * @retval 	none
+ * @note   	invalidate D-Cache line by MVA to PoC
+ */
+static inline void __set_cp15_dcimvac(kuint32_t address)
+{
+    __asm__ __volatile__ (
+        " mcr p15, 0, %0, c7, c6, 1  "
+        :
+        : "r"(address)
+        : "memory"
+    );
+}
+
+/*!
+ * @brief  	__set_cp15_dccimvac
+ * @param  	none
+ * @retval 	none
+ * @note   	clean and invalidate D-Cache line by MVA to PoC
+ */
+static inline void __set_cp15_dccimvac(kuint32_t address)
+{
+    __asm__ __volatile__ (
+        " mcr p15, 0, %0, c7, c14, 1 "
+        :
+        : "r"(address)
+        : "memory"
+    );
+}
+
+/*!
+ * @brief  	__set_cp15_tlbimva
+ * @param  	none
+ * @retval 	none
+ * @note   	invalidate unified TLB entry by MVA
+ */
+static inline void __set_cp15_tlbimva(kuint32_t address)
+{
+    __asm__ __volatile__ (
+        " mcr p15, 0, %0, c8, c7, 1  "
+        :
+        : "r"(address)
+        : "memory"
+    );
+}
+
 static inline kuint32_t __get_cpsr(void)
 {
     kuint32_t result = 0;
@@ -378,4 +460,28 @@ static inline void __set_cpsr(kuint32_t result)
     );
 }
 
+/*!
+ * @brief  	mrt_local_irq_save
+ * @param  	flags: kuint32_t, saves cpsr
+ * @retval 	none
+ * @note   	disable irq, and save the previous state for mrt_local_irq_restore
+ */
+#define mrt_local_irq_save(flags)    \
+    do {   \
+        (flags) = __get_cpsr();   \
+        mrt_disable_cpu_irq();   \
+    } while (0)
+
+/*!
+ * @brief  	mrt_local_irq_restore
+ * @param  	flags: got from mrt_local_irq_save
+ * @retval 	none
+ * @note   	enable irq only if it was enabled on mrt_local_irq_save, so that the pairs can be nested
+ */
+#define mrt_local_irq_restore(flags)    \
+    do {   \
+        if (!((flags) & CPSR_BIT_I))   \
+            mrt_enable_cpu_irq();   \
+    } while (0)
+
 #endif /* __GCC_CONFIG_H */
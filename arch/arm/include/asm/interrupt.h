@@ -18,9 +18,63 @@
 #include <common/error_types.h>
 #include <common/generic.h>
 
+/*!< The defines */
+/*!< interrupts dispatched at most per IRQ exception entry, the rest are left to the next entry */
+#define IRQ_DRAIN_BUDGET                            (8)
+
+/*!< GICC_IAR: 1020 ~ 1023 are special interrupt IDs, 1023 means no pending interrupt */
+#define IRQ_GIC_ID_MASK                             (0x3ffU)
+#define IRQ_GIC_ID_SPECIAL                          (1020)
+
+/*!< the deepest IRQ nesting; beyond this, handlers run with IRQ disabled */
+#define IRQ_NEST_MAX                                (ARCH_IRQ_NEST_MAX)
+
+/*!< GIC interrupts that can be routed to FIQ at the same time */
+#define FIQ_HANDLER_MAX                             (4)
+
+/*!<
+ * FIQ handler: it runs in FIQ mode on the FIQ stack, with IRQ and FIQ disabled.
+ * It must be short and must not call any kernel API (lock, printk, wakeup ...),
+ * because FIQ is not masked by spin_lock_irqsave and may interrupt any of them.
+ */
+typedef void (*fiq_handler_t)(void *data);
+
+typedef struct fiq_handler
+{
+    kint32_t hwirq;                                 /*!< GIC interrupt ID */
+    fiq_handler_t handler;                          /*!< mrt_nullptr: free slot */
+    void *data;
+    kuint32_t count;
+
+} srt_fiq_handler_t;
+
+typedef struct irq_entry_stats
+{
+    kuint32_t entries;                              /*!< IRQ exception entries */
+    kuint32_t handled;                              /*!< interrupts dispatched */
+    kuint32_t spurious;                             /*!< entries which found nothing pending */
+    kuint32_t budget_exhausted;                     /*!< entries which used up IRQ_DRAIN_BUDGET */
+    kuint32_t max_coalesced;                        /*!< the most interrupts dispatched by one entry */
+    kuint32_t coalesced[IRQ_DRAIN_BUDGET + 1];      /*!< coalesced[n]: entries that dispatched n interrupts */
+    kuint32_t nested;                               /*!< entries which preempted another IRQ handler */
+    kuint32_t max_nest_level;
+    kuint32_t replayed;                             /*!< interrupts run by exec_irq_replay, not by an entry */
+    kuint32_t fiq_entries;                          /*!< FIQ exception entries */
+    kuint32_t fiq_spurious;                         /*!< FIQ entries which found no registered handler */
+
+} srt_irq_entry_stats_t;
+
+/*!< The globals */
+TARGET_EXT kuint32_t g_irq_nest_level;
+TARGET_EXT kuint8_t g_irq_nest_stacks[IRQ_NEST_MAX][ARCH_IRQ_STACK_SIZE];
+
 /*!< The functions */
 TARGET_EXT void exec_fiq_handler(void);
 TARGET_EXT void exec_irq_handler(void);
+TARGET_EXT void exec_irq_replay(kint32_t softIrq);
 TARGET_EXT void exec_software_irq_handler(void);
+TARGET_EXT struct irq_entry_stats *exec_irq_get_entry_stats(void);
+TARGET_EXT kint32_t fwk_request_fiq(kint32_t irq, fiq_handler_t handler, void *data);
+TARGET_EXT void fwk_free_fiq(kint32_t irq);
 
 #endif /* __INTERRUPT_H */
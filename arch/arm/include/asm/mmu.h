@@ -0,0 +1,31 @@
+/*
+ * ARM V7 MMU API Function
+ *
+ * File Name:   mmu.h
+ * Author:      Yang Yujun
+ * E-mail:      <yujiantianhu@163.com>
+ * Created on:  2024.06.08
+ *
+ * Copyright (c) 2024   Yang Yujun <yujiantianhu@163.com>
+ *
+ */
+
+#ifndef __MMU_H
+#define __MMU_H
+
+/*!< The includes*/
+#include <common/basic_types.h>
+#include <common/error_types.h>
+#include <common/generic.h>
+
+/*!< The globals */
+TARGET_EXT kuaddr_t __mmu_table_start;
+TARGET_EXT kuaddr_t __mmu_table_end;
+
+/*!< The functions */
+TARGET_EXT kbool_t mmu_is_enabled(void);
+TARGET_EXT kuint32_t mmu_get_section(kuaddr_t virt);
+TARGET_EXT void mmu_section_map(kuaddr_t virt, kuaddr_t phys, kusize_t size, kuint32_t attr);
+TARGET_EXT void mmu_section_unmap(kuaddr_t virt, kusize_t size);
+
+#endif /* __MMU_H */
@@ -16,17 +16,184 @@
 #include <common/io_stream.h>
 #include <asm/interrupt.h>
 #include <platform/irq/fwk_irq_types.h>
+#include <kernel/spinlock.h>
+
+/*!< The globals */
+static struct irq_entry_stats sgrt_irq_entry_stats = { 0 };
+
+/*!< FIQ handlers are looked up by exec_fiq_handler, they are few, so a linear scan is the fastest */
+static struct fiq_handler sgrt_fiq_handlers[FIQ_HANDLER_MAX] = { 0 };
+static kuint32_t g_fiq_handler_cnts = 0;
+static kbool_t g_fiq_group_enabled = false;
+static DECLARE_SPIN_LOCK(sgrt_fiq_lock);
+
+/*!< the number of IRQ handlers running, checked by _irq_handler: only the outermost one may preempt thread */
+kuint32_t g_irq_nest_level = 0;
+
+/*!< g_irq_nest_stacks[n]: stack of the handler which runs at nesting level n (0: outermost), see _irq_handler */
+kuint8_t g_irq_nest_stacks[IRQ_NEST_MAX][ARCH_IRQ_STACK_SIZE] __align(8);
 
 /*!< API function */
+/*!
+ * @brief   find and call the FIQ handler of hwirq
+ * @param   hwirq: GIC interrupt ID
+ * @retval  true if hwirq is routed to FIQ
+ * @note    none
+ */
+static kbool_t exec_fiq_dispatch(kint32_t hwirq)
+{
+    struct fiq_handler *sprt_fiq;
+
+    for (sprt_fiq = sgrt_fiq_handlers; sprt_fiq < &sgrt_fiq_handlers[FIQ_HANDLER_MAX]; sprt_fiq++)
+    {
+        if (sprt_fiq->handler && (sprt_fiq->hwirq == hwirq))
+        {
+            sprt_fiq->count++;
+            sprt_fiq->handler(sprt_fiq->data);
+            return true;
+        }
+    }
+
+    return false;
+}
+
 /*!
  * @brief   exec_fiq_handler
  * @param   none
  * @retval  none
  * @note    FIQ exception
+ *          _fiq_handler only saves r0 ~ r3, r12 and lr on the FIQ stack: r8 ~ r14 are banked, and
+ *          r4 ~ r11 are saved by the callee if used; there is no mode switch and no preemption check,
+ *          against the 68 bytes frame, the SVC switch and the scheduling check of the IRQ path
  */
 void exec_fiq_handler(void)
 {
-    
+    kint32_t hardirq;
+
+    sgrt_irq_entry_stats.fiq_entries++;
+
+    /*!< 
+     * GICC_CTLR.AckCtl is set, so IAR returns the highest priority pending interrupt of both groups;
+     * FIQ lines have the highest priority, so it is the one that raised this FIQ
+     */
+    hardirq = local_irq_acknowledge();
+    if (mrt_mask(hardirq, IRQ_GIC_ID_MASK) >= IRQ_GIC_ID_SPECIAL)
+    {
+        sgrt_irq_entry_stats.fiq_spurious++;
+        return;
+    }
+
+    if (!exec_fiq_dispatch(hardirq))
+        sgrt_irq_entry_stats.fiq_spurious++;
+
+    local_irq_deactivate(hardirq);
+}
+
+/*!
+ * @brief   route an interrupt to FIQ
+ * @param   irq: virtual irq number, the same as fwk_request_irq()
+ * @param   handler: see fiq_handler_t
+ * @param   data: argument of handler
+ * @retval  error code
+ * @note    the line is moved to GIC group0 with the highest priority, and enabled;
+ *          the first call splits the GIC into group0 (FIQ) and group1 (IRQ), which needs secure state
+ */
+kint32_t fwk_request_fiq(kint32_t irq, fiq_handler_t handler, void *data)
+{
+    struct fwk_irq_desc *sprt_desc;
+    struct fiq_handler *sprt_fiq, *sprt_free = mrt_nullptr;
+    kint32_t hwirq, retval = ER_NORMAL;
+
+    if (!handler)
+        return -ER_NULLPTR;
+
+    hwirq = fwk_gpc_to_gic_irq(irq);
+    if (hwirq < 0)
+        return -ER_NOTFOUND;
+
+    /*!< a line can not be an IRQ and a FIQ at the same time */
+    sprt_desc = fwk_irq_to_desc(irq);
+    if (isValid(sprt_desc) && !mrt_list_head_empty(&sprt_desc->sgrt_action))
+        return -ER_BUSY;
+
+    spin_lock_irqsave(&sgrt_fiq_lock);
+
+    for (sprt_fiq = sgrt_fiq_handlers; sprt_fiq < &sgrt_fiq_handlers[FIQ_HANDLER_MAX]; sprt_fiq++)
+    {
+        if (!sprt_fiq->handler)
+            sprt_free = sprt_free ? sprt_free : sprt_fiq;
+        else if (sprt_fiq->hwirq == hwirq)
+        {
+            retval = -ER_BUSY;
+            goto out;
+        }
+    }
+
+    if (!sprt_free)
+    {
+        retval = -ER_NOMEM;
+        goto out;
+    }
+
+    if (!g_fiq_group_enabled)
+    {
+        retval = local_fiq_initial();
+        if (retval)
+            goto out;
+
+        g_fiq_group_enabled = true;
+    }
+
+    /*!< the slot must be complete before the line is enabled */
+    sprt_free->hwirq = hwirq;
+    sprt_free->data = data;
+    sprt_free->count = 0;
+    sprt_free->handler = handler;
+    g_fiq_handler_cnts++;
+
+    local_irq_setGroup(irq, 0);
+    local_irq_setPriority(irq, CA7_GIC_FIQ_PRIORITY);
+    local_irq_enable(irq);
+
+out:
+    spin_unlock_irqrestore(&sgrt_fiq_lock);
+    return retval;
+}
+
+/*!
+ * @brief   give back a FIQ line
+ * @param   irq: virtual irq number
+ * @retval  none
+ * @note    the line is disabled and moved back to group1 (IRQ) with the default priority
+ */
+void fwk_free_fiq(kint32_t irq)
+{
+    struct fiq_handler *sprt_fiq;
+    kint32_t hwirq;
+
+    hwirq = fwk_gpc_to_gic_irq(irq);
+    if (hwirq < 0)
+        return;
+
+    spin_lock_irqsave(&sgrt_fiq_lock);
+
+    for (sprt_fiq = sgrt_fiq_handlers; sprt_fiq < &sgrt_fiq_handlers[FIQ_HANDLER_MAX]; sprt_fiq++)
+    {
+        if (!sprt_fiq->handler || (sprt_fiq->hwirq != hwirq))
+            continue;
+
+        /*!< disable the line first, so that exec_fiq_handler never sees a half cleared slot */
+        local_irq_disable(irq);
+        local_irq_setGroup(irq, 1);
+        local_irq_setPriority(irq, FWK_IRQ_PRIORITY_DEFAULT);
+
+        sprt_fiq->handler = mrt_nullptr;
+        sprt_fiq->data = mrt_nullptr;
+        g_fiq_handler_cnts--;
+        break;
+    }
+
+    spin_unlock_irqrestore(&sgrt_fiq_lock);
 }
 
 /*!
@@ -37,17 +204,114 @@ void exec_fiq_handler(void)
  */
 void exec_irq_handler(void)
 {
+    struct irq_entry_stats *sprt_stats = &sgrt_irq_entry_stats;
     kint32_t hardirq, softIrq;
+    kuint32_t count;
+    kbool_t nestable, is_fiq;
 
-    /*!< read IAR, enable IRQ */
-    hardirq = local_irq_acknowledge();
+    /*!< 
+     * _irq_handler calls here in SVC mode, with lr_svc saved; so IRQ can be enabled while dispatching,
+     * and the GIC only signals the interrupts with higher priority than the running one
+     */
+    g_irq_nest_level++;
+    nestable = (g_irq_nest_level < IRQ_NEST_MAX);
+
+    if (g_irq_nest_level > 1)
+        sprt_stats->nested++;
+    if (g_irq_nest_level > sprt_stats->max_nest_level)
+        sprt_stats->max_nest_level = g_irq_nest_level;
+
+    /*!< 
+     * drain all pending interrupts on one entry, so that a burst costs one context save/restore;
+     * the budget bounds the time spent here, since the thread preemption check comes after return
+     */
+    for (count = 0; count < IRQ_DRAIN_BUDGET; count++)
+    {
+        /*!< read IAR, enable IRQ */
+        hardirq = local_irq_acknowledge();
+        if (mrt_mask(hardirq, IRQ_GIC_ID_MASK) >= IRQ_GIC_ID_SPECIAL)
+            break;
+
+        /*!< a FIQ line which became pending after this IRQ was signaled can be acknowledged here */
+        if (g_fiq_handler_cnts)
+        {
+            mrt_disable_cpu_fiq();
+            is_fiq = exec_fiq_dispatch(hardirq);
+            mrt_enable_cpu_fiq();
+
+            if (is_fiq)
+            {
+                local_irq_deactivate(hardirq);
+                continue;
+            }
+        }
+
+        /*!< find system soft IRQn, and excute IRQ handler */
+        softIrq = fwk_gic_to_gpc_irq(hardirq);
+
+        if (nestable)
+            mrt_enable_cpu_irq();
+
+        fwk_do_irq_handler(softIrq);
+
+        /*!< IRQ must be disabled before EOI, otherwise the same priority may nest */
+        if (nestable)
+            mrt_disable_cpu_irq();
+
+        /*!< write IAR, disable IRQ */
+        local_irq_deactivate(hardirq);
+    }
+
+    sprt_stats->entries++;
+    sprt_stats->handled += count;
+    sprt_stats->coalesced[count]++;
+
+    if (!count)
+        sprt_stats->spurious++;
+    if (count == IRQ_DRAIN_BUDGET)
+        sprt_stats->budget_exhausted++;
+    if (count > sprt_stats->max_coalesced)
+        sprt_stats->max_coalesced = count;
+
+    g_irq_nest_level--;
+}
+
+/*!
+ * @brief   exec_irq_replay
+ * @param   softIrq
+ * @retval  none
+ * @note    runs the handlers of an interrupt which its controller can not resend, from thread context;
+ *          IRQ stays disabled, and the nest level is raised as on the IRQ path, so handlers see IRQ context
+ */
+void exec_irq_replay(kint32_t softIrq)
+{
+    struct irq_entry_stats *sprt_stats = &sgrt_irq_entry_stats;
+    kuint32_t flags;
+
+    mrt_local_irq_save(flags);
+
+    g_irq_nest_level++;
+    if (g_irq_nest_level > sprt_stats->max_nest_level)
+        sprt_stats->max_nest_level = g_irq_nest_level;
 
-    /*!< find system soft IRQn, and excute IRQ handler */
-    softIrq = fwk_gic_to_gpc_irq(hardirq);
     fwk_do_irq_handler(softIrq);
 
-    /*!< write IAR, disable IRQ */
-    local_irq_deactivate(hardirq);
+    sprt_stats->handled++;
+    sprt_stats->replayed++;
+    g_irq_nest_level--;
+
+    mrt_local_irq_restore(flags);
+}
+
+/*!
+ * @brief   exec_irq_get_entry_stats
+ * @param   none
+ * @retval  statistics of IRQ exception entries
+ * @note    none
+ */
+struct irq_entry_stats *exec_irq_get_entry_stats(void)
+{
+    return &sgrt_irq_entry_stats;
 }
 
 /*!
@@ -18,6 +18,7 @@
 #include <platform/usb/fwk_hid.h>
 #include <platform/usb/fwk_urb.h>
 #include <platform/usb/host/fwk_usb_host.h>
+#include <platform/fwk_dma.h>
 #include "imx6_common.h"
 
 /*!< The defines */
@@ -37,6 +38,10 @@
 /*!< How many endpoints are supported in the stack */
 #define IMX_GADGET_CONFIG_ENDPOINTS                         (4U)
 
+/*!< one queue head per endpoint & direction, 64 bytes per QH */
+#define IMX_GADGET_QH_SIZE                                  (64U)
+#define IMX_GADGET_QH_LIST_SIZE                             ((IMX_GADGET_CONFIG_ENDPOINTS << 1) * IMX_GADGET_QH_SIZE)
+
 typedef struct imx_gadget
 {
     srt_imx_usbotg_t *sprt_otg;
@@ -47,7 +52,9 @@ typedef struct imx_gadget
 
 } srt_imx_gadget_t;
 
-static kuint8_t g_iImx_gadget_queue_head[IMX_GADGET_CONFIG_ENDPOINTS << 1] __align(2048);
+/*!< QH list is accessed by controller directly, it is allocated from dma coherent pool (aligned by 4KB >= 2KB) */
+static kuint8_t *g_iImx_gadget_queue_head = mrt_nullptr;
+static dma_addr_t g_iImx_gadget_queue_head_dma = 0;
 
 /*!< The functions */
 irq_return_t imx6_gadget_isr(void *ptrDev);
@@ -229,7 +236,15 @@ static kint32_t imx6_gadget_ehci_otg_initial(srt_imx_usbotg_t *sprt_otg)
      *      field will reference a list of up to 32 Queue Head (QH) (that is, one queue head per endpoint & direction)
      *      (The field bit[10:0] is reserved, that is, QH must be aligned by 2048 bytes)
      */
-    mrt_writel(g_iImx_gadget_queue_head, &sprt_otg->ENDPTLISTADDR);
+    if (!g_iImx_gadget_queue_head)
+    {
+        g_iImx_gadget_queue_head = fwk_dma_alloc_coherent(mrt_nullptr, IMX_GADGET_QH_LIST_SIZE, 
+                                                    &g_iImx_gadget_queue_head_dma, GFP_KERNEL | GFP_ZERO);
+        if (!isValid(g_iImx_gadget_queue_head))
+            return -ER_NOMEM;
+    }
+
+    mrt_writel(g_iImx_gadget_queue_head_dma, &sprt_otg->ENDPTLISTADDR);
 
     return ER_NORMAL;
 }
@@ -94,7 +94,8 @@ void imx6ull_systick_init(void)
 	 */
 	mrt_resetl(&sprt_tick->IR);
 
-	retval = fwk_request_irq(irq, imx6_systick_isr, 0, "imx6-systick", sprt_tick);
+	/*!< the tick must not be delayed by slow handlers of other devices */
+	retval = fwk_request_irq(irq, imx6_systick_isr, IRQF_PRIORITY(FWK_IRQ_PRIORITY_HIGH), "imx6-systick", sprt_tick);
 	if (!retval)
 		mrt_setbitl(mrt_bit(0U), &sprt_tick->IR);
 
@@ -161,6 +162,9 @@ void imx6ull_systick_init(void)
 	mrt_setbitl(mrt_bit(0U), &sprt_tick->CR);
 
 	ptr_systick_counter = (kutime_t *)&sprt_tick->CNT;
+	/*!< OF1: the counter has restarted, but jiffies is not increased yet */
+	ptr_systick_status = (kutime_t *)&sprt_tick->SR;
+	g_systick_status_mask = mrt_bit(0U);
 }
 
 /*!
@@ -172,15 +176,22 @@ void imx6ull_systick_init(void)
 irq_return_t imx6_systick_isr(void *ptrDev)
 {
 	srt_hal_imx_gptimer_t *sprt_tick = (srt_hal_imx_gptimer_t *)ptrDev;
+	kuint32_t flags;
 
 	if (mrt_isBitSetl(mrt_bit(0), &sprt_tick->SR))
 	{
-		/*!< reset jiffies when counter over */
+		/*!< 
+		 * reset jiffies when counter over;
+		 * get_time_stamp() counts the pending status as one tick, so that jiffies and the status change at once
+		 */
+		mrt_local_irq_save(flags);
 		get_time_counter();
-		do_timer_event();
 
 		/*!< set 1 to clear compare status */
 		mrt_setbitl(mrt_bit(0), &sprt_tick->SR);
+		mrt_local_irq_restore(flags);
+
+		do_timer_event();
 	}
 
 	return ER_NORMAL;
@@ -13,8 +13,28 @@
 /*!< The includes */
 #include <common/api_string.h>
 #include <common/io_stream.h>
+#include <common/mem_manage.h>
 #include <platform/fwk_mempool.h>
 
+/*!< The defines */
+/*!<
+ * word-at-a-time:
+ * an aligned word never crosses a page (or any bus region), so it is safe to read the whole word
+ * even if the string ends in the middle of it.
+ * mrt_word_has_zero(x) != 0 if any byte of x is 0x00.
+ */
+#define STRING_WORD_SIZE									(sizeof(kuint32_t))
+#define STRING_WORD_MASK									(STRING_WORD_SIZE - 1)
+#define STRING_WORD_ONES									(0x01010101U)
+#define STRING_WORD_HIGHS									(0x80808080U)
+
+#define mrt_word_has_zero(x)								(((x) - STRING_WORD_ONES) & ~(x) & STRING_WORD_HIGHS)
+#define mrt_word_fill_byte(c)								((kuint32_t)(kuint8_t)(c) * STRING_WORD_ONES)
+#define mrt_word_is_aligned(p)								(!(((kuaddr_t)(p)) & STRING_WORD_MASK))
+
+/*!< The functions */
+static kint32_t __do_string_n_compare(const kuint8_t *ptr_s1, const kuint8_t *ptr_s2, kusize_t size);
+
 /*!< API function */
 /*!
  * @brief   get_integrater_lenth
@@ -33,7 +53,7 @@ kusize_t get_integrater_lenth(kuint64_t value)
 	/*!< Dividing by 10 and taking remainder */
 	do
 	{
-		num = num / 10;
+		num = (num >> 32) ? (num / 10) : udiv_by_10((kuint32_t)num);
 		lenth++;
 
 	} while (num);
@@ -49,13 +69,23 @@ kusize_t get_integrater_lenth(kuint64_t value)
  */
 kusize_t get_string_lenth(const void *ptr_src)
 {
-	kuint8_t *ptr_ch;
+	const kuint8_t *ptr_ch;
+	const kuint32_t *ptr_word;
+
+	/*!< head: one byte per loop, until address is aligned */
+	for (ptr_ch = (const kuint8_t *)ptr_src; !mrt_word_is_aligned(ptr_ch); ptr_ch++)
+	{
+		if ('\0' == *ptr_ch)
+			return (kusize_t)(ptr_ch - (const kuint8_t *)ptr_src);
+	}
 
-	ptr_ch = (kuint8_t *)ptr_src;
+	/*!< body: one word per loop */
+	for (ptr_word = (const kuint32_t *)ptr_ch; !mrt_word_has_zero(*ptr_word); ptr_word++);
 
-	while ('\0' != *(ptr_ch++));
+	/*!< tail: '\0' is in this word */
+	for (ptr_ch = (const kuint8_t *)ptr_word; '\0' != *ptr_ch; ptr_ch++);
 
-	return ((kusize_t)(ptr_ch - (kuint8_t *)ptr_src) - 1);
+	return (kusize_t)(ptr_ch - (const kuint8_t *)ptr_src);
 }
 
 /*!
@@ -107,14 +137,13 @@ kint8_t *do_string_copy(void *ptr_dst, const void *ptr_src)
  */
 kint8_t *do_string_n_copy(void *ptr_dst, const void *ptr_src, kuint32_t size)
 {
-	kuint8_t *ptr_ch;
-	kuint8_t *ptr_buf;
+	kuint8_t *ptr_end;
+	kusize_t lenth;
 
-	ptr_ch  = (kuint8_t *)ptr_src;
-	ptr_buf	= (kuint8_t *)ptr_dst;
+	ptr_end = do_memory_seek_char(ptr_src, '\0', size);
+	lenth = ptr_end ? (kusize_t)(ptr_end - (kuint8_t *)ptr_src) : size;
 
-	while ('\0' != *ptr_ch && (size--))
-		*(ptr_buf++) = *(ptr_ch++);
+	memory_copy(ptr_dst, ptr_src, lenth);
 
 	return (kint8_t *)ptr_dst;
 }
@@ -122,82 +151,88 @@ kint8_t *do_string_n_copy(void *ptr_dst, const void *ptr_src, kuint32_t size)
 /*!
  * @brief   do_string_n_copy_safe
  * @param   ptr_dst, offset, ptr_src
- * @retval  none
- * @note    copy n char to another string
+ * @retval  the lenth of ptr_src
+ * @note    copy n char to another string (similar to "strlcpy"), ptr_dst is always terminated with '\0'
  */
 kuint32_t do_string_n_copy_safe(void *ptr_dst, const void *ptr_src, kuint32_t size)
 {
-	kuint8_t *ptr_ch;
-	kuint8_t *ptr_buf;
-	kuint32_t lenth;
+	kuint32_t lenth, count;
 
-	ptr_ch  = (kuint8_t *)ptr_src;
-	ptr_buf	= (kuint8_t *)ptr_dst;
 	lenth = get_string_lenth(ptr_src);
+	if (!size)
+		return lenth;
+
+	count = (lenth >= size) ? (size - 1) : lenth;
+	memory_copy(ptr_dst, ptr_src, count);
+	*((kuint8_t *)ptr_dst + count) = '\0';
+
+	return lenth;
+}
+
+/*!
+ * @brief   __do_string_n_compare
+ * @param   ptr_s1, ptr_s2, size
+ * @retval  0: equal; < 0: s1 < s2; > 0: s1 > s2
+ * @note    similar to "strncmp"; words are compared only if s1 and s2 have the same alignment
+ */
+static kint32_t __do_string_n_compare(const kuint8_t *ptr_s1, const kuint8_t *ptr_s2, kusize_t size)
+{
+	const kuint32_t *ptr_w1, *ptr_w2;
 
-	while (('\0' != *ptr_ch) && size)
+	if (!(((kuaddr_t)ptr_s1 ^ (kuaddr_t)ptr_s2) & STRING_WORD_MASK))
 	{
-		if (--size)
+		for (; size && !mrt_word_is_aligned(ptr_s1); size--, ptr_s1++, ptr_s2++)
 		{
-			*(ptr_buf++) = *(ptr_ch++);
-			continue;
+			if ((*ptr_s1 != *ptr_s2) || ('\0' == *ptr_s1))
+				return (kint32_t)*ptr_s1 - (kint32_t)*ptr_s2;
+		}
+
+		ptr_w1 = (const kuint32_t *)ptr_s1;
+		ptr_w2 = (const kuint32_t *)ptr_s2;
+
+		/*!< stop at the word which is different or has '\0', and then find it out byte by byte */
+		for (; size >= STRING_WORD_SIZE; size -= STRING_WORD_SIZE, ptr_w1++, ptr_w2++)
+		{
+			if ((*ptr_w1 != *ptr_w2) || mrt_word_has_zero(*ptr_w1))
+				break;
 		}
 
-		*ptr_buf = '\0';
+		ptr_s1 = (const kuint8_t *)ptr_w1;
+		ptr_s2 = (const kuint8_t *)ptr_w2;
 	}
 
-	return lenth;
+	for (; size; size--, ptr_s1++, ptr_s2++)
+	{
+		if ((*ptr_s1 != *ptr_s2) || ('\0' == *ptr_s1))
+			return (kint32_t)*ptr_s1 - (kint32_t)*ptr_s2;
+	}
+
+	return 0;
 }
 
 /*!
  * @brief   do_string_compare
  * @param   ptr_dst, ptr_src
- * @retval  none
+ * @retval  true: different; false: same
  * @note    compare string
  */
 kbool_t do_string_compare(const void *ptr_dst, const void *ptr_src)
 {
-	kuint8_t *ptr_ch;
-	kuint8_t *ptr_buf;
-
-	ptr_ch  = (kuint8_t *)ptr_src;
-	ptr_buf	= (kuint8_t *)ptr_dst;
-
-	do
-	{
-		if (*(ptr_buf++) != *(ptr_ch++))
-			return true;
-
-	} while ('\0' != *ptr_ch);
-
-	return false;	
+	return !!__do_string_n_compare(ptr_dst, ptr_src, (kusize_t)(~0));
 }
 
 /*!
  * @brief   do_string_n_compare
  * @param   ptr_dst, ptr_src, size
- * @retval  none
+ * @retval  true: different; false: same
  * @note    compare n char
  */
 kbool_t do_string_n_compare(const void *ptr_dst, const void *ptr_src, kuint32_t size)
 {
-	kuint8_t *ptr_ch;
-	kuint8_t *ptr_buf;
-
-	ptr_ch  = (kuint8_t *)ptr_src;
-	ptr_buf	= (kuint8_t *)ptr_dst;
-
 	if (!size)
 		return true;
 
-	do
-	{
-		if (*(ptr_buf++) != *(ptr_ch++))
-			return true;
-
-	} while (('\0' != *ptr_ch) && (--size));
-
-	return false;	
+	return !!__do_string_n_compare(ptr_dst, ptr_src, size);
 }
 
 /*!
@@ -248,13 +283,13 @@ kusize_t convert_number_to_string(void *ptr_dst, kuint64_t value)
 	/*!< Dividing by 10 and taking remainder */
 	do
 	{
-		num = num / 10;
+		num = (num >> 32) ? (num / 10) : udiv_by_10((kuint32_t)num);
 		lenth++;
 
 		if (isValid(ptr_dst))
 		{
 			*(ptr_buf++) = (value - ((num << 1) + (num << 3))) + '0';
-			value = value / 10;
+			value = num;
 		}
 
 	} while (num);
@@ -274,16 +309,68 @@ kusize_t convert_number_to_string(void *ptr_dst, kuint64_t value)
  */
 kchar_t *seek_char_in_string(const void *ptr_src, kchar_t ch)
 {
-	kchar_t *ptr_ch;
+	const kuint8_t *ptr_ch;
+	const kuint32_t *ptr_word;
+	kuint32_t pattern;
+
+	if ('\0' == ch)
+		return mrt_nullptr;
+
+	/*!< head: one byte per loop, until address is aligned */
+	for (ptr_ch = (const kuint8_t *)ptr_src; !mrt_word_is_aligned(ptr_ch); ptr_ch++)
+	{
+		if ((kuint8_t)ch == *ptr_ch)
+			return (kchar_t *)ptr_ch;
+		if ('\0' == *ptr_ch)
+			return mrt_nullptr;
+	}
+
+	/*!< body: stop at the word which has '\0' or ch */
+	pattern = mrt_word_fill_byte(ch);
+	for (ptr_word = (const kuint32_t *)ptr_ch; 
+		!mrt_word_has_zero(*ptr_word) && !mrt_word_has_zero(*ptr_word ^ pattern); ptr_word++);
 
-	ptr_ch = (kchar_t *)ptr_src;
+	/*!< tail */
+	for (ptr_ch = (const kuint8_t *)ptr_word; '\0' != *ptr_ch; ptr_ch++)
+	{
+		if ((kuint8_t)ch == *ptr_ch)
+			return (kchar_t *)ptr_ch;
+	}
+
+	return mrt_nullptr;
+}
+
+/*!
+ * @brief   do_memory_seek_char
+ * @param   ptr_src, ch, size
+ * @retval  the character position in memory
+ * @note    find a character position in the first "size" bytes (similar to "memchr")
+ */
+void *do_memory_seek_char(const void *ptr_src, kchar_t ch, kusize_t size)
+{
+	const kuint8_t *ptr_ch;
+	const kuint32_t *ptr_word;
+	kuint32_t pattern;
+
+	ptr_ch = (const kuint8_t *)ptr_src;
+
+	for (; size && !mrt_word_is_aligned(ptr_ch); size--, ptr_ch++)
+	{
+		if ((kuint8_t)ch == *ptr_ch)
+			return (void *)ptr_ch;
+	}
 
-	while (*ptr_ch != '\0')
+	pattern = mrt_word_fill_byte(ch);
+	for (ptr_word = (const kuint32_t *)ptr_ch; size >= STRING_WORD_SIZE; size -= STRING_WORD_SIZE, ptr_word++)
 	{
-		if (ch == *ptr_ch)
-			return ptr_ch;
+		if (mrt_word_has_zero(*ptr_word ^ pattern))
+			break;
+	}
 
-		ptr_ch++;
+	for (ptr_ch = (const kuint8_t *)ptr_word; size; size--, ptr_ch++)
+	{
+		if ((kuint8_t)ch == *ptr_ch)
+			return (void *)ptr_ch;
 	}
 
 	return mrt_nullptr;
@@ -674,7 +761,7 @@ __weak kusize_t kstrlcpy(kchar_t *__dest, const kchar_t *__src, kusize_t __n)
  */
 __weak kint32_t kstrcmp(const kchar_t *__s1, const kchar_t *__s2)
 {
-	return do_string_compare(__s1, __s2);
+	return __do_string_n_compare((const kuint8_t *)__s1, (const kuint8_t *)__s2, (kusize_t)(~0));
 }
 
 /*!
@@ -685,7 +772,7 @@ __weak kint32_t kstrcmp(const kchar_t *__s1, const kchar_t *__s2)
  */
 __weak kint32_t kstrncmp(const kchar_t *__s1, const kchar_t *__s2, kusize_t __n)
 {
-	return do_string_n_compare(__s1, __s2, __n);
+	return __do_string_n_compare((const kuint8_t *)__s1, (const kuint8_t *)__s2, __n);
 }
 
 /*!
@@ -699,6 +786,65 @@ __weak kchar_t *kstrchr(const kchar_t *__s1, kchar_t ch)
 	return seek_char_in_string(__s1, ch);
 }
 
+/*!
+ * @brief   kmemchr
+ * @param   none
+ * @retval  none
+ * @note    locate where the first "ch" appears in the first "__n" bytes
+ */
+__weak void *kmemchr(const void *__s, kchar_t ch, kusize_t __n)
+{
+	return do_memory_seek_char(__s, ch, __n);
+}
+
+/*!
+ * @brief   kstrtou32
+ * @param   __s: decimal, or hexadecimal beginning with "0x"
+ * @param   __res: the value converted
+ * @retval  errno
+ * @note    leading spaces and a trailing newline (as "echo" writes) are allowed
+ */
+__weak kint32_t kstrtou32(const kchar_t *__s, kuint32_t *__res)
+{
+	kuint64_t value = 0;
+	kuint32_t base = 10, digit;
+
+	while (*__s == ' ')
+		__s++;
+
+	if ((__s[0] == '0') && ((__s[1] == 'x') || (__s[1] == 'X')))
+	{
+		base = 16;
+		__s += 2;
+	}
+
+	if ((*__s == '\0') || (*__s == '\n'))
+		return -ER_UNVALID;
+
+	for (; (*__s != '\0') && (*__s != '\n'); __s++)
+	{
+		if ((*__s >= '0') && (*__s <= '9'))
+			digit = *__s - '0';
+		else if ((base == 16) && (*__s >= 'a') && (*__s <= 'f'))
+			digit = *__s - 'a' + 10;
+		else if ((base == 16) && (*__s >= 'A') && (*__s <= 'F'))
+			digit = *__s - 'A' + 10;
+		else
+			return -ER_UNVALID;
+
+		value = value * base + digit;
+		if (value > (kuint32_t)(~0))
+			return -ER_MORE;
+	}
+
+	if ((*__s == '\n') && (*(__s + 1) != '\0'))
+		return -ER_UNVALID;
+
+	*__res = (kuint32_t)value;
+
+	return ER_NORMAL;
+}
+
 #endif
 
 
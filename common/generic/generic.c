@@ -13,59 +13,179 @@
 /*!< The includes */
 #include <common/generic.h>
 
+/*!< The globals */
+/*!< -1: not detected yet; 0: not supported; 1: "udiv/sdiv" are supported */
+static kint32_t g_generic_hwdiv_support = -1;
+
+/*!< The functions */
+static kbool_t __udiv_hw_is_support(void);
+static kutype_t __udiv_shift_subtract(kutype_t divied, kutype_t div, kutype_t *remainder);
+
 /*!< API function */
 /*!
- * @brief   unsigned divied: "divied / div"
+ * @brief   check if "udiv/sdiv" instructions are implemented
+ * @param   none
+ * @retval  none
+ * @note    ID_ISAR0[27:24], Divide_instrs: 0 = none; 1 = Thumb only; 2 = ARM and Thumb
+ */
+static kbool_t __udiv_hw_is_support(void)
+{
+	kuint32_t isar0;
+
+	if (g_generic_hwdiv_support < 0)
+	{
+		__asm__ __volatile__ (
+			"	mrc p15, 0, %0, c0, c2, 0	\n\t"
+			: "=r"(isar0)
+		);
+
+		g_generic_hwdiv_support = (((isar0 >> 24) & 0xf) >= 2) ? 1 : 0;
+	}
+
+	return !!g_generic_hwdiv_support;
+}
+
+/*!
+ * @brief   unsigned divide by instruction "udiv"
  * @param   divied, div
  * @retval  none
- * @note    none
+ * @note    div must not be 0
  */
-kutype_t udiv_integer(kutype_t divied, kutype_t div)
+static inline kutype_t __udiv_hw(kutype_t divied, kutype_t div)
 {
-	kutype_t count = 0;
+	kutype_t result;
+
+	__asm__ __volatile__ (
+		"	.arch_extension idiv	\n\t"
+		"	udiv %0, %1, %2			\n\t"
+		: "=r"(result)
+		: "r"(divied), "r"(div)
+	);
+
+	return result;
+}
 
-	while (divied >= div)
+/*!
+ * @brief   signed divide by instruction "sdiv"
+ * @param   divied, div
+ * @retval  none
+ * @note    div must not be 0
+ */
+static inline kstype_t __sdiv_hw(kstype_t divied, kstype_t div)
+{
+	kstype_t result;
+
+	__asm__ __volatile__ (
+		"	.arch_extension idiv	\n\t"
+		"	sdiv %0, %1, %2			\n\t"
+		: "=r"(result)
+		: "r"(divied), "r"(div)
+	);
+
+	return result;
+}
+
+/*!
+ * @brief   unsigned divide by shifting and subtracting
+ * @param   divied, div, remainder (can be null)
+ * @retval  quotient
+ * @note    one bit of quotient per loop, 32 loops at most; div must not be 0
+ */
+static kutype_t __udiv_shift_subtract(kutype_t divied, kutype_t div, kutype_t *remainder)
+{
+	kutype_t quotient = 0;
+	kint32_t shift;
+
+	if (divied >= div)
 	{
-		divied -= div;
-		count++;
+		/*!< align the highest bit of div with divied's */
+		shift = __builtin_clzl(div) - __builtin_clzl(divied);
+		div <<= shift;
+
+		for (; shift >= 0; shift--, div >>= 1)
+		{
+			quotient <<= 1;
+
+			if (divied >= div)
+			{
+				divied -= div;
+				quotient |= 1;
+			}
+		}
 	}
 
-	return count;
+	if (remainder)
+		*remainder = divied;
+
+	return quotient;
+}
+
+/*!
+ * @brief   unsigned divied: "divied / div"
+ * @param   divied, div
+ * @retval  none
+ * @note    return 0 if div is 0 (the same as "udiv")
+ */
+kutype_t udiv_integer(kutype_t divied, kutype_t div)
+{
+	if (!div)
+		return 0;
+
+	if (isPower2(div))
+		return divied >> __builtin_ctzl(div);
+
+	if (__udiv_hw_is_support())
+		return __udiv_hw(divied, div);
+
+	return __udiv_shift_subtract(divied, div, mrt_nullptr);
 }
 
 /*!
  * @brief   signed divied: "divied / div"
  * @param   divied, div
  * @retval  none
- * @note    none
+ * @note    return 0 if div is 0 (the same as "sdiv")
  */
 kstype_t sdiv_integer(kstype_t divied, kstype_t div)
 {
-	kstype_t count = 0;
-	kstype_t number1 = mrt_abs(divied);
-	kstype_t number2 = mrt_abs(div);
+	kutype_t number1, number2, count;
 
-	while (number1 >= number2)
-	{
-		number1 -= number2;
-		count++;
-	}
+	if (!div)
+		return 0;
 
-	return ((divied ^ div) < 0) ? -count : count;
+	if (__udiv_hw_is_support())
+		return __sdiv_hw(divied, div);
+
+	/*!< "-(kutype_t)x" is well defined even if x is the minimum */
+	number1 = (divied < 0) ? -(kutype_t)divied : (kutype_t)divied;
+	number2 = (div < 0) ? -(kutype_t)div : (kutype_t)div;
+	count = __udiv_shift_subtract(number1, number2, mrt_nullptr);
+
+	return ((divied ^ div) < 0) ? -(kstype_t)count : (kstype_t)count;
 }
 
 /*!
  * @brief   get the remainder: "divied % div"
  * @param   divied, div
  * @retval  none
- * @note    none
+ * @note    return divied if div is 0
  */
 kutype_t udiv_remainder(kutype_t divied, kutype_t div)
 {
-	while (divied >= div)
-		divied -= div;
+	kutype_t remainder;
+
+	if (!div)
+		return divied;
+
+	if (isPower2(div))
+		return divied & (div - 1);
+
+	if (__udiv_hw_is_support())
+		return divied - __udiv_hw(divied, div) * div;
+
+	__udiv_shift_subtract(divied, div, &remainder);
 
-	return divied;
+	return remainder;
 }
 
 /*!
@@ -78,7 +198,7 @@ kutype_t dec_to_hex(kchar_t *buf, kutype_t number, kbool_t mode)
 {
 	kchar_t temp[(sizeof(kutype_t) << 1) + 4];
 	kchar_t result = 0;
-	kint16_t count, idx;
+	kint16_t count = 0, idx;
 
 	do
 	{
@@ -117,7 +237,7 @@ kutype_t dec_to_binary(kchar_t *buf, kutype_t number)
 {
 	kchar_t temp[(sizeof(kutype_t) << 3) + 4];
 	kchar_t result = 0;
-	kint16_t count, idx;
+	kint16_t count = 0, idx;
 
 	do
 	{
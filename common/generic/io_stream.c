@@ -65,30 +65,180 @@ void printk(const kchar_t *ptr_fmt, ...)
 }
 
 /*!
- * @brief   find first bit that equaled to value
+ * @brief   find the next bit that equaled to 1 (invert = 0) or 0 (invert = ~0)
  * @param   bitmap: array
+ * @param	total_bits: bitmap lenth
  * @param	start: base
- * @param	total_bit: bitmap lenth
- * @param	value: 0 or 1
+ * @param	invert: xor with every word
  * @retval  index (bit position); -1: not found
- * @note    find bit on bitmap
+ * @note    search by per 32 bits, the lowest set bit of a word is got by ctz (rbit + clz)
  */
-static kint32_t bitmap_find_first_bit(kuint8_t *bitmap, kuint32_t start, kusize_t total_bits, kbool_t value)
+static kint32_t __bitmap_find_next(const kuint32_t *bitmap, kusize_t total_bits, kuint32_t start, kuint32_t invert)
 {
-	kuint32_t index, bit_mask, area_mask;
-	kuint32_t bit_per_map = sizeof(*bitmap) << 3;
+	kuint32_t index, word;
+
+	if (start >= total_bits)
+		return -1;
+
+	index = start >> BITMAP_WORD_SHIFT;
+	word = (bitmap[index] ^ invert) & mrt_bitmap_first_word_mask(start);
 
-	/*!< search by per 8 bits */
-	for (index = start; index < total_bits; index++)
+	while (!word)
 	{
-		area_mask = mrt_udiv(index, bit_per_map);
-		bit_mask = mrt_urem(index, bit_per_map);
+		if ((++index << BITMAP_WORD_SHIFT) >= total_bits)
+			return -1;
 
-		if ((!!(*(bitmap + area_mask) & (1 << bit_mask))) == value)
-			break;
+		word = bitmap[index] ^ invert;
 	}
 
-	return (index >= total_bits) ? -1 : index;
+	start = (index << BITMAP_WORD_SHIFT) + mrt_bit_ffs(word);
+	return (start < total_bits) ? start : -1;
+}
+
+/*!
+ * @brief   set or clear start ~ (start + nr)
+ * @param   bitmap: array
+ * @param	start: base
+ * @param	nr: count
+ * @param	value: 0 or 1
+ * @retval  none
+ * @note    the head and tail words are masked, the words between are written at once
+ */
+static void __bitmap_update(kuint32_t *bitmap, kuint32_t start, kuint32_t nr, kbool_t value)
+{
+	kuint32_t *p = bitmap + (start >> BITMAP_WORD_SHIFT);
+	kuint32_t end = start + nr;
+	kuint32_t bits = BITMAP_BITS_PER_WORD - (start & (BITMAP_BITS_PER_WORD - 1));
+	kuint32_t mask = mrt_bitmap_first_word_mask(start);
+
+	if (!nr)
+		return;
+
+	while (nr >= bits)
+	{
+		if (value)
+			*p |= mask;
+		else
+			*p &= ~mask;
+
+		nr -= bits;
+		bits = BITMAP_BITS_PER_WORD;
+		mask = ~0U;
+		p++;
+	}
+
+	if (nr)
+	{
+		mask &= mrt_bitmap_last_word_mask(end);
+		if (value)
+			*p |= mask;
+		else
+			*p &= ~mask;
+	}
+}
+
+/*!
+ * @brief   count bits of a word
+ * @param   word
+ * @retval  the number of bits set
+ * @note    none
+ */
+static inline kuint32_t __bitmap_word_weight(kuint32_t word)
+{
+	word = word - ((word >> 1) & 0x55555555U);
+	word = (word & 0x33333333U) + ((word >> 2) & 0x33333333U);
+	word = (word + (word >> 4)) & 0x0f0f0f0fU;
+
+	return (word * 0x01010101U) >> 24;
+}
+
+/*!
+ * @brief   find the next bit that equaled to 1
+ * @param   bitmap, total_bits, start
+ * @retval  index (bit position); -1: not found
+ * @note    none
+ */
+kint32_t find_next_bit(const kuint32_t *bitmap, kusize_t total_bits, kuint32_t start)
+{
+	return __bitmap_find_next(bitmap, total_bits, start, 0);
+}
+
+/*!
+ * @brief   find the next bit that equaled to 0
+ * @param   bitmap, total_bits, start
+ * @retval  index (bit position); -1: not found
+ * @note    none
+ */
+kint32_t find_next_zero_bit(const kuint32_t *bitmap, kusize_t total_bits, kuint32_t start)
+{
+	return __bitmap_find_next(bitmap, total_bits, start, ~0U);
+}
+
+/*!
+ * @brief   set start ~ (start + nr) to 1
+ * @param   bitmap, start, nr
+ * @retval  none
+ * @note    none
+ */
+void bitmap_set(kuint32_t *bitmap, kuint32_t start, kuint32_t nr)
+{
+	__bitmap_update(bitmap, start, nr, true);
+}
+
+/*!
+ * @brief   set start ~ (start + nr) to 0
+ * @param   bitmap, start, nr
+ * @retval  none
+ * @note    none
+ */
+void bitmap_clear(kuint32_t *bitmap, kuint32_t start, kuint32_t nr)
+{
+	__bitmap_update(bitmap, start, nr, false);
+}
+
+/*!
+ * @brief   count the bits equaled to 1
+ * @param   bitmap, total_bits
+ * @retval  weight
+ * @note    none
+ */
+kuint32_t bitmap_weight(const kuint32_t *bitmap, kusize_t total_bits)
+{
+	kuint32_t index, weight = 0;
+	kuint32_t words = total_bits >> BITMAP_WORD_SHIFT;
+
+	for (index = 0; index < words; index++)
+		weight += __bitmap_word_weight(bitmap[index]);
+
+	if (total_bits & (BITMAP_BITS_PER_WORD - 1))
+		weight += __bitmap_word_weight(bitmap[index] & mrt_bitmap_last_word_mask(total_bits));
+
+	return weight;
+}
+
+/*!
+ * @brief   find nr consecutive bits equaled to 0
+ * @param   bitmap, total_bits, start
+ * @param	nr: count
+ * @retval  index of the first bit of the area; -1: not found
+ * @note    if a bit equaled to 1 is found inside the area, search again after it
+ */
+kint32_t bitmap_find_next_zero_area(const kuint32_t *bitmap, kusize_t total_bits, kuint32_t start, kuint32_t nr)
+{
+	kint32_t index, busy;
+
+	for (;;)
+	{
+		index = find_next_zero_bit(bitmap, total_bits, start);
+		if ((index < 0) || ((index + nr) > total_bits))
+			return -1;
+
+		busy = find_next_bit(bitmap, index + nr, index);
+		if (busy < 0)
+			return index;
+
+		start = busy + 1;
+	}
 }
 
 /*!
@@ -101,7 +251,7 @@ static kint32_t bitmap_find_first_bit(kuint8_t *bitmap, kuint32_t start, kusize_
  * @retval  0: request successfully; > 0: the first bit failed
  * @note    request multiple consecutive bits on bitmap
  */
-static kint32_t bitmap_find_nr_bit(kuint8_t *bitmap, kuint32_t start, kusize_t total_bits, kuint32_t nr, kbool_t value)
+static kint32_t bitmap_find_nr_bit(kuint32_t *bitmap, kuint32_t start, kusize_t total_bits, kuint32_t nr, kbool_t value)
 {
 	kuint32_t end = start + nr;
 	kint32_t index;
@@ -113,7 +263,7 @@ static kint32_t bitmap_find_nr_bit(kuint8_t *bitmap, kuint32_t start, kusize_t t
 	 * found (!value), return current index (the first bit that does not meet the condition)
 	 * indicate that no consecutive bits are avaliable, i.e request nr bits failed
 	 */
-	index = bitmap_find_first_bit((kuint8_t *)bitmap, start, end, !value);
+	index = value ? find_next_zero_bit(bitmap, end, start) : find_next_bit(bitmap, end, start);
 	return (index < 0) ? 0 : index;
 }
 
@@ -123,25 +273,12 @@ static kint32_t bitmap_find_nr_bit(kuint8_t *bitmap, kuint32_t start, kusize_t t
  * @retval  none
  * @note    (start + nr) < total_bits
  */
-static void bitmap_set_nr_bit(kuint8_t *bitmap, kuint32_t start, kusize_t total_bits, kuint32_t nr, kbool_t value)
+static void bitmap_set_nr_bit(kuint32_t *bitmap, kuint32_t start, kusize_t total_bits, kuint32_t nr, kbool_t value)
 {
-	kuint32_t end = start + nr;
-	kuint32_t index, bit_mask, area_mask;
-	kuint32_t bit_per_map = sizeof(*bitmap) << 3;
-
-	if (end >= total_bits)
+	if ((start + nr) >= total_bits)
 		return;
 
-	for (index = start; index < end; index++)
-	{
-		area_mask = mrt_udiv(index, bit_per_map);
-		bit_mask = mrt_urem(index, bit_per_map);
-
-		if (value)
-			*(bitmap + area_mask) |= (1 << bit_mask);
-		else
-			*(bitmap + area_mask) &= ~(1 << bit_mask);
-	}
+	__bitmap_update(bitmap, start, nr, value);
 }
 
 /*!
@@ -152,7 +289,7 @@ static void bitmap_set_nr_bit(kuint8_t *bitmap, kuint32_t start, kusize_t total_
  */
 kint32_t bitmap_find_first_zero_bit(void *bitmap, kuint32_t start, kusize_t total_bits)
 {
-	return bitmap_find_first_bit((kuint8_t *)bitmap, start, total_bits, false);
+	return find_next_zero_bit((kuint32_t *)bitmap, total_bits, start);
 }
 
 /*!
@@ -163,7 +300,7 @@ kint32_t bitmap_find_first_zero_bit(void *bitmap, kuint32_t start, kusize_t tota
  */
 kint32_t bitmap_find_first_valid_bit(void *bitmap, kuint32_t start, kusize_t total_bits)
 {
-	return bitmap_find_first_bit((kuint8_t *)bitmap, start, total_bits, true);
+	return find_next_bit((kuint32_t *)bitmap, total_bits, start);
 }
 
 /*!
@@ -174,7 +311,7 @@ kint32_t bitmap_find_first_valid_bit(void *bitmap, kuint32_t start, kusize_t tot
  */
 kint32_t bitmap_find_nr_zero_bit(void *bitmap, kuint32_t start, kusize_t total_bits, kuint32_t nr)
 {
-	return bitmap_find_nr_bit((kuint8_t *)bitmap, start, total_bits, nr, false);
+	return bitmap_find_nr_bit((kuint32_t *)bitmap, start, total_bits, nr, false);
 }
 
 /*!
@@ -185,7 +322,7 @@ kint32_t bitmap_find_nr_zero_bit(void *bitmap, kuint32_t start, kusize_t total_b
  */
 kint32_t bitmap_find_nr_valid_bit(void *bitmap, kuint32_t start, kusize_t total_bits, kuint32_t nr)
 {
-	return bitmap_find_nr_bit((kuint8_t *)bitmap, start, total_bits, nr, true);
+	return bitmap_find_nr_bit((kuint32_t *)bitmap, start, total_bits, nr, true);
 }
 
 /*!
@@ -196,7 +333,7 @@ kint32_t bitmap_find_nr_valid_bit(void *bitmap, kuint32_t start, kusize_t total_
  */
 void bitmap_set_nr_bit_zero(void *bitmap, kuint32_t start, kusize_t total_bits, kuint32_t nr)
 {
-	bitmap_set_nr_bit((kuint8_t *)bitmap, start, total_bits, nr, false);
+	bitmap_set_nr_bit((kuint32_t *)bitmap, start, total_bits, nr, false);
 }
 
 /*!
@@ -207,7 +344,7 @@ void bitmap_set_nr_bit_zero(void *bitmap, kuint32_t start, kusize_t total_bits,
  */
 void bitmap_set_nr_bit_valid(void *bitmap, kuint32_t start, kusize_t total_bits, kuint32_t nr)
 {
-	bitmap_set_nr_bit((kuint8_t *)bitmap, start, total_bits, nr, true);
+	bitmap_set_nr_bit((kuint32_t *)bitmap, start, total_bits, nr, true);
 }
 
 /* end of file */
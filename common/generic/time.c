@@ -23,6 +23,8 @@
 kutime_t jiffies = JIFFIES_INITVAL;
 kutime_t jiffies_out = 0;
 kutime_t *ptr_systick_counter = mrt_nullptr;
+kutime_t *ptr_systick_status = mrt_nullptr;
+kutime_t g_systick_status_mask = 0;
 kutime_t g_delay_timer_counter = 0;
 
 static kuint32_t g_simple_delay_timer = 0;
@@ -169,14 +171,19 @@ void setup_timer(struct timer_list *sprt_timer, void (*entry)(kuint32_t), kuint3
  * @brief   add timer to global list
  * @param   sprt_timer
  * @retval  none
- * @note    systick interrupt will traverses the global list
+ * @note    systick interrupt will traverses the global list;
+ *          IRQ is disabled while the list is edited, since systick may preempt a lower priority handler
  */
 void add_timer(struct timer_list *sprt_timer)
 {
+	kuint32_t flags;
+
 	if (!isValid(sprt_timer))
 		return;
 
+	mrt_local_irq_save(flags);
 	list_head_add_tail(&sgrt_global_timer_list, &sprt_timer->sgrt_link);
+	mrt_local_irq_restore(flags);
 }
 
 /*!
@@ -187,10 +194,14 @@ void add_timer(struct timer_list *sprt_timer)
  */
 void del_timer(struct timer_list *sprt_timer)
 {
+	kuint32_t flags;
+
 	if (!isValid(sprt_timer))
 		return;
 
+	mrt_local_irq_save(flags);
 	list_head_del_safe(&sgrt_global_timer_list, &sprt_timer->sgrt_link);
+	mrt_local_irq_restore(flags);
 }
 
 /*!
@@ -202,14 +213,23 @@ void del_timer(struct timer_list *sprt_timer)
 kbool_t find_timer(struct timer_list *sprt_timer)
 {
 	struct timer_list *sprt_any;
+	kuint32_t flags;
+	kbool_t found = false;
+
+	mrt_local_irq_save(flags);
 
 	foreach_list_next_entry(sprt_any, &sgrt_global_timer_list, sgrt_link)
 	{
 		if (sprt_timer == sprt_any)
-			return true;
+		{
+			found = true;
+			break;
+		}
 	}
 
-	return false;
+	mrt_local_irq_restore(flags);
+
+	return found;
 }
 
 /*!
@@ -221,13 +241,20 @@ kbool_t find_timer(struct timer_list *sprt_timer)
  */
 void mod_timer(struct timer_list *sprt_timer, kutime_t expires)
 {
+	kuint32_t flags;
+
 	if (!isValid(sprt_timer))
 		return;
 
+	/*!< the timer must not be added twice by a handler which preempts between find and add */
+	mrt_local_irq_save(flags);
+
 	sprt_timer->expires = expires;
 	
 	if (!find_timer(sprt_timer))
 		add_timer(sprt_timer);
+
+	mrt_local_irq_restore(flags);
 }
 
 /*!
@@ -235,11 +262,15 @@ void mod_timer(struct timer_list *sprt_timer, kutime_t expires)
  * @param   none
  * @param	none
  * @retval  none
- * @note    called by systick interrupt
+ * @note    called by systick interrupt;
+ *          the list is walked with IRQ disabled, so that a nested handler can not edit it meanwhile
  */
 void do_timer_event(void)
 {
 	struct timer_list *sprt_timer;
+	kuint32_t flags;
+
+	mrt_local_irq_save(flags);
 
 	foreach_list_next_entry(sprt_timer, &sgrt_global_timer_list, sgrt_link)
 	{
@@ -252,6 +283,34 @@ void do_timer_event(void)
 				sprt_timer->entry(sprt_timer->data);
 		}
 	}
+
+	mrt_local_irq_restore(flags);
+}
+
+/*!
+ * @brief   read jiffies and the systick counter as a pair
+ * @param   tick: jiffies of the pair
+ * @retval  systick counts (us) passed in the current tick, 0 if systick is not running
+ * @note    jiffies is read twice, so that the pair is from the same tick;
+ *          the counter restarts on the tick before the systick handler increases jiffies, so while the
+ *          tick is pending (status read the same before and after the counter), the counter is of next tick
+ */
+kuint32_t get_time_stamp(kutime_t *tick)
+{
+	kutime_t start, status, pending;
+	kuint32_t usecs;
+
+	do
+	{
+		start = *(volatile kutime_t *)&jiffies;
+		status = ptr_systick_status ? (*(volatile kutime_t *)ptr_systick_status & g_systick_status_mask) : 0;
+		usecs = ptr_systick_counter ? (kuint32_t)(*(volatile kutime_t *)ptr_systick_counter) : 0;
+		pending = ptr_systick_status ? (*(volatile kutime_t *)ptr_systick_status & g_systick_status_mask) : 0;
+
+	} while ((start != *(volatile kutime_t *)&jiffies) || (status != pending));
+
+	*tick = pending ? (start + 1) : start;
+	return usecs;
 }
 
 /* end of file */
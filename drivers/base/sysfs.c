@@ -16,6 +16,11 @@
 #include <platform/fwk_fs.h>
 #include <platform/fwk_fcntl.h>
 #include <platform/fwk_kobj.h>
+#include <platform/fwk_sysfs.h>
+
+/*!< The defines */
+/*!< the longest path of sysfs files, such as "/sys/<device>/<file>" */
+#define SYSFS_PATH_LENTH_MAX								(64)
 
 /*!< The globals */
 struct fwk_kset *sprt_sys_fs;
@@ -100,6 +105,430 @@ void devfs_stdio_destroy(void)
 	sprt_kobj_in = sprt_kobj_out = sprt_kobj_err = mrt_nullptr;
 }
 
+/*!< ------------------------------------------------------------ */
+struct fwk_sysfs_buffer
+{
+	kchar_t *page;											/*!< FWK_SYSFS_BUF_SIZE */
+	kssize_t count;											/*!< bytes shown, < 0: show() has not been called */
+};
+
+/*!
+ * @brief   open an attribute file
+ * @param   sprt_inode, sprt_file
+ * @retval  errno
+ * @note    the access is limited by the mode of the attribute
+ */
+static kint32_t sysfs_attr_open(struct fwk_inode *sprt_inode, struct fwk_file *sprt_file)
+{
+	struct fwk_attribute *sprt_attr;
+	struct fwk_sysfs_buffer *sprt_buf;
+
+	sprt_attr = (struct fwk_attribute *)sprt_inode->private_data;
+	if (!sprt_attr)
+		return -ER_NOTFOUND;
+
+	if ((sprt_file->mode & O_RDONLY) && (!(sprt_attr->mode & O_RDONLY) || !sprt_attr->show))
+		return -ER_FORBID;
+
+	if ((sprt_file->mode & O_WRONLY) && (!(sprt_attr->mode & O_WRONLY) || !sprt_attr->store))
+		return -ER_FORBID;
+
+	sprt_buf = (struct fwk_sysfs_buffer *)kzalloc(sizeof(*sprt_buf) + FWK_SYSFS_BUF_SIZE, GFP_KERNEL);
+	if (!isValid(sprt_buf))
+		return -ER_NOMEM;
+
+	sprt_buf->page = (kchar_t *)(sprt_buf + 1);
+	sprt_buf->count = -1;
+	sprt_file->private_data = sprt_buf;
+
+	return ER_NORMAL;
+}
+
+/*!
+ * @brief   close an attribute file
+ * @param   sprt_inode, sprt_file
+ * @retval  errno
+ * @note    it may be called twice (as the file's and the inode's close)
+ */
+static kint32_t sysfs_attr_close(struct fwk_inode *sprt_inode, struct fwk_file *sprt_file)
+{
+	if (sprt_file->private_data)
+	{
+		kfree(sprt_file->private_data);
+		sprt_file->private_data = mrt_nullptr;
+	}
+
+	return ER_NORMAL;
+}
+
+/*!
+ * @brief   read an attribute file
+ * @param   sprt_file, buf, size, pos
+ * @retval  bytes read, or errno
+ * @note    show() is called when reading from the beginning, and the rest is read from the buffer
+ */
+static kssize_t sysfs_attr_read(struct fwk_file *sprt_file, kbuffer_t *buf, kssize_t size, kloff_t *pos)
+{
+	struct fwk_sysfs_buffer *sprt_buf = (struct fwk_sysfs_buffer *)sprt_file->private_data;
+	struct fwk_attribute *sprt_attr = (struct fwk_attribute *)sprt_file->sprt_inode->private_data;
+	kssize_t retval;
+
+	if (!sprt_buf || !sprt_attr || !sprt_attr->show)
+		return -ER_FORBID;
+
+	if ((sprt_buf->count < 0) || !(*pos))
+	{
+		memory_reset(sprt_buf->page, FWK_SYSFS_BUF_SIZE);
+
+		retval = sprt_attr->show(sprt_file->sprt_inode->sprt_kobj->sprt_parent, sprt_attr, sprt_buf->page);
+		if (retval < 0)
+			return retval;
+
+		sprt_buf->count = mrt_ret_min2(retval, (kssize_t)FWK_SYSFS_BUF_SIZE);
+	}
+
+	return fwk_simple_read_from_buffer(buf, size, pos, sprt_buf->page, sprt_buf->count);
+}
+
+/*!
+ * @brief   write an attribute file
+ * @param   sprt_file, buf, size, pos
+ * @retval  bytes consumed by store(), or errno
+ * @note    every write is a whole value, it is not appended to the last one
+ */
+static kssize_t sysfs_attr_write(struct fwk_file *sprt_file, const kbuffer_t *buf, kssize_t size, kloff_t *pos)
+{
+	struct fwk_sysfs_buffer *sprt_buf = (struct fwk_sysfs_buffer *)sprt_file->private_data;
+	struct fwk_attribute *sprt_attr = (struct fwk_attribute *)sprt_file->sprt_inode->private_data;
+	kssize_t retval;
+
+	if (!sprt_buf || !sprt_attr || !sprt_attr->store)
+		return -ER_FORBID;
+
+	if (size <= 0)
+		return size;
+
+	size = mrt_ret_min2(size, (kssize_t)FWK_SYSFS_BUF_SIZE - 1);
+	memory_copy(sprt_buf->page, buf, size);
+	sprt_buf->page[size] = '\0';
+
+	retval = sprt_attr->store(sprt_file->sprt_inode->sprt_kobj->sprt_parent, sprt_attr, sprt_buf->page, size);
+
+	/*!< show again on the next read */
+	sprt_buf->count = -1;
+	if (retval > 0)
+		*pos += retval;
+
+	return retval;
+}
+
+static struct fwk_file_oprts sgrt_sysfs_attr_oprts =
+{
+	.open	= sysfs_attr_open,
+	.close	= sysfs_attr_close,
+	.read	= sysfs_attr_read,
+	.write	= sysfs_attr_write,
+};
+
+/*!
+ * @brief   create an attribute file
+ * @param   sprt_kobj: directory, such as a kset
+ * @param   sprt_attr: it should not be freed before the file is removed
+ * @retval  errno
+ * @note    the file is named sprt_attr->name, and show/store get sprt_kobj
+ */
+kint32_t fwk_sysfs_create_file(struct fwk_kobject *sprt_kobj, struct fwk_attribute *sprt_attr)
+{
+	struct fwk_kobject *sprt_child;
+	kint32_t retval;
+
+	if (!sprt_kobj || !sprt_attr || !sprt_attr->name)
+		return -ER_NOMEM;
+
+	/*!< files can only be created in a directory */
+	if (!mrt_fwk_kset_get(sprt_kobj))
+		return -ER_UNVALID;
+
+	if (fwk_find_kobject_by_path(sprt_kobj, sprt_attr->name))
+		return -ER_EXISTED;
+
+	sprt_child = fwk_kobject_create();
+	if (!isValid(sprt_child))
+		return -ER_NOMEM;
+
+	sprt_child->sprt_kset = mrt_fwk_kset_get(sprt_kobj);
+	retval = fwk_kobject_add(sprt_child, sprt_kobj, "%s", sprt_attr->name);
+	if (retval)
+	{
+		kfree(sprt_child);
+		return retval;
+	}
+
+	sprt_child->sprt_inode->sprt_foprts = &sgrt_sysfs_attr_oprts;
+	sprt_child->sprt_inode->private_data = sprt_attr;
+
+	return ER_NORMAL;
+}
+
+/*!
+ * @brief   remove an attribute file
+ * @param   sprt_kobj, sprt_attr
+ * @retval  none
+ * @note    none
+ */
+void fwk_sysfs_remove_file(struct fwk_kobject *sprt_kobj, struct fwk_attribute *sprt_attr)
+{
+	struct fwk_kobject *sprt_child;
+
+	if (!sprt_kobj || !sprt_attr || !sprt_attr->name)
+		return;
+
+	sprt_child = fwk_find_kobject_by_path(sprt_kobj, sprt_attr->name);
+	if (!isValid(sprt_child) || !sprt_child->sprt_inode)
+		return;
+
+	/*!< the file with the same name, but not created by sprt_attr */
+	if (sprt_child->sprt_inode->private_data != sprt_attr)
+		return;
+
+	fwk_kobject_destroy(sprt_child);
+}
+
+/*!
+ * @brief   find the directory of a group
+ * @param   sprt_kobj, sprt_grp
+ * @retval  directory, or mrt_nullptr
+ * @note    none
+ */
+static struct fwk_kobject *fwk_sysfs_group_dir(struct fwk_kobject *sprt_kobj, const struct fwk_attribute_group *sprt_grp)
+{
+	kchar_t path[SYSFS_PATH_LENTH_MAX];
+
+	if (!sprt_grp->name)
+		return sprt_kobj;
+
+	if ((kstrlen(sprt_grp->name) + 2) > SYSFS_PATH_LENTH_MAX)
+		return mrt_nullptr;
+
+	sprintk(path, "%s/", sprt_grp->name);
+	return fwk_find_kobject_by_path(sprt_kobj, path);
+}
+
+/*!
+ * @brief   create a group of attribute files
+ * @param   sprt_kobj: directory
+ * @param   sprt_grp: the files are created in sprt_grp->name/ if it is given
+ * @retval  errno
+ * @note    nothing is left if it fails
+ */
+kint32_t fwk_sysfs_create_group(struct fwk_kobject *sprt_kobj, const struct fwk_attribute_group *sprt_grp)
+{
+	struct fwk_kobject *sprt_dir;
+	struct fwk_kset *sprt_kset;
+	kuint32_t idx;
+	kint32_t retval;
+
+	if (!sprt_kobj || !sprt_grp || !sprt_grp->sprt_attrs)
+		return -ER_NOMEM;
+
+	if (!mrt_fwk_kset_get(sprt_kobj))
+		return -ER_UNVALID;
+
+	sprt_dir = fwk_sysfs_group_dir(sprt_kobj, sprt_grp);
+	if (!sprt_dir)
+	{
+		sprt_kset = fwk_kset_create(sprt_grp->name, sprt_kobj);
+		if (!isValid(sprt_kset))
+			return -ER_NOMEM;
+
+		sprt_kset->sgrt_kobj.sprt_kset = mrt_fwk_kset_get(sprt_kobj);
+		retval = fwk_kset_register(sprt_kset);
+		if (retval)
+		{
+			fwk_kobject_del_name(&sprt_kset->sgrt_kobj);
+			kfree(sprt_kset);
+			return retval;
+		}
+
+		sprt_dir = &sprt_kset->sgrt_kobj;
+	}
+
+	for (idx = 0; sprt_grp->sprt_attrs[idx]; idx++)
+	{
+		retval = fwk_sysfs_create_file(sprt_dir, sprt_grp->sprt_attrs[idx]);
+		if (retval)
+		{
+			fwk_sysfs_remove_group(sprt_kobj, sprt_grp);
+			return retval;
+		}
+	}
+
+	return ER_NORMAL;
+}
+
+/*!
+ * @brief   remove a group of attribute files
+ * @param   sprt_kobj, sprt_grp
+ * @retval  none
+ * @note    the directory of the group is removed if it becomes empty
+ */
+void fwk_sysfs_remove_group(struct fwk_kobject *sprt_kobj, const struct fwk_attribute_group *sprt_grp)
+{
+	struct fwk_kobject *sprt_dir;
+	struct fwk_kset *sprt_kset;
+	kuint32_t idx;
+
+	if (!sprt_kobj || !sprt_grp || !sprt_grp->sprt_attrs)
+		return;
+
+	sprt_dir = fwk_sysfs_group_dir(sprt_kobj, sprt_grp);
+	if (!sprt_dir)
+		return;
+
+	for (idx = 0; sprt_grp->sprt_attrs[idx]; idx++)
+		fwk_sysfs_remove_file(sprt_dir, sprt_grp->sprt_attrs[idx]);
+
+	sprt_kset = mrt_fwk_kset_get(sprt_dir);
+	if (sprt_grp->name && sprt_kset && mrt_list_head_empty(&sprt_kset->sgrt_list))
+		fwk_kset_kobject_remove(sprt_dir);
+}
+
+/*!
+ * @brief   show /sys/<device>/{read, write, ioctl}
+ * @param   sprt_kobj: /sys/<device>/, sprt_inode->private_data is the device node
+ * @param   offset: the counters in struct fwk_io_stats
+ * @param   buf
+ * @retval  bytes written
+ * @note    the counters are copied first, so that the values shown are from the same moment
+ */
+static kssize_t sysfs_iostat_show(struct fwk_kobject *sprt_kobj, kusize_t offset, kchar_t *buf)
+{
+	struct fwk_inode *sprt_inode;
+	struct fwk_io_stat sgrt_stat;
+
+	sprt_inode = (struct fwk_inode *)sprt_kobj->sprt_inode->private_data;
+	if (!sprt_inode)
+		return -ER_NOTFOUND;
+
+	memory_copy(&sgrt_stat, (kuint8_t *)&sprt_inode->sgrt_iostats + offset, sizeof(sgrt_stat));
+
+	return sprintk(buf, "ops %d\nerrors %d\nbytes %ld\ntime_total %ld\ntime_max %d\n",
+					sgrt_stat.ops, sgrt_stat.errors, sgrt_stat.bytes, sgrt_stat.time_total, sgrt_stat.time_max);
+}
+
+/*!
+ * @brief   show /sys/<device>/read
+ * @param   sprt_kobj, sprt_attr, buf
+ * @retval  bytes written
+ * @note    none
+ */
+static kssize_t sysfs_iostat_read_show(struct fwk_kobject *sprt_kobj, struct fwk_attribute *sprt_attr, kchar_t *buf)
+{
+	return sysfs_iostat_show(sprt_kobj, mrt_member_offset(struct fwk_io_stats, sgrt_read), buf);
+}
+
+/*!
+ * @brief   show /sys/<device>/write
+ * @param   sprt_kobj, sprt_attr, buf
+ * @retval  bytes written
+ * @note    none
+ */
+static kssize_t sysfs_iostat_write_show(struct fwk_kobject *sprt_kobj, struct fwk_attribute *sprt_attr, kchar_t *buf)
+{
+	return sysfs_iostat_show(sprt_kobj, mrt_member_offset(struct fwk_io_stats, sgrt_write), buf);
+}
+
+/*!
+ * @brief   show /sys/<device>/ioctl
+ * @param   sprt_kobj, sprt_attr, buf
+ * @retval  bytes written
+ * @note    none
+ */
+static kssize_t sysfs_iostat_ioctl_show(struct fwk_kobject *sprt_kobj, struct fwk_attribute *sprt_attr, kchar_t *buf)
+{
+	return sysfs_iostat_show(sprt_kobj, mrt_member_offset(struct fwk_io_stats, sgrt_ioctl), buf);
+}
+
+static struct fwk_attribute sgrt_sysfs_iostat_read = __FWK_ATTR(read, O_RDONLY, sysfs_iostat_read_show, mrt_nullptr);
+static struct fwk_attribute sgrt_sysfs_iostat_write = __FWK_ATTR(write, O_RDONLY, sysfs_iostat_write_show, mrt_nullptr);
+static struct fwk_attribute sgrt_sysfs_iostat_ioctl = __FWK_ATTR(ioctl, O_RDONLY, sysfs_iostat_ioctl_show, mrt_nullptr);
+
+static struct fwk_attribute *sprt_sysfs_iostat_attrs[] =
+{
+	&sgrt_sysfs_iostat_read,
+	&sgrt_sysfs_iostat_write,
+	&sgrt_sysfs_iostat_ioctl,
+	mrt_nullptr,
+};
+
+static const struct fwk_attribute_group sgrt_sysfs_iostat_group =
+{
+	.sprt_attrs	= sprt_sysfs_iostat_attrs,
+};
+
+/*!
+ * @brief   create /sys/<device>/{read, write, ioctl}
+ * @param   sprt_inode: inode of the device node
+ * @param   name: device name, the same as /dev/<name>
+ * @retval  errno
+ * @note    time is in systick (GPT) counts (us)
+ */
+kint32_t fwk_sysfs_iostats_create(struct fwk_inode *sprt_inode, const kchar_t *name)
+{
+	struct fwk_kobject *sprt_dir;
+	kchar_t path[SYSFS_PATH_LENTH_MAX];
+	kint32_t retval;
+
+	if (!sprt_inode || !name)
+		return -ER_NOMEM;
+
+	if ((kstrlen(name) + 16) > SYSFS_PATH_LENTH_MAX)
+		return -ER_MORE;
+
+	sprintk(path, FWK_PATH_SYS_DEVICE "%s/", name);
+
+	sprt_dir = fwk_kobject_populate(mrt_nullptr, path);
+	if (!isValid(sprt_dir))
+		return -ER_FAILD;
+
+	sprt_dir->sprt_inode->private_data = sprt_inode;
+
+	retval = fwk_sysfs_create_group(sprt_dir, &sgrt_sysfs_iostat_group);
+	if (retval)
+		fwk_sysfs_iostats_remove(name);
+
+	return retval;
+}
+
+/*!
+ * @brief   remove /sys/<device>/
+ * @param   name: device name
+ * @retval  none
+ * @note    none
+ */
+void fwk_sysfs_iostats_remove(const kchar_t *name)
+{
+	struct fwk_kobject *sprt_dir;
+	struct fwk_kset *sprt_kset;
+	kchar_t path[SYSFS_PATH_LENTH_MAX];
+
+	if (!name || ((kstrlen(name) + 16) > SYSFS_PATH_LENTH_MAX))
+		return;
+
+	sprintk(path, FWK_PATH_SYS_DEVICE "%s/", name);
+
+	sprt_dir = fwk_find_kobject_by_path(mrt_nullptr, path);
+	sprt_kset = mrt_fwk_kset_get(sprt_dir);
+	if (!sprt_kset)
+		return;
+
+	fwk_sysfs_remove_group(sprt_dir, &sgrt_sysfs_iostat_group);
+	sprt_dir->sprt_inode->private_data = mrt_nullptr;
+
+	if (mrt_list_head_empty(&sprt_kset->sgrt_list))
+		fwk_kset_kobject_remove(sprt_dir);
+}
+
 /*!
  * @brief   sysfs_init
  * @param   none
@@ -35,6 +35,7 @@ typedef struct imx_gpio_port
 
 	kint32_t irq_base;
 	struct fwk_irq_generic *sprt_irqgc;
+	kuint32_t resend;								/*!< lines resent by software, see irq_retrigger */
 
 	struct list_head sgrt_link;
 
@@ -47,7 +48,7 @@ static DECLARE_LIST_HEAD(sgrt_imx_gpio_ports_list);
 /*!
  * @brief   isr
  * @param   ptrDev
- * @retval  errno
+ * @retval  IRQ_HANDLED, or IRQ_NONE if no line of this bank is pending
  * @note    none
  */
 static irq_return_t imx_gpiochip_driver_isr(void *ptrDev)
@@ -55,29 +56,61 @@ static irq_return_t imx_gpiochip_driver_isr(void *ptrDev)
 	struct imx_gpio_port *sprt_port;
 	struct fwk_irq_domain *sprt_domain;
 	srt_hal_imx_gpio_t *sprt_reg;
-	kbool_t irq_ena, irq_sta;
-	kuint32_t idx, irq;
+	kuint32_t pending, resend, idx, flags;
 
 	sprt_port = (struct imx_gpio_port *)ptrDev;
 	sprt_reg = (srt_hal_imx_gpio_t *)sprt_port->base;
 	sprt_domain = sprt_port->sprt_irqdomain;
-	
-	for (idx = 0; idx < 32; idx++)
-	{
-		irq_ena = !!mrt_getbitl(mrt_bit(idx), &sprt_reg->IMR);
-		irq_sta = !!mrt_getbitl(mrt_bit(idx), &sprt_reg->ISR);
 
-		if (!irq_ena || !irq_sta)
-			continue;
-		
-		irq = fwk_irq_get_by_domain(sprt_domain, idx);
-		fwk_do_irq_handler(irq);
+	mrt_local_irq_save(flags);
+	resend = sprt_port->resend;
+	sprt_port->resend = 0;
+	mrt_local_irq_restore(flags);
+
+	/*!< only the lines which are both pending and unmasked */
+	pending = (mrt_readl(&sprt_reg->ISR) | resend) & mrt_readl(&sprt_reg->IMR);
+	if (!pending)
+		return IRQ_NONE;
 
-		/*!< clear status bit */
-		mrt_setbitl(mrt_bit(idx), &sprt_reg->ISR);
+	/*!< clear status bits (write 1 to clear) at once, an edge arriving during dispatch will be latched again */
+	mrt_writel(pending, &sprt_reg->ISR);
+
+	while (pending)
+	{
+		idx = mrt_bit_ffs(pending);
+		pending &= pending - 1;
+
+		fwk_do_irq_handler(sprt_domain->revmap[idx]);
 	}
 
-	return ER_NORMAL;
+	return IRQ_HANDLED;
+}
+
+/*!
+ * @brief   resend an interrupt of gpio
+ * @param   sprt_data
+ * @retval  true if resent
+ * @note    the status bit has been cleared by the isr, so the line is marked by software,
+ *          and the parent line is raised, that the isr finds it on the IRQ path as usual
+ */
+static kbool_t imx_gpiochip_driver_irq_retrigger(struct fwk_irq_data *sprt_data)
+{
+	struct imx_gpio_port *sprt_port;
+	kint32_t irq;
+	kuint32_t flags;
+
+	sprt_port = fwk_irq_get_generic_data(sprt_data)->private;
+
+	/*!< both parent lines run the same isr, which checks all of 32 lines */
+	irq = ((sprt_data->hwirq < 16) && (sprt_port->irq_low >= 0)) ? sprt_port->irq_low : sprt_port->irq_high;
+	if (irq < 0)
+		return false;
+
+	mrt_local_irq_save(flags);
+	sprt_port->resend |= mrt_bit(sprt_data->hwirq);
+	mrt_local_irq_restore(flags);
+
+	return !fwk_irq_trigger(irq);
 }
 
 /*!
@@ -247,6 +280,7 @@ static kint32_t imx_gpiochip_driver_probe_intc(struct fwk_platdev *sprt_pdev)
 	sprt_gc->sgrt_chip.irq_unmask = sprt_chip->irq_unmask;
 	sprt_gc->sgrt_chip.irq_ack = sprt_chip->irq_ack;
 	sprt_gc->sgrt_chip.irq_set_type = imx_gpiochip_driver_irq_set_type;
+	sprt_gc->sgrt_chip.irq_retrigger = imx_gpiochip_driver_irq_retrigger;
 	sprt_gc->manage_reg = (kuaddr_t)&sprt_reg->IMR;
 	sprt_gc->status_reg = (kuaddr_t)&sprt_reg->ISR;
 	sprt_gc->private = sprt_port;
@@ -70,30 +70,33 @@ static kint32_t led_driver_close(struct fwk_inode *sprt_inode, struct fwk_file *
 
 /*!
  * @brief   led_driver_write
- * @param   sprt_file, ptrBuffer, size
- * @retval  errno
+ * @param   sprt_file, ptrBuffer, size, pos
+ * @retval  bytes written
  * @note    none
  */
-static kssize_t led_driver_write(struct fwk_file *sprt_file, const kbuffer_t *ptrBuffer, kssize_t size)
+static kssize_t led_driver_write(struct fwk_file *sprt_file, const kbuffer_t *ptrBuffer, kssize_t size, kloff_t *pos)
 {
 	struct led_drv_data *sprt_data;
 	kuint8_t value;
 
+	if (size < 1)
+		return 0;
+
 	sprt_data = (struct led_drv_data *)sprt_file->private_data;
 
 	fwk_copy_from_user(&value, ptrBuffer, 1);
 	fwk_gpio_set_value(sprt_data->sprt_gdesc, !!value);
 
-	return 0;
+	return 1;
 }
 
 /*!
  * @brief   led_driver_read
- * @param   sprt_file, ptrBuffer, size
- * @retval  errno
+ * @param   sprt_file, ptrBuffer, size, pos
+ * @retval  bytes read
  * @note    none
  */
-static kssize_t led_driver_read(struct fwk_file *sprt_file, kbuffer_t *ptrBuffer, kssize_t size)
+static kssize_t led_driver_read(struct fwk_file *sprt_file, kbuffer_t *ptrBuffer, kssize_t size, kloff_t *pos)
 {
 	return 0;
 }
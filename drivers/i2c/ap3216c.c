@@ -326,11 +326,11 @@ static kint32_t ap3216c_driver_close(struct fwk_inode *sprt_inode, struct fwk_fi
 
 /*!
  * @brief  driver read
- * @param  sprt_file, buffer, size
+ * @param  sprt_file, buffer, size, pos
  * @retval size
  * @note   none
  */
-static kssize_t ap3216c_driver_read(struct fwk_file *sprt_file, kbuffer_t *buffer, kssize_t size)
+static kssize_t ap3216c_driver_read(struct fwk_file *sprt_file, kbuffer_t *buffer, kssize_t size, kloff_t *pos)
 {
     struct ap3216c_drv_info *sprt_info;
     struct ap3216c_data sgrt_data;
@@ -102,156 +102,102 @@ static kint32_t at24cxx_read_eeprom(struct at24cxx_drv_info *sprt_info, kuint8_t
 
 /*!
  * @brief   at24cxx write
- * @param   sprt_info
- * @retval  errno
- * @note    none
+ * @param   sprt_info, sprt_eep
+ * @retval  bytes written, or errno
+ * @note    a page write can not go across the page boundary, so it is split by page
  */
 static kint32_t __at24cxx_driver_write(struct at24cxx_drv_info *sprt_info, struct fwk_eeprom *sprt_eep)
 {
     kuint8_t *buffer, *ptr_from;
-    kuint32_t end_addr, last_left, last_page;
-    kuint32_t first_page, first_left, pages;
-    kuint32_t idx;
+    kuint32_t addr, left, count;
     kint32_t retval = ER_NORMAL;
 
     if (!sprt_eep->buf || !sprt_eep->size)
         return -ER_EMPTY;
 
-    end_addr = sprt_eep->addr + sprt_eep->size;
-    if (end_addr >= sprt_info->total_size)
+    if ((sprt_eep->addr >= sprt_info->total_size) || 
+        (sprt_eep->size > (sprt_info->total_size - sprt_eep->addr)))
         return -ER_MORE;
 
-    buffer = kmalloc(sprt_eep->size + 1, GFP_KERNEL);
+    /*!< word address + one page */
+    buffer = kmalloc(sprt_info->page_size + 1, GFP_KERNEL);
     if (!isValid(buffer))
         return -ER_NOMEM;
 
     ptr_from = sprt_eep->buf;
-    first_left = last_left = 0;
-
-    /*!< get the page offset of the address will be read */
-    last_page = AT24CXX_PAGE_OFFSET(end_addr, sprt_info->page_size);
-    last_left = end_addr - last_page * sprt_info->page_size;
-
-    first_page = AT24CXX_PAGE_OFFSET(sprt_eep->addr, sprt_info->page_size);
-    if (first_page != last_page)
-        first_left = (first_page + 1) * sprt_info->page_size - sprt_eep->addr;
+    addr = sprt_eep->addr;
+    left = sprt_eep->size;
 
-    pages = (last_page > (first_page + 1)) ? (last_page - first_page - 1) : 0;
-    
-    if (first_left)
+    while (left)
     {
-        fwk_copy_from_user(buffer + 1, ptr_from, first_left);
-
-        *buffer = (kuint8_t)sprt_eep->addr + (kuint8_t)(ptr_from - sprt_eep->buf);
-        retval = at24cxx_write_eeprom(sprt_info, buffer, first_left + 1);
-        if (retval)
-            goto END;
-
-        ptr_from += first_left;
-    }
+        count = sprt_info->page_size - (addr % sprt_info->page_size);
+        count = mrt_ret_min2(count, left);
 
-    for (idx = 0; idx < pages; idx++)
-    {
-        ptr_from += idx * sprt_info->page_size;
-        fwk_copy_from_user(buffer + 1, ptr_from, sprt_info->page_size);
+        fwk_copy_from_user(buffer + 1, ptr_from, count);
 
-        *buffer = (kuint8_t)sprt_eep->addr + (kuint8_t)(ptr_from - sprt_eep->buf);
-        retval = at24cxx_write_eeprom(sprt_info, buffer, sprt_info->page_size + 1);
-        if (retval)
+        *buffer = (kuint8_t)addr;
+        retval = at24cxx_write_eeprom(sprt_info, buffer, count + 1);
+        if (retval < 0)
             goto END;
-    }
-    ptr_from += idx * sprt_info->page_size;
 
-    if (last_left)
-    {
-        fwk_copy_from_user(buffer + 1, ptr_from, last_left);
-
-        *buffer = (kuint8_t)sprt_eep->addr + (kuint8_t)(ptr_from - sprt_eep->buf);
-        retval = at24cxx_write_eeprom(sprt_info, buffer, last_left + 1);
-        if (retval)
-            goto END;
+        ptr_from += count;
+        addr += count;
+        left -= count;
     }
 
 END:
     kfree(buffer);
-    return retval ? retval : sprt_eep->size;
+    return (retval < 0) ? retval : sprt_eep->size;
 }
 
 /*!
  * @brief   at24cxx read
- * @param   sprt_info
- * @retval  errno
+ * @param   sprt_info, sprt_eep
+ * @retval  bytes read, or errno
  * @note    none
  */
 static kint32_t __at24cxx_driver_read(struct at24cxx_drv_info *sprt_info, struct fwk_eeprom *sprt_eep)
 {
     kuint8_t *buffer, *ptr_to;
-    kuint32_t end_addr, last_left, last_page;
-    kuint32_t first_page, first_left, pages;
-    kuint32_t idx;
+    kuint32_t addr, left, count;
     kint32_t retval = ER_NORMAL;
 
     if (!sprt_eep->buf || !sprt_eep->size)
         return -ER_EMPTY;
 
-    end_addr = sprt_eep->addr + sprt_eep->size;
-    if (end_addr >= sprt_info->total_size)
+    if ((sprt_eep->addr >= sprt_info->total_size) || 
+        (sprt_eep->size > (sprt_info->total_size - sprt_eep->addr)))
         return -ER_MORE;
 
-    buffer = kmalloc(sprt_eep->size + 1, GFP_KERNEL);
+    /*!< word address + one page */
+    buffer = kmalloc(sprt_info->page_size + 1, GFP_KERNEL);
     if (!isValid(buffer))
         return -ER_NOMEM;
 
     ptr_to = sprt_eep->buf;
-    first_left = last_left = 0;
-
-    /*!< get the page offset of the address will be read */
-    last_page = AT24CXX_PAGE_OFFSET(end_addr, sprt_info->page_size);
-    last_left = end_addr - last_page * sprt_info->page_size;
+    addr = sprt_eep->addr;
+    left = sprt_eep->size;
 
-    first_page = AT24CXX_PAGE_OFFSET(sprt_eep->addr, sprt_info->page_size);
-    if (first_page != last_page)
-        first_left = (first_page + 1) * sprt_info->page_size - sprt_eep->addr;
-
-    pages = (last_page > (first_page + 1)) ? (last_page - first_page - 1) : 0;
-    
-    if (first_left)
+    while (left)
     {
-        *buffer = (kuint8_t)sprt_eep->addr + (kuint8_t)(ptr_to - sprt_eep->buf);
-        retval = at24cxx_read_eeprom(sprt_info, buffer, first_left + 1);
-        if (retval)
-            goto END;
-
-        fwk_copy_to_user(ptr_to, buffer + 1, first_left);
-        ptr_to += first_left;
-    }
-
-    for (idx = 0; idx < pages; idx++)
-    {
-        ptr_to += idx * sprt_info->page_size;
+        count = sprt_info->page_size - (addr % sprt_info->page_size);
+        count = mrt_ret_min2(count, left);
 
-        *buffer = (kuint8_t)sprt_eep->addr + (kuint8_t)(ptr_to - sprt_eep->buf);
-        retval = at24cxx_read_eeprom(sprt_info, buffer, sprt_info->page_size + 1);
-        if (retval)
+        *buffer = (kuint8_t)addr;
+        retval = at24cxx_read_eeprom(sprt_info, buffer, count + 1);
+        if (retval < 0)
             goto END;
 
-        fwk_copy_to_user(ptr_to, buffer + 1, sprt_info->page_size);
-    }
-    ptr_to += idx * sprt_info->page_size;
+        fwk_copy_to_user(ptr_to, buffer + 1, count);
 
-    if (last_left)
-    {
-        *buffer = (kuint8_t)sprt_eep->addr + (kuint8_t)(ptr_to - sprt_eep->buf);
-        retval = at24cxx_read_eeprom(sprt_info, buffer, last_left + 1);
-        if (retval)
-            goto END;
-
-        fwk_copy_to_user(ptr_to, buffer + 1, last_left);
+        ptr_to += count;
+        addr += count;
+        left -= count;
     }
 
 END:
     kfree(buffer);
-    return retval ? retval : sprt_eep->size;
+    return (retval < 0) ? retval : sprt_eep->size;
 }
 
 /*!
@@ -283,6 +229,160 @@ static kint32_t at24cxx_driver_close(struct fwk_inode *sprt_inode, struct fwk_fi
     return ER_NORMAL;
 }
 
+/*!
+ * @brief   driver llseek
+ * @param   sprt_file, offset, whence
+ * @retval  new offset
+ * @note    none
+ */
+static kloff_t at24cxx_driver_llseek(struct fwk_file *sprt_file, kloff_t offset, kint32_t whence)
+{
+    struct at24cxx_drv_info *sprt_info = sprt_file->private_data;
+
+    return fwk_generic_file_llseek(sprt_file, offset, whence, sprt_info->total_size);
+}
+
+/*!
+ * @brief   driver read
+ * @param   sprt_file, buffer, size
+ * @param   pos: eeprom address
+ * @retval  bytes read, 0 at the end of eeprom
+ * @note    none
+ */
+static kssize_t at24cxx_driver_read(struct fwk_file *sprt_file, kbuffer_t *buffer, kssize_t size, kloff_t *pos)
+{
+    struct at24cxx_drv_info *sprt_info = sprt_file->private_data;
+    struct fwk_eeprom sgrt_eep;
+    kssize_t retval, left;
+
+    if ((*pos < 0) || (size < 0))
+        return -ER_UNVALID;
+
+    if ((*pos >= sprt_info->total_size) || !size)
+        return 0;
+
+    sgrt_eep.addr = *pos;
+    sgrt_eep.offset = 0;
+    sgrt_eep.buf = (kuint8_t *)buffer;
+    left = (kssize_t)(sprt_info->total_size - *pos);
+    sgrt_eep.size = mrt_ret_min2(size, left);
+
+    retval = __at24cxx_driver_read(sprt_info, &sgrt_eep);
+    if (retval > 0)
+        *pos += retval;
+
+    return retval;
+}
+
+/*!
+ * @brief   driver write
+ * @param   sprt_file, buffer, size
+ * @param   pos: eeprom address
+ * @retval  bytes written, 0 at the end of eeprom
+ * @note    none
+ */
+static kssize_t at24cxx_driver_write(struct fwk_file *sprt_file, const kbuffer_t *buffer, kssize_t size, kloff_t *pos)
+{
+    struct at24cxx_drv_info *sprt_info = sprt_file->private_data;
+    struct fwk_eeprom sgrt_eep;
+    kssize_t retval, left;
+
+    if ((*pos < 0) || (size < 0))
+        return -ER_UNVALID;
+
+    if ((*pos >= sprt_info->total_size) || !size)
+        return 0;
+
+    sgrt_eep.addr = *pos;
+    sgrt_eep.offset = 0;
+    sgrt_eep.buf = (kuint8_t *)buffer;
+    left = (kssize_t)(sprt_info->total_size - *pos);
+    sgrt_eep.size = mrt_ret_min2(size, left);
+
+    retval = __at24cxx_driver_write(sprt_info, &sgrt_eep);
+    if (retval > 0)
+        *pos += retval;
+
+    return retval;
+}
+
+/*!
+ * @brief   driver write (vectored)
+ * @param   sprt_file, sprt_iov, nr_segs
+ * @param   pos: eeprom address
+ * @retval  bytes written, 0 at the end of eeprom
+ * @note    the segments are gathered, and written by pages in one pass
+ */
+static kssize_t at24cxx_driver_write_iter(struct fwk_file *sprt_file, const struct fwk_iovec *sprt_iov, kuint32_t nr_segs, kloff_t *pos)
+{
+    struct at24cxx_drv_info *sprt_info = sprt_file->private_data;
+    struct fwk_eeprom sgrt_eep;
+    kssize_t retval, left;
+
+    if (*pos < 0)
+        return -ER_UNVALID;
+
+    retval = fwk_iov_length(sprt_iov, nr_segs);
+    if ((retval <= 0) || (*pos >= sprt_info->total_size))
+        return (retval < 0) ? retval : 0;
+
+    sgrt_eep.addr = *pos;
+    sgrt_eep.offset = 0;
+    left = (kssize_t)(sprt_info->total_size - *pos);
+    sgrt_eep.size = mrt_ret_min2(retval, left);
+    sgrt_eep.buf = kmalloc(sgrt_eep.size, GFP_KERNEL);
+    if (!isValid(sgrt_eep.buf))
+        return -ER_NOMEM;
+
+    fwk_copy_from_iovec(sgrt_eep.buf, sprt_iov, nr_segs, sgrt_eep.size);
+
+    retval = __at24cxx_driver_write(sprt_info, &sgrt_eep);
+    if (retval > 0)
+        *pos += retval;
+
+    kfree(sgrt_eep.buf);
+    return retval;
+}
+
+/*!
+ * @brief   driver read (vectored)
+ * @param   sprt_file, sprt_iov, nr_segs
+ * @param   pos: eeprom address
+ * @retval  bytes read, 0 at the end of eeprom
+ * @note    the eeprom is read by pages in one pass, and scattered to the segments
+ */
+static kssize_t at24cxx_driver_read_iter(struct fwk_file *sprt_file, const struct fwk_iovec *sprt_iov, kuint32_t nr_segs, kloff_t *pos)
+{
+    struct at24cxx_drv_info *sprt_info = sprt_file->private_data;
+    struct fwk_eeprom sgrt_eep;
+    kssize_t retval, left;
+
+    if (*pos < 0)
+        return -ER_UNVALID;
+
+    retval = fwk_iov_length(sprt_iov, nr_segs);
+    if ((retval <= 0) || (*pos >= sprt_info->total_size))
+        return (retval < 0) ? retval : 0;
+
+    sgrt_eep.addr = *pos;
+    sgrt_eep.offset = 0;
+    left = (kssize_t)(sprt_info->total_size - *pos);
+    sgrt_eep.size = mrt_ret_min2(retval, left);
+    sgrt_eep.buf = kmalloc(sgrt_eep.size, GFP_KERNEL);
+    if (!isValid(sgrt_eep.buf))
+        return -ER_NOMEM;
+
+    retval = __at24cxx_driver_read(sprt_info, &sgrt_eep);
+    if (retval > 0)
+    {
+        fwk_copy_to_iovec(sprt_iov, nr_segs, sgrt_eep.buf, retval);
+        *pos += retval;
+    }
+
+    kfree(sgrt_eep.buf);
+    return retval;
+}
+
 /*!
  * @brief   driver ioctl
  * @param   sprt_file, cmd, args
@@ -318,6 +418,11 @@ static const struct fwk_file_oprts sgrt_at24cxx_driver_oprts =
 {
     .open = at24cxx_driver_open,
     .close = at24cxx_driver_close,
+    .llseek = at24cxx_driver_llseek,
+    .read = at24cxx_driver_read,
+    .write = at24cxx_driver_write,
+    .write_iter = at24cxx_driver_write_iter,
+    .read_iter = at24cxx_driver_read_iter,
     .unlocked_ioctl = at24cxx_driver_ioctl,
 };
 
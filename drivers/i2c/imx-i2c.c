@@ -737,7 +737,7 @@ static kint32_t imx_i2c_driver_probe(struct fwk_platdev *sprt_pdev)
     imx_i2c_adap_initial(sprt_adap);
     fwk_clk_disable_unprepare(sprt_data->sprt_clk);
 
-    if (fwk_request_irq(sprt_data->irq, imx_i2c_adap_isr, IRQ_TYPE_NONE, "imx,i2c", sprt_adap))
+    if (fwk_request_irq(sprt_data->irq, imx_i2c_adap_isr, IRQ_TYPE_NONE | IRQF_PRIORITY(FWK_IRQ_PRIORITY_LOW), "imx,i2c", sprt_adap))
         goto fail4;
 
 	return ER_NORMAL;
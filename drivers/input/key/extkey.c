@@ -98,26 +98,29 @@ static kint32_t extkey_driver_close(struct fwk_inode *sprt_inode, struct fwk_fil
 
 /*!
  * @brief   extkey_driver_write
- * @param   sprt_file, ptrBuffer, size
- * @retval  errno
+ * @param   sprt_file, ptrBuffer, size, pos
+ * @retval  bytes written
  * @note    none
  */
-static kssize_t extkey_driver_write(struct fwk_file *sprt_file, const kbuffer_t *ptrBuffer, kssize_t size)
+static kssize_t extkey_driver_write(struct fwk_file *sprt_file, const kbuffer_t *ptrBuffer, kssize_t size, kloff_t *pos)
 {
 	return 0;
 }
 
 /*!
  * @brief   extkey_driver_read
- * @param   sprt_file, ptrBuffer, size
- * @retval  errno
+ * @param   sprt_file, ptrBuffer, size, pos
+ * @retval  bytes read
  * @note    none
  */
-static kssize_t extkey_driver_read(struct fwk_file *sprt_file, kbuffer_t *ptrBuffer, kssize_t size)
+static kssize_t extkey_driver_read(struct fwk_file *sprt_file, kbuffer_t *ptrBuffer, kssize_t size, kloff_t *pos)
 {
 	struct extkey_drv_data *sprt_data;
 	kuint8_t value;
 
+	if (size < 1)
+		return 0;
+
 	sprt_data = (struct extkey_drv_data *)sprt_file->private_data;
 	
 	if (!(sprt_file->mode & O_NONBLOCK))
@@ -133,7 +136,23 @@ static kssize_t extkey_driver_read(struct fwk_file *sprt_file, kbuffer_t *ptrBuf
 
 	sprt_data->wake = false;
 	
-	return 0;
+	return 1;
+}
+
+/*!
+ * @brief   extkey_driver_poll
+ * @param   sprt_file, sprt_pt
+ * @retval  POLLIN if a key event is pending
+ * @note    none
+ */
+static kuint32_t extkey_driver_poll(struct fwk_file *sprt_file, struct fwk_poll_table *sprt_pt)
+{
+	struct extkey_drv_data *sprt_data;
+
+	sprt_data = (struct extkey_drv_data *)sprt_file->private_data;
+	fwk_poll_wait(sprt_file, &sprt_data->sgrt_wqh, sprt_pt);
+
+	return sprt_data->wake ? (POLLIN | POLLRDNORM) : 0;
 }
 
 /*!< extkey-template driver operation */
@@ -143,6 +162,7 @@ const struct fwk_file_oprts sgrt_extkey_driver_oprts =
 	.close	= extkey_driver_close,
 	.write	= extkey_driver_write,
 	.read	= extkey_driver_read,
+	.poll	= extkey_driver_poll,
 };
 
 /*!< --------------------------------------------------------------------- */
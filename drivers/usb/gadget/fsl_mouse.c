@@ -195,22 +195,22 @@ static kint32_t fsl_mouse_driver_close(struct fwk_inode *sprt_inode, struct fwk_
 
 /*!
  * @brief   fsl_mouse_driver_write
- * @param   sprt_file, ptrBuffer, size
+ * @param   sprt_file, ptrBuffer, size, pos
  * @retval  errno
  * @note    none
  */
-static kssize_t fsl_mouse_driver_write(struct fwk_file *sprt_file, const kbuffer_t *ptrBuffer, kssize_t size)
+static kssize_t fsl_mouse_driver_write(struct fwk_file *sprt_file, const kbuffer_t *ptrBuffer, kssize_t size, kloff_t *pos)
 {
     return 0;
 }
 
 /*!
  * @brief   fsl_mouse_driver_read
- * @param   sprt_file, ptrBuffer, size
+ * @param   sprt_file, ptrBuffer, size, pos
  * @retval  errno
  * @note    none
  */
-static kssize_t fsl_mouse_driver_read(struct fwk_file *sprt_file, kbuffer_t *ptrBuffer, kssize_t size)
+static kssize_t fsl_mouse_driver_read(struct fwk_file *sprt_file, kbuffer_t *ptrBuffer, kssize_t size, kloff_t *pos)
 {
 	return 0;
 }
@@ -21,6 +21,7 @@
 #include <platform/fwk_pinctrl.h>
 #include <platform/gpio/fwk_gpiodesc.h>
 #include <platform/fwk_uaccess.h>
+#include <platform/fwk_dma.h>
 #include <platform/video/fwk_fbmem.h>
 
 #include <asm/imx6/imx6ull_periph.h>
@@ -49,6 +50,8 @@ struct imx_fbdev_drv
 	kuint32_t minor;
 
 	void *base;
+	void *buffer;										/*!< scan-out buffer, from dma coherent pool */
+	dma_addr_t dma_handle;
 	struct fwk_fb_info *sprt_fb;
 	struct fwk_device *sprt_dev;
 
@@ -59,9 +62,7 @@ struct imx_fbdev_drv
 };
 
 #define FBDEV_IMX_DRIVER_MINOR					0
-
-/* The globals */
-static kuint8_t g_imx_fbdev_buffer[480 * 272 * 4];
+#define FBDEV_IMX_BUFFER_SIZE					(480 * 272 * 4)
 
 /*!< API function */
 /*!
@@ -464,19 +465,27 @@ static kint32_t imx_fbdev_driver_probe(struct fwk_platdev *sprt_pdev)
 	if (retval < 0)
 		goto fail5;
 
+	/*!< LCDIF reads the buffer behind the cache, so it must be uncached */
+	sprt_drv->buffer = fwk_dma_alloc_coherent(&sprt_pdev->sgrt_dev, FBDEV_IMX_BUFFER_SIZE, 
+										&sprt_drv->dma_handle, GFP_KERNEL | GFP_ZERO);
+	if (!isValid(sprt_drv->buffer))
+		goto fail6;
+
 	sprt_fb->sprt_fbops = &sgrt_fwk_fb_ops;
 	sprt_fb->node = sprt_drv->minor;
-	sprt_fb->sgrt_fix.smem_start = (kuaddr_t)(&g_imx_fbdev_buffer[0]);
-	sprt_fb->sgrt_fix.smem_len = sizeof(g_imx_fbdev_buffer);
+	sprt_fb->sgrt_fix.smem_start = (kuaddr_t)sprt_drv->dma_handle;
+	sprt_fb->sgrt_fix.smem_len = FBDEV_IMX_BUFFER_SIZE;
 
 	retval = fwk_register_framebuffer(sprt_fb);
 	if (retval < 0)
-		goto fail6;
+		goto fail7;
 
 	imx_fbdev_init(base, sprt_drv);
 
 	return ER_NORMAL;
 
+fail7:
+	fwk_dma_free_coherent(&sprt_pdev->sgrt_dev, FBDEV_IMX_BUFFER_SIZE, sprt_drv->buffer, sprt_drv->dma_handle);
 fail6:
 	imx_fbdev_remove_backlight(&sprt_drv->sgrt_blight);
 fail5:
@@ -520,6 +529,7 @@ static kint32_t imx_fbdev_driver_remove(struct fwk_platdev *sprt_pdev)
 	fwk_clk_put(sprt_drv->sprt_clk[0]);
 
 	imx_fbdev_remove_backlight(&sprt_drv->sgrt_blight);
+	fwk_dma_free_coherent(&sprt_pdev->sgrt_dev, FBDEV_IMX_BUFFER_SIZE, sprt_drv->buffer, sprt_drv->dma_handle);
 
 	fwk_io_unmap(sprt_drv->base);
 	kfree(sprt_fb);
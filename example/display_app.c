@@ -153,7 +153,7 @@ static void *display_app_entry(void *args)
         virt_ioctl(fd, NR_FB_IOGetVScreenInfo, &sgrt_var);
         virt_ioctl(fd, NR_FB_IOGetFScreenInfo, &sgrt_fix);
 
-        fbuffer = (kuint32_t *)virt_mmap(mrt_nullptr, sgrt_fix.smem_len, 0, 0, fd, 0);
+        fbuffer = (kuint32_t *)virt_mmap(mrt_nullptr, sgrt_fix.smem_len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
         if (!isValid(fbuffer))
         {
             virt_close(fd);
@@ -176,7 +176,7 @@ static void *display_app_entry(void *args)
         if (fd < 0)
             goto END;
 
-        fbuffer = (kuint32_t *)virt_mmap(mrt_nullptr, sgrt_fix.smem_len, 0, 0, fd, 0);
+        fbuffer = (kuint32_t *)virt_mmap(mrt_nullptr, sgrt_fix.smem_len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
         if (!isValid(fbuffer))
         {
             virt_close(fd);
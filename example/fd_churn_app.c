@@ -0,0 +1,166 @@
+/*
+ * User Thread Instance (file descriptor churn task) Interface
+ *
+ * File Name:   fd_churn_app.c
+ * Author:      Yang Yujun
+ * E-mail:      <yujiantianhu@163.com>
+ * Created on:  2024.07.28
+ *
+ * Copyright (c) 2024   Yang Yujun <yujiantianhu@163.com>
+ *
+ */
+
+/*!< The globals */
+#include <common/basic_types.h>
+#include <common/error_types.h>
+#include <common/generic.h>
+#include <common/io_stream.h>
+#include <common/time.h>
+#include <platform/fwk_fcntl.h>
+#include <kernel/kernel.h>
+#include <kernel/sched.h>
+#include <kernel/thread.h>
+#include <kernel/sleep.h>
+
+#include "thread_table.h"
+
+/*!< The defines */
+#define FDCHURNAPP_THREAD_STACK_SIZE                        REAL_THREAD_STACK_HALF(1)    /*!< 1/2 page (2kbytes) */
+
+/*!<
+ * FDCHURNAPP_FILES descriptors are held open (the fd table grows from FILE_DESC_NUM_MAX on the way),
+ * then FDCHURNAPP_CHURN random ones are closed and opened again; a pass runs every FDCHURNAPP_PERIOD_MS
+ */
+#define FDCHURNAPP_FILES                                    (2048)
+#define FDCHURNAPP_CHURN                                    (4096)
+#define FDCHURNAPP_PERIOD_MS                                (10000)
+
+/*!< a file which can be opened any number of times, and has no open/close cost of its own */
+#define FDCHURNAPP_FILE                                     "/sys/interrupts"
+
+/*!< The globals */
+static real_thread_t g_fd_churn_app_tid;
+static struct real_thread_attr sgrt_fd_churn_app_attr;
+static kuint32_t g_fd_churn_app_stack[FDCHURNAPP_THREAD_STACK_SIZE];
+static kint32_t g_fd_churn_app_fds[FDCHURNAPP_FILES];
+
+/*!< API functions */
+/*!
+ * @brief  run one pass
+ * @param  none
+ * @retval none
+ * @note   the lowest free descriptor is always given out, so that a descriptor closed alone
+ *         must be the one got by the next open; otherwise it is counted as a mismatch
+ *         (a few are possible, if other threads open files at the same time)
+ */
+static void fd_churn_app_run(void)
+{
+    kint32_t *fds = g_fd_churn_app_fds;
+    kuint32_t start, open_us, churn_us, close_us;
+    kuint32_t opened, idx, slot, seed = 1, mismatch = 0;
+    kint32_t fd;
+
+    /*!< open: the table is doubled whenever it is full */
+    start = get_time_stamp_usecs();
+
+    for (opened = 0; opened < FDCHURNAPP_FILES; opened++)
+    {
+        fds[opened] = virt_open(FDCHURNAPP_FILE, O_RDONLY);
+        if (fds[opened] < 0)
+            break;
+    }
+
+    open_us = get_time_stamp_elapsed(start);
+
+    if (!opened)
+    {
+        print_err("%s: can not open %s\n", __FUNCTION__, FDCHURNAPP_FILE);
+        return;
+    }
+
+    /*!< churn: close one in the middle of the table and open again */
+    start = get_time_stamp_usecs();
+
+    for (idx = 0; idx < FDCHURNAPP_CHURN; idx++)
+    {
+        seed = seed * 1103515245U + 12345U;
+        slot = (seed >> 16) % opened;
+        fd = fds[slot];
+
+        virt_close(fd);
+        fds[slot] = virt_open(FDCHURNAPP_FILE, O_RDONLY);
+        if (fds[slot] != fd)
+            mismatch++;
+    }
+
+    churn_us = get_time_stamp_elapsed(start);
+
+    /*!< close: the tables are kept for the next pass */
+    start = get_time_stamp_usecs();
+
+    for (idx = 0; idx < opened; idx++)
+    {
+        if (fds[idx] >= 0)
+            virt_close(fds[idx]);
+    }
+
+    close_us = get_time_stamp_elapsed(start);
+
+    /*!< ns per operation; the passes are short enough to stay in 32 bits */
+    print_info("%s: %d fds held, %d ns per open, %d ns per close+open (%d pairs), %d ns per close\n",
+                __FUNCTION__, opened, open_us * 1000 / opened, churn_us * 1000 / FDCHURNAPP_CHURN,
+                FDCHURNAPP_CHURN, close_us * 1000 / opened);
+
+    if (mismatch || (opened < FDCHURNAPP_FILES))
+        print_err("%s: %d of %d opened, %d reopens did not get the lowest free fd\n",
+                    __FUNCTION__, opened, FDCHURNAPP_FILES, mismatch);
+}
+
+/*!
+ * @brief  file descriptor churn task
+ * @param  none
+ * @retval none
+ * @note   none
+ */
+static void *fd_churn_app_entry(void *args)
+{
+    while (!ptr_systick_counter)
+        schedule_delay_ms(200);
+
+    for (;;)
+    {
+        fd_churn_app_run();
+        schedule_delay_ms(FDCHURNAPP_PERIOD_MS);
+    }
+
+    return args;
+}
+
+/*!
+ * @brief	create file descriptor churn task
+ * @param  	none
+ * @retval 	error code
+ * @note   	none
+ */
+kint32_t fd_churn_app_init(void)
+{
+    struct real_thread_attr *sprt_attr = &sgrt_fd_churn_app_attr;
+    kint32_t retval;
+
+	sprt_attr->detachstate = REAL_THREAD_CREATE_JOINABLE;
+	sprt_attr->inheritsched	= REAL_THREAD_INHERIT_SCHED;
+	sprt_attr->schedpolicy = REAL_THREAD_SCHED_FIFO;
+
+    /*!< thread stack */
+	real_thread_set_stack(sprt_attr, mrt_nullptr, g_fd_churn_app_stack, sizeof(g_fd_churn_app_stack));
+    /*!< lowest priority */
+	real_thread_set_priority(sprt_attr, REAL_THREAD_PROTY_DEFAULT);
+    /*!< default time slice */
+    real_thread_set_time_slice(sprt_attr, REAL_THREAD_TIME_DEFUALT);
+
+    /*!< register thread */
+    retval = real_thread_create(&g_fd_churn_app_tid, sprt_attr, fd_churn_app_entry, mrt_nullptr);
+    return (retval < 0) ? retval : 0;
+}
+
+/*!< end of file */
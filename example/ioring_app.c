@@ -0,0 +1,267 @@
+/*
+ * User Thread Instance (io ring throughput task) Interface
+ *
+ * File Name:   ioring_app.c
+ * Author:      Yang Yujun
+ * E-mail:      <yujiantianhu@163.com>
+ * Created on:  2024.07.28
+ *
+ * Copyright (c) 2024   Yang Yujun <yujiantianhu@163.com>
+ *
+ */
+
+/*!< The globals */
+#include <common/basic_types.h>
+#include <common/error_types.h>
+#include <common/generic.h>
+#include <common/io_stream.h>
+#include <common/time.h>
+#include <platform/fwk_fcntl.h>
+#include <platform/fwk_ioring.h>
+#include <kernel/kernel.h>
+#include <kernel/sched.h>
+#include <kernel/thread.h>
+#include <kernel/sleep.h>
+
+#include "thread_table.h"
+
+/*!< The defines */
+#define IORINGAPP_THREAD_STACK_SIZE                         REAL_THREAD_STACK_HALF(1)    /*!< 1/2 page (2kbytes) */
+
+/*!< sqes submitted at once; every pass reads at most IORINGAPP_BYTES_MAX, and passes run every IORINGAPP_PERIOD_MS */
+#define IORINGAPP_BATCH                                     (16)
+#define IORINGAPP_BYTES_MAX                                 (256 * 1024)
+#define IORINGAPP_PERIOD_MS                                 (5000)
+
+/*!< the files are only read, so that the contents are kept */
+struct ioring_app_target
+{
+    const kchar_t *name;
+    kusize_t chunk;                                         /*!< bytes per request */
+};
+
+struct ioring_app_result
+{
+    kuint32_t bytes;
+    kuint32_t ops;
+    kuint32_t usecs;
+};
+
+/*!< The globals */
+static real_thread_t g_ioring_app_tid;
+static struct real_thread_attr sgrt_ioring_app_attr;
+static kuint32_t g_ioring_app_stack[IORINGAPP_THREAD_STACK_SIZE];
+
+static const struct ioring_app_target sgrt_ioring_app_targets[] =
+{
+    { .name = "/dev/at24c02", .chunk = 32 },
+    { .name = "/dev/fb0", .chunk = 4096 },
+};
+
+/*!< API functions */
+/*!
+ * @brief  read the file from the start by plain pread
+ * @param  fd, buf, chunk, sprt_result
+ * @retval error code
+ * @note   one request per call, in the caller's thread
+ */
+static kint32_t ioring_app_read_plain(kint32_t fd, kuint8_t *buf, kusize_t chunk, struct ioring_app_result *sprt_result)
+{
+    kuint32_t start;
+    kssize_t retval = 0;
+
+    start = get_time_stamp_usecs();
+
+    while (sprt_result->bytes < IORINGAPP_BYTES_MAX)
+    {
+        retval = virt_pread(fd, buf, chunk, sprt_result->bytes);
+        if (retval <= 0)
+            break;
+
+        sprt_result->bytes += retval;
+        sprt_result->ops++;
+    }
+
+    sprt_result->usecs = get_time_stamp_elapsed(start);
+
+    return (retval < 0) ? retval : ER_NORMAL;
+}
+
+/*!
+ * @brief  read the file from the start by io ring
+ * @param  sprt_ring, fd, buf, chunk, sprt_result
+ * @retval error code
+ * @note   IORINGAPP_BATCH requests per submission, each one into its own slot of buf;
+ *         all of a batch are reaped before the next one, so that the offsets stay in order
+ */
+static kint32_t ioring_app_read_ring(struct fwk_io_ring *sprt_ring, kint32_t fd, kuint8_t *buf, kusize_t chunk,
+                                    struct ioring_app_result *sprt_result)
+{
+    struct fwk_io_sqe *sprt_sqe;
+    struct fwk_io_cqe *sprt_cqe;
+    kuint32_t start, offset = 0, idx, count;
+    kssize_t retval = 0;
+    kbool_t eof = false;
+
+    start = get_time_stamp_usecs();
+
+    while (!eof && (offset < IORINGAPP_BYTES_MAX))
+    {
+        for (count = 0; (count < IORINGAPP_BATCH) && (offset < IORINGAPP_BYTES_MAX); count++)
+        {
+            sprt_sqe = fwk_io_ring_get_sqe(sprt_ring);
+            if (!sprt_sqe)
+                break;
+
+            fwk_io_ring_prep_rw(sprt_sqe, NR_IO_RING_OP_READ, fd, buf + count * chunk, chunk, offset, count);
+            offset += chunk;
+        }
+
+        if (!count)
+            break;
+
+        virt_io_ring_submit(sprt_ring);
+
+        for (idx = 0; idx < count; idx++)
+        {
+            do
+            {
+                sprt_cqe = virt_io_ring_wait_cqe(sprt_ring, -1);
+
+            } while (!sprt_cqe);
+
+            retval = sprt_cqe->res;
+            fwk_io_ring_cqe_seen(sprt_ring);
+
+            if (retval <= 0)
+            {
+                eof = true;
+                continue;
+            }
+
+            sprt_result->bytes += retval;
+            sprt_result->ops++;
+        }
+    }
+
+    sprt_result->usecs = get_time_stamp_elapsed(start);
+
+    return (retval < 0) ? retval : ER_NORMAL;
+}
+
+/*!
+ * @brief  print a result
+ * @param  name, mode, sprt_result
+ * @retval none
+ * @note   throughput in KB/s, with millisecond resolution, to stay in 32 bits
+ */
+static void ioring_app_report(const kchar_t *name, const kchar_t *mode, struct ioring_app_result *sprt_result)
+{
+    kuint32_t msecs = mrt_ret_max2(sprt_result->usecs / 1000, 1U);
+
+    print_info("    %s (%s): %d bytes by %d requests in %d us, %d KB/s, %d us per request\n",
+                name, mode, sprt_result->bytes, sprt_result->ops, sprt_result->usecs,
+                (sprt_result->bytes >> 10) * 1000 / msecs,
+                sprt_result->ops ? (sprt_result->usecs / sprt_result->ops) : 0);
+}
+
+/*!
+ * @brief  run one pass on a file
+ * @param  sprt_target
+ * @retval none
+ * @note   the file is opened once, and read from the start by each way
+ */
+static void ioring_app_run(const struct ioring_app_target *sprt_target)
+{
+    struct ioring_app_result sgrt_plain, sgrt_ring;
+    struct fwk_io_ring *sprt_ring;
+    kuint8_t *buf;
+    kint32_t fd;
+
+    fd = virt_open(sprt_target->name, O_RDONLY);
+    if (fd < 0)
+        return;
+
+    buf = kmalloc(sprt_target->chunk * IORINGAPP_BATCH, GFP_KERNEL);
+    if (!isValid(buf))
+        goto fail1;
+
+    sprt_ring = virt_io_ring_setup(IORINGAPP_BATCH);
+    if (!isValid(sprt_ring))
+        goto fail2;
+
+    memory_reset(&sgrt_plain, sizeof(sgrt_plain));
+    memory_reset(&sgrt_ring, sizeof(sgrt_ring));
+
+    if (ioring_app_read_plain(fd, buf, sprt_target->chunk, &sgrt_plain) ||
+        ioring_app_read_ring(sprt_ring, fd, buf, sprt_target->chunk, &sgrt_ring))
+        print_err("%s: reading %s failed\n", __FUNCTION__, sprt_target->name);
+    else
+    {
+        ioring_app_report(sprt_target->name, "read", &sgrt_plain);
+        ioring_app_report(sprt_target->name, "io ring", &sgrt_ring);
+    }
+
+    virt_io_ring_destroy(sprt_ring);
+
+fail2:
+    kfree(buf);
+fail1:
+    virt_close(fd);
+}
+
+/*!
+ * @brief  io ring throughput task
+ * @param  none
+ * @retval none
+ * @note   the same files are read by plain pread and by io ring batches, chunk by chunk;
+ *         a file which can not be opened (driver not probed) is skipped
+ */
+static void *ioring_app_entry(void *args)
+{
+    kuint32_t i;
+
+    while (!ptr_systick_counter)
+        schedule_delay_ms(200);
+
+    for (;;)
+    {
+        print_info("%s: pread vs io ring (%d requests per submission)\n", __FUNCTION__, IORINGAPP_BATCH);
+
+        for (i = 0; i < ARRAY_SIZE(sgrt_ioring_app_targets); i++)
+            ioring_app_run(&sgrt_ioring_app_targets[i]);
+
+        schedule_delay_ms(IORINGAPP_PERIOD_MS);
+    }
+
+    return args;
+}
+
+/*!
+ * @brief	create io ring throughput task
+ * @param  	none
+ * @retval 	error code
+ * @note   	none
+ */
+kint32_t ioring_app_init(void)
+{
+    struct real_thread_attr *sprt_attr = &sgrt_ioring_app_attr;
+    kint32_t retval;
+
+	sprt_attr->detachstate = REAL_THREAD_CREATE_JOINABLE;
+	sprt_attr->inheritsched	= REAL_THREAD_INHERIT_SCHED;
+	sprt_attr->schedpolicy = REAL_THREAD_SCHED_FIFO;
+
+    /*!< thread stack */
+	real_thread_set_stack(sprt_attr, mrt_nullptr, g_ioring_app_stack, sizeof(g_ioring_app_stack));
+    /*!< lowest priority */
+	real_thread_set_priority(sprt_attr, REAL_THREAD_PROTY_DEFAULT);
+    /*!< default time slice */
+    real_thread_set_time_slice(sprt_attr, REAL_THREAD_TIME_DEFUALT);
+
+    /*!< register thread */
+    retval = real_thread_create(&g_ioring_app_tid, sprt_attr, ioring_app_entry, mrt_nullptr);
+    return (retval < 0) ? retval : 0;
+}
+
+/*!< end of file */
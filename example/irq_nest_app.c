@@ -0,0 +1,222 @@
+/*
+ * User Thread Instance (irq nesting test task) Interface
+ *
+ * File Name:   irq_nest_app.c
+ * Author:      Yang Yujun
+ * E-mail:      <yujiantianhu@163.com>
+ * Created on:  2024.07.27
+ *
+ * Copyright (c) 2024   Yang Yujun <yujiantianhu@163.com>
+ *
+ */
+
+/*!< The globals */
+#include <common/basic_types.h>
+#include <common/error_types.h>
+#include <common/generic.h>
+#include <common/io_stream.h>
+#include <common/time.h>
+#include <platform/of/fwk_of.h>
+#include <platform/irq/fwk_irq_types.h>
+#include <platform/irq/fwk_irq_chip.h>
+#include <kernel/kernel.h>
+#include <kernel/sched.h>
+#include <kernel/thread.h>
+#include <kernel/sleep.h>
+#include <asm/interrupt.h>
+
+#include "thread_table.h"
+
+/*!< The defines */
+#define IRQNESTAPP_THREAD_STACK_SIZE                        REAL_THREAD_STACK_HALF(1)    /*!< 1/2 page (2kbytes) */
+
+/*!<
+ * the low priority handler spins a little longer than one tick, so that every run spans a systick;
+ * it is raised once every IRQNESTAPP_PERIOD_MS, and the result is printed every IRQNESTAPP_LOOPS runs
+ */
+#define IRQNESTAPP_HANDLER_US                               (TIME_STAMP_USECS_PER_TICK + (TIME_STAMP_USECS_PER_TICK >> 2))
+#define IRQNESTAPP_PERIOD_MS                                (100)
+#define IRQNESTAPP_LOOPS                                    (50)
+
+struct irq_nest_app_stats
+{
+    kuint32_t handlers;                                     /*!< runs of the low priority handler */
+    kuint32_t nested;                                       /*!< systick handlers which preempted it */
+    kuint32_t blocked;                                      /*!< runs which spanned a tick, but systick did not preempt */
+    kuint32_t min;                                          /*!< systick latency (us), with its handler */
+    kuint32_t max;
+    kuint32_t sum;
+};
+
+/*!< The globals */
+static real_thread_t g_irq_nest_app_tid;
+static struct real_thread_attr sgrt_irq_nest_app_attr;
+static kuint32_t g_irq_nest_app_stack[IRQNESTAPP_THREAD_STACK_SIZE];
+static struct irq_nest_app_stats sgrt_irq_nest_app_stats;
+
+/*!< the second GPT is not used by the OS (the first one is systick), its line is raised by software */
+static const struct fwk_of_device_id sgrt_irq_nest_app_ids[] =
+{
+    { .compatible = "fsl,imx6ul-gpt" },
+    {},
+};
+
+/*!< API functions */
+/*!
+ * @brief  long low priority handler
+ * @param  ptrDev: statistics
+ * @retval IRQ_HANDLED
+ * @note   the systick counter restarts from 0 on every tick, so when the handler finds that jiffies has moved,
+ *         the counter is the time from the tick to the return of the systick handler which preempted it
+ */
+static irq_return_t irq_nest_app_isr(void *ptrDev)
+{
+    struct irq_nest_app_stats *sprt_stats = (struct irq_nest_app_stats *)ptrDev;
+    kutime_t tick, now_tick;
+    kuint32_t prev, now, elapsed = 0;
+    kbool_t crossed = false, nested = false;
+
+    tick = *(volatile kutime_t *)&jiffies;
+    prev = (kuint32_t)(*(volatile kutime_t *)ptr_systick_counter);
+
+    while (elapsed < IRQNESTAPP_HANDLER_US)
+    {
+        /*!< jiffies first: a systick which comes in between is found on the next loop */
+        now_tick = *(volatile kutime_t *)&jiffies;
+        now = (kuint32_t)(*(volatile kutime_t *)ptr_systick_counter);
+
+        if (now < prev)
+        {
+            crossed = true;
+            elapsed += now + TIME_STAMP_USECS_PER_TICK - prev;
+        }
+        else
+            elapsed += now - prev;
+
+        prev = now;
+
+        /*!< jiffies only moves if the systick handler has run inside this one */
+        if (now_tick != tick)
+        {
+            tick = now_tick;
+            nested = true;
+
+            sprt_stats->nested++;
+            sprt_stats->sum += now;
+            if (now < sprt_stats->min)
+                sprt_stats->min = now;
+            if (now > sprt_stats->max)
+                sprt_stats->max = now;
+        }
+    }
+
+    sprt_stats->handlers++;
+    if (crossed && !nested)
+        sprt_stats->blocked++;
+
+    return IRQ_HANDLED;
+}
+
+/*!
+ * @brief  print and reset statistics
+ * @param  sprt_stats
+ * @retval none
+ * @note   none
+ */
+static void irq_nest_app_report(struct irq_nest_app_stats *sprt_stats)
+{
+    struct irq_nest_app_stats sgrt_stats;
+    kuint32_t flags;
+
+    mrt_local_irq_save(flags);
+    memory_copy(&sgrt_stats, sprt_stats, sizeof(sgrt_stats));
+    memory_reset(sprt_stats, sizeof(*sprt_stats));
+    sprt_stats->min = ~0U;
+    mrt_local_irq_restore(flags);
+
+    print_info("%s: %d low priority handlers of %d us, %d preempted by systick, %d blocked it, max nest level %d\n",
+                __FUNCTION__, sgrt_stats.handlers, IRQNESTAPP_HANDLER_US, sgrt_stats.nested, sgrt_stats.blocked,
+                exec_irq_get_entry_stats()->max_nest_level);
+
+    if (sgrt_stats.nested)
+        print_info("    systick latency (us): min %d, avg %d, max %d\n",
+                    sgrt_stats.min, sgrt_stats.sum / sgrt_stats.nested, sgrt_stats.max);
+}
+
+/*!
+ * @brief  irq nesting test task
+ * @param  none
+ * @retval none
+ * @note   passes if "blocked" stays 0, and the systick latency stays far below the length of the low priority handler
+ */
+static void *irq_nest_app_entry(void *args)
+{
+    struct irq_nest_app_stats *sprt_stats = &sgrt_irq_nest_app_stats;
+    struct fwk_device_node *sprt_node;
+    kint32_t irq;
+
+    while (!ptr_systick_counter)
+        schedule_delay_ms(200);
+
+    memory_reset(sprt_stats, sizeof(*sprt_stats));
+    sprt_stats->min = ~0U;
+
+    sprt_node = fwk_of_find_matching_node_and_match(mrt_nullptr, sgrt_irq_nest_app_ids, mrt_nullptr);
+    if (isValid(sprt_node))
+        sprt_node = fwk_of_find_matching_node_and_match(sprt_node, sgrt_irq_nest_app_ids, mrt_nullptr);
+
+    irq = isValid(sprt_node) ? fwk_of_irq_get(sprt_node, 0) : -ER_NODEV;
+    if ((irq < 0) || fwk_request_irq(irq, irq_nest_app_isr, IRQF_PRIORITY(FWK_IRQ_PRIORITY_LOWEST), "irq-nest-app", sprt_stats))
+    {
+        print_err("%s: no free line to test, exit\n", __FUNCTION__);
+        goto out;
+    }
+
+    for (;;)
+    {
+        if (fwk_irq_trigger(irq))
+            break;
+
+        schedule_delay_ms(IRQNESTAPP_PERIOD_MS);
+
+        if (sprt_stats->handlers >= IRQNESTAPP_LOOPS)
+            irq_nest_app_report(sprt_stats);
+    }
+
+    fwk_free_irq(irq, sprt_stats);
+
+out:
+    for (;;)
+        schedule_thread_suspend(mrt_current->tid);
+
+    return args;
+}
+
+/*!
+ * @brief	create irq nesting test task
+ * @param  	none
+ * @retval 	error code
+ * @note   	none
+ */
+kint32_t irq_nest_app_init(void)
+{
+    struct real_thread_attr *sprt_attr = &sgrt_irq_nest_app_attr;
+    kint32_t retval;
+
+	sprt_attr->detachstate = REAL_THREAD_CREATE_JOINABLE;
+	sprt_attr->inheritsched	= REAL_THREAD_INHERIT_SCHED;
+	sprt_attr->schedpolicy = REAL_THREAD_SCHED_FIFO;
+
+    /*!< thread stack */
+	real_thread_set_stack(sprt_attr, mrt_nullptr, g_irq_nest_app_stack, sizeof(g_irq_nest_app_stack));
+    /*!< lowest priority */
+	real_thread_set_priority(sprt_attr, REAL_THREAD_PROTY_DEFAULT);
+    /*!< default time slice */
+    real_thread_set_time_slice(sprt_attr, REAL_THREAD_TIME_DEFUALT);
+
+    /*!< register thread */
+    retval = real_thread_create(&g_irq_nest_app_tid, sprt_attr, irq_nest_app_entry, mrt_nullptr);
+    return (retval < 0) ? retval : 0;
+}
+
+/*!< end of file */
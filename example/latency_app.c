@@ -0,0 +1,177 @@
+/*
+ * User Thread Instance (wakeup latency task) Interface
+ *
+ * File Name:   latency_app.c
+ * Author:      Yang Yujun
+ * E-mail:      <yujiantianhu@163.com>
+ * Created on:  2024.07.20
+ *
+ * Copyright (c) 2024   Yang Yujun <yujiantianhu@163.com>
+ *
+ */
+
+/*!< The globals */
+#include <common/basic_types.h>
+#include <common/error_types.h>
+#include <common/generic.h>
+#include <common/io_stream.h>
+#include <common/time.h>
+#include <kernel/kernel.h>
+#include <kernel/sched.h>
+#include <kernel/thread.h>
+#include <kernel/sleep.h>
+
+#include "thread_table.h"
+
+/*!< The defines */
+#define LATENCYAPP_THREAD_STACK_SIZE                        REAL_THREAD_STACK_HALF(1)    /*!< 1/2 page (2kbytes) */
+
+/*!< wake up once per tick, and print the result every LATENCYAPP_LOOPS wakeups */
+#define LATENCYAPP_LOOPS                                    (1000)
+
+/*!< histogram: upper bound (us) of every bucket, the last one takes the rest */
+static const kuint32_t g_latency_app_buckets[] = { 10, 20, 50, 100, 200, 500, 1000, 2000, 5000, ~0U };
+#define LATENCYAPP_BUCKETS                                  ARRAY_SIZE(g_latency_app_buckets)
+
+struct latency_app_stats
+{
+    kuint32_t min;
+    kuint32_t max;
+    kuint32_t sum;
+    kuint32_t count;
+    kuint32_t hist[LATENCYAPP_BUCKETS];
+};
+
+/*!< The globals */
+static real_thread_t g_latency_app_tid;
+static struct real_thread_attr sgrt_latency_app_attr;
+static kuint32_t g_latency_app_stack[LATENCYAPP_THREAD_STACK_SIZE];
+static struct latency_app_stats sgrt_latency_app_stats;
+
+/*!< API functions */
+/*!
+ * @brief  account a wakeup latency
+ * @param  sprt_stats, latency (us)
+ * @retval none
+ * @note   none
+ */
+static void latency_app_account(struct latency_app_stats *sprt_stats, kuint32_t latency)
+{
+    kuint32_t i;
+
+    if (latency < sprt_stats->min)
+        sprt_stats->min = latency;
+    if (latency > sprt_stats->max)
+        sprt_stats->max = latency;
+
+    sprt_stats->sum += latency;
+    sprt_stats->count++;
+
+    for (i = 0; i < LATENCYAPP_BUCKETS; i++)
+    {
+        if (latency < g_latency_app_buckets[i])
+        {
+            sprt_stats->hist[i]++;
+            break;
+        }
+    }
+}
+
+/*!
+ * @brief  print and reset statistics
+ * @param  sprt_stats
+ * @retval none
+ * @note   none
+ */
+static void latency_app_report(struct latency_app_stats *sprt_stats)
+{
+    kuint32_t i, lower = 0;
+
+    if (sprt_stats->count)
+        print_info("%s: %d wakeups, latency (us): min %d, avg %d, max %d\n", __FUNCTION__, sprt_stats->count,
+                    sprt_stats->min, sprt_stats->sum / sprt_stats->count, sprt_stats->max);
+
+    for (i = 0; i < LATENCYAPP_BUCKETS; i++)
+    {
+        if (sprt_stats->hist[i])
+        {
+            if (g_latency_app_buckets[i] == ~0U)
+                print_info("    >= %d us: %d\n", lower, sprt_stats->hist[i]);
+            else
+                print_info("    %d ~ %d us: %d\n", lower, g_latency_app_buckets[i] - 1, sprt_stats->hist[i]);
+        }
+
+        lower = g_latency_app_buckets[i];
+    }
+
+    memory_reset(sprt_stats, sizeof(*sprt_stats));
+    sprt_stats->min = ~0U;
+}
+
+/*!
+ * @brief  wakeup latency task
+ * @param  none
+ * @retval none
+ * @note   like cyclictest: sleep to a known tick, and measure how late the thread runs after it;
+ *         the timer expires on the tick where jiffies passes "expires", at counter 0
+ */
+static void *latency_app_entry(void *args)
+{
+    struct latency_app_stats *sprt_stats = &sgrt_latency_app_stats;
+    kutime_t expires, now;
+    kuint32_t usecs;
+
+    while (!ptr_systick_counter)
+        schedule_delay_ms(200);
+
+    memory_reset(sprt_stats, sizeof(*sprt_stats));
+    sprt_stats->min = ~0U;
+
+    for (;;)
+    {
+        expires = jiffies + 1;
+        schedule_timeout(expires);
+
+        usecs = get_time_stamp(&now);
+
+        /*!< woken up by others (not the timer), or jiffies has wrapped */
+        if (mrt_time_before_eq(now, expires))
+            continue;
+
+        latency_app_account(sprt_stats, (kuint32_t)(now - expires - 1) * TIME_STAMP_USECS_PER_TICK + usecs);
+
+        if (sprt_stats->count >= LATENCYAPP_LOOPS)
+            latency_app_report(sprt_stats);
+    }
+
+    return args;
+}
+
+/*!
+ * @brief	create wakeup latency task
+ * @param  	none
+ * @retval 	error code
+ * @note   	none
+ */
+kint32_t latency_app_init(void)
+{
+    struct real_thread_attr *sprt_attr = &sgrt_latency_app_attr;
+    kint32_t retval;
+
+	sprt_attr->detachstate = REAL_THREAD_CREATE_JOINABLE;
+	sprt_attr->inheritsched	= REAL_THREAD_INHERIT_SCHED;
+	sprt_attr->schedpolicy = REAL_THREAD_SCHED_FIFO;
+
+    /*!< thread stack */
+	real_thread_set_stack(sprt_attr, mrt_nullptr, g_latency_app_stack, sizeof(g_latency_app_stack));
+    /*!< higher than the other apps, so that it preempts them on wakeup */
+	real_thread_set_priority(sprt_attr, __THREAD_HIGHER_DEFAULT(2));
+    /*!< default time slice */
+    real_thread_set_time_slice(sprt_attr, REAL_THREAD_TIME_DEFUALT);
+
+    /*!< register thread */
+    retval = real_thread_create(&g_latency_app_tid, sprt_attr, latency_app_entry, mrt_nullptr);
+    return (retval < 0) ? retval : 0;
+}
+
+/*!< end of file */
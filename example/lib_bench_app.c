@@ -0,0 +1,926 @@
+/*
+ * User Thread Instance (library benchmark task) Interface
+ *
+ * File Name:   lib_bench_app.c
+ * Author:      Yang Yujun
+ * E-mail:      <yujiantianhu@163.com>
+ * Created on:  2024.07.28
+ *
+ * Copyright (c) 2024   Yang Yujun <yujiantianhu@163.com>
+ *
+ */
+
+/*!< The globals */
+#include <common/basic_types.h>
+#include <common/error_types.h>
+#include <common/generic.h>
+#include <common/io_stream.h>
+#include <common/api_string.h>
+#include <common/mem_manage.h>
+#include <common/time.h>
+#include <platform/fwk_basic.h>
+#include <platform/fwk_dma.h>
+#include <kernel/kernel.h>
+#include <kernel/sched.h>
+#include <kernel/thread.h>
+#include <kernel/sleep.h>
+#include <asm/mmu.h>
+
+#include "thread_table.h"
+
+/*!< The defines */
+#define LIBBENCHAPP_THREAD_STACK_SIZE                       REAL_THREAD_STACK_HALF(1)    /*!< 1/2 page (2kbytes) */
+
+/*!<
+ * every timed case handles LIBBENCHAPP_BYTES in total (calls = LIBBENCHAPP_BYTES / size),
+ * buffers have LIBBENCHAPP_BUF_SIZE bytes and a few more for the misaligned offsets; a pass runs every LIBBENCHAPP_PERIOD_MS
+ */
+#define LIBBENCHAPP_BUF_SIZE                                (4096)
+#define LIBBENCHAPP_BUF_WORDS                               ((LIBBENCHAPP_BUF_SIZE >> 2) + 4)
+#define LIBBENCHAPP_BYTES                                   (1024 * 1024)
+#define LIBBENCHAPP_PERIOD_MS                               (10000)
+
+/*!< random divisions checked per pass, and rounds over the buffers of operands when timed */
+#define LIBBENCHAPP_DIV_CHECKS                              (4096)
+#define LIBBENCHAPP_DIV_ROUNDS                              (64)
+
+/*!< random bitmaps checked per pass (at most LIBBENCHAPP_BITS long), and the lenth of the one timed */
+#define LIBBENCHAPP_BITMAP_CHECKS                           (256)
+#define LIBBENCHAPP_BITS                                    (1000)
+#define LIBBENCHAPP_BITS_TIMED                              (4096)
+
+/*!< run "code" for "loops" times, and get the time (us) spent */
+#define LIBBENCHAPP_TIMED(usecs, loops, code)   \
+do {    \
+    kuint32_t __start, __loop;  \
+    __start = get_time_stamp_usecs();   \
+    for (__loop = 0; __loop < (loops); __loop++)    \
+    {   \
+        code    \
+    }   \
+    usecs = get_time_stamp_elapsed(__start);    \
+} while (0)
+
+/*!< The globals */
+static real_thread_t g_lib_bench_app_tid;
+static struct real_thread_attr sgrt_lib_bench_app_attr;
+static kuint32_t g_lib_bench_app_stack[LIBBENCHAPP_THREAD_STACK_SIZE];
+
+/*!< kept out of the stack, and word aligned, so that the offsets below are the real alignment */
+static kuint32_t g_lib_bench_app_src[LIBBENCHAPP_BUF_WORDS];
+static kuint32_t g_lib_bench_app_dst[LIBBENCHAPP_BUF_WORDS];
+static kuint32_t g_lib_bench_app_ref[LIBBENCHAPP_BUF_WORDS];
+static kuint32_t g_lib_bench_app_seed = 1;
+
+/*!< around MEMORY_WORDS_THRESHOLD and MEMORY_NEON_THRESHOLD */
+static const kuint32_t g_lib_bench_app_sizes[] =
+{
+    0, 1, 3, 4, 7, 15, 16, 17, 31, 32, 63, 64, 65, 127, 255, 256, 257, 1023, 1024, 4001, LIBBENCHAPP_BUF_SIZE,
+};
+
+/*!< API functions */
+/*!
+ * @brief  pseudo random number
+ * @param  none
+ * @retval 16 bits
+ * @note   the same sequence on every boot, so that a failure can be reproduced
+ */
+static kuint32_t lib_bench_app_random(void)
+{
+    g_lib_bench_app_seed = g_lib_bench_app_seed * 1103515245U + 12345U;
+    return g_lib_bench_app_seed >> 16;
+}
+
+/*!
+ * @brief  fill a buffer with random bytes
+ * @param  buf, size
+ * @retval none
+ * @note   none
+ */
+static void lib_bench_app_fill(void *buf, kusize_t size)
+{
+    kuint8_t *ptr = (kuint8_t *)buf;
+
+    while (size--)
+        *(ptr++) = (kuint8_t)lib_bench_app_random();
+}
+
+/*!
+ * @brief  pseudo random 32 bits number
+ * @param  none
+ * @retval 32 bits, shifted right by a random count, so that the small numbers are also tried
+ * @note   none
+ */
+static kuint32_t lib_bench_app_random_word(void)
+{
+    kuint32_t number = (lib_bench_app_random() << 16) | lib_bench_app_random();
+
+    return number >> (lib_bench_app_random() & 31);
+}
+
+/*!
+ * @brief  fill a buffer with a random string
+ * @param  buf, lenth
+ * @retval none
+ * @note   "lenth" bytes from 1 to 255, and then '\0'
+ */
+static void lib_bench_app_fill_string(void *buf, kusize_t lenth)
+{
+    kuint8_t *ptr = (kuint8_t *)buf;
+
+    while (lenth--)
+        *(ptr++) = (kuint8_t)(lib_bench_app_random() % 255 + 1);
+
+    *ptr = '\0';
+}
+
+/*!< the references: byte by byte, as simple as possible */
+static void lib_bench_app_ref_set(void *dest, kuint8_t data, kusize_t size)
+{
+    kuint8_t *ptr = (kuint8_t *)dest;
+
+    while (size--)
+        *(ptr++) = data;
+}
+
+static void lib_bench_app_ref_copy(void *dest, const void *src, kusize_t size)
+{
+    kuint8_t *ptr = (kuint8_t *)dest;
+    const kuint8_t *ptr_src = (const kuint8_t *)src;
+
+    while (size--)
+        *(ptr++) = *(ptr_src++);
+}
+
+static kuint8_t lib_bench_app_ref_compare(const void *s1, const void *s2, kusize_t size)
+{
+    const kuint8_t *ptr1 = (const kuint8_t *)s1;
+    const kuint8_t *ptr2 = (const kuint8_t *)s2;
+
+    for (; size; size--)
+    {
+        if (*(ptr1++) != *(ptr2++))
+            return 1;
+    }
+
+    return 0;
+}
+
+static kusize_t lib_bench_app_ref_strlen(const kchar_t *str)
+{
+    kusize_t lenth = 0;
+
+    while (str[lenth])
+        lenth++;
+
+    return lenth;
+}
+
+static kint32_t lib_bench_app_ref_strncmp(const kchar_t *s1, const kchar_t *s2, kusize_t size)
+{
+    const kuint8_t *ptr1 = (const kuint8_t *)s1;
+    const kuint8_t *ptr2 = (const kuint8_t *)s2;
+
+    for (; size; size--, ptr1++, ptr2++)
+    {
+        if ((*ptr1 != *ptr2) || !(*ptr1))
+            return (kint32_t)*ptr1 - (kint32_t)*ptr2;
+    }
+
+    return 0;
+}
+
+static void *lib_bench_app_ref_memchr(const void *src, kchar_t ch, kusize_t size)
+{
+    const kuint8_t *ptr = (const kuint8_t *)src;
+
+    for (; size; size--, ptr++)
+    {
+        if (*ptr == (kuint8_t)ch)
+            return (void *)ptr;
+    }
+
+    return mrt_nullptr;
+}
+
+static kchar_t *lib_bench_app_ref_strchr(const kchar_t *str, kchar_t ch)
+{
+    return lib_bench_app_ref_memchr(str, ch, lib_bench_app_ref_strlen(str));
+}
+
+static kuint32_t lib_bench_app_ref_test_bit(const kuint32_t *bitmap, kuint32_t bit)
+{
+    return (bitmap[bit >> 5] >> (bit & 31)) & 1;
+}
+
+static kint32_t lib_bench_app_ref_find_next(const kuint32_t *bitmap, kusize_t total_bits, kuint32_t start, kuint32_t value)
+{
+    for (; start < total_bits; start++)
+    {
+        if (lib_bench_app_ref_test_bit(bitmap, start) == value)
+            return start;
+    }
+
+    return -1;
+}
+
+static void lib_bench_app_ref_update(kuint32_t *bitmap, kuint32_t start, kuint32_t nr, kuint32_t value)
+{
+    for (; nr; nr--, start++)
+    {
+        if (value)
+            bitmap[start >> 5] |= 1U << (start & 31);
+        else
+            bitmap[start >> 5] &= ~(1U << (start & 31));
+    }
+}
+
+static kuint32_t lib_bench_app_ref_weight(const kuint32_t *bitmap, kusize_t total_bits)
+{
+    kuint32_t bit, weight = 0;
+
+    for (bit = 0; bit < total_bits; bit++)
+        weight += lib_bench_app_ref_test_bit(bitmap, bit);
+
+    return weight;
+}
+
+static kint32_t lib_bench_app_ref_find_zero_area(const kuint32_t *bitmap, kusize_t total_bits, kuint32_t start, kuint32_t nr)
+{
+    kuint32_t bit, count = 0;
+
+    for (bit = start; bit < total_bits; bit++)
+    {
+        count = lib_bench_app_ref_test_bit(bitmap, bit) ? 0 : (count + 1);
+        if (count == nr)
+            return bit + 1 - nr;
+    }
+
+    return -1;
+}
+
+/*!
+ * @brief  print a timed case
+ * @param  name, size, loops, usecs, ref_usecs
+ * @retval none
+ * @note   ns per call, for the library and for the reference
+ */
+static void lib_bench_app_report(const kchar_t *name, kuint32_t size, kuint32_t loops, kuint32_t usecs, kuint32_t ref_usecs)
+{
+    print_info("    %s (%d bytes): %d ns per call, reference %d ns\n",
+                name, size, usecs * 1000 / loops, ref_usecs * 1000 / loops);
+}
+
+/*!
+ * @brief  check memory_set/copy/compare
+ * @param  none
+ * @retval number of wrong results
+ * @note   every size with every alignment of source and destination;
+ *         the whole buffer is compared, so that a write out of range is also found
+ */
+static kuint32_t lib_bench_app_check_memops(void)
+{
+    kuint8_t *src = (kuint8_t *)g_lib_bench_app_src;
+    kuint8_t *dst = (kuint8_t *)g_lib_bench_app_dst;
+    kuint8_t *ref = (kuint8_t *)g_lib_bench_app_ref;
+    kuint32_t i, size, soff, doff, errors = 0;
+    kuint8_t data;
+
+    for (i = 0; i < ARRAY_SIZE(g_lib_bench_app_sizes); i++)
+    {
+        size = g_lib_bench_app_sizes[i];
+
+        for (soff = 0; soff < 4; soff++)
+        {
+            for (doff = 0; doff < 4; doff++)
+            {
+                lib_bench_app_fill(src, sizeof(g_lib_bench_app_src));
+                lib_bench_app_fill(dst, sizeof(g_lib_bench_app_dst));
+                lib_bench_app_ref_copy(ref, dst, sizeof(g_lib_bench_app_ref));
+
+                memory_copy(dst + doff, src + soff, size);
+                lib_bench_app_ref_copy(ref + doff, src + soff, size);
+                errors += lib_bench_app_ref_compare(dst, ref, sizeof(g_lib_bench_app_dst));
+
+                /*!< equal, and then one byte changed */
+                errors += !!memory_compare(dst + doff, src + soff, size);
+                if (size)
+                {
+                    dst[doff + lib_bench_app_random() % size] ^= 0x5a;
+                    errors += !memory_compare(dst + doff, src + soff, size);
+                }
+
+                data = (kuint8_t)lib_bench_app_random();
+                lib_bench_app_ref_copy(ref, dst, sizeof(g_lib_bench_app_ref));
+                memory_set(dst + doff, data, size);
+                lib_bench_app_ref_set(ref + doff, data, size);
+                errors += lib_bench_app_ref_compare(dst, ref, sizeof(g_lib_bench_app_dst));
+            }
+        }
+    }
+
+    return errors;
+}
+
+/*!
+ * @brief  time memory_set/copy/compare
+ * @param  none
+ * @retval none
+ * @note   aligned: the word or NEON path; misaligned: source and destination differ in alignment,
+ *         which falls back to bytes
+ */
+static void lib_bench_app_time_memops(void)
+{
+    kuint8_t *src = (kuint8_t *)g_lib_bench_app_src;
+    kuint8_t *dst = (kuint8_t *)g_lib_bench_app_dst;
+    kuint32_t sizes[] = { 8, 64, 1024, LIBBENCHAPP_BUF_SIZE };
+    kuint32_t i, size, loops, usecs, ref_usecs;
+
+    lib_bench_app_fill(src, sizeof(g_lib_bench_app_src));
+    lib_bench_app_ref_copy(dst, src, sizeof(g_lib_bench_app_dst));
+
+    for (i = 0; i < ARRAY_SIZE(sizes); i++)
+    {
+        size = sizes[i];
+        loops = LIBBENCHAPP_BYTES / size;
+
+        LIBBENCHAPP_TIMED(usecs, loops, memory_set(dst, 0x5a, size););
+        LIBBENCHAPP_TIMED(ref_usecs, loops, lib_bench_app_ref_set(dst, 0x5a, size););
+        lib_bench_app_report("memory_set", size, loops, usecs, ref_usecs);
+
+        LIBBENCHAPP_TIMED(usecs, loops, memory_copy(dst, src, size););
+        LIBBENCHAPP_TIMED(ref_usecs, loops, lib_bench_app_ref_copy(dst, src, size););
+        lib_bench_app_report("memory_copy, aligned", size, loops, usecs, ref_usecs);
+
+        LIBBENCHAPP_TIMED(usecs, loops, memory_copy(dst, src + 1, size););
+        LIBBENCHAPP_TIMED(ref_usecs, loops, lib_bench_app_ref_copy(dst, src + 1, size););
+        lib_bench_app_report("memory_copy, misaligned", size, loops, usecs, ref_usecs);
+
+        /*!< equal buffers, so that the whole size is compared */
+        LIBBENCHAPP_TIMED(usecs, loops, memory_compare(dst, src, size););
+        LIBBENCHAPP_TIMED(ref_usecs, loops, lib_bench_app_ref_compare(dst, src, size););
+        lib_bench_app_report("memory_compare", size, loops, usecs, ref_usecs);
+    }
+}
+
+/*!
+ * @brief  check kstrlen/kstrchr/kmemchr/kstrcmp/kstrncmp/kstrlcpy
+ * @param  none
+ * @retval number of wrong results
+ * @note   every lenth at every alignment; the strings to compare may differ in alignment,
+ *         which is the byte path, and differ at a random position
+ */
+static kuint32_t lib_bench_app_check_strings(void)
+{
+    kchar_t *src = (kchar_t *)g_lib_bench_app_src;
+    kchar_t *dst = (kchar_t *)g_lib_bench_app_dst;
+    kchar_t *ref = (kchar_t *)g_lib_bench_app_ref;
+    kchar_t *str, *cmp, ch;
+    kuint32_t i, lenth, soff, doff, pos, errors = 0;
+    kusize_t limits[4];
+
+    for (i = 0; i < ARRAY_SIZE(g_lib_bench_app_sizes); i++)
+    {
+        lenth = g_lib_bench_app_sizes[i];
+
+        for (soff = 0; soff < 4; soff++)
+        {
+            for (doff = 0; doff < 4; doff++)
+            {
+                lib_bench_app_fill(src, sizeof(g_lib_bench_app_src));
+                str = src + soff;
+                lib_bench_app_fill_string(str, lenth);
+
+                errors += (kstrlen(str) != lenth);
+
+                /*!< a character of the string, and one which may not be in it */
+                ch = lenth ? str[lib_bench_app_random() % lenth] : 'a';
+                errors += (kstrchr(str, ch) != lib_bench_app_ref_strchr(str, ch));
+                errors += (kmemchr(str, ch, lenth) != lib_bench_app_ref_memchr(str, ch, lenth));
+                ch = (kchar_t)(lib_bench_app_random() % 255 + 1);
+                errors += (kstrchr(str, ch) != lib_bench_app_ref_strchr(str, ch));
+                errors += (kmemchr(src, ch, sizeof(g_lib_bench_app_src)) != 
+                            lib_bench_app_ref_memchr(src, ch, sizeof(g_lib_bench_app_src)));
+
+                /*!< equal, then one byte changed, then cut short */
+                cmp = dst + doff;
+                lib_bench_app_ref_copy(cmp, str, lenth + 1);
+                errors += !!kstrcmp(cmp, str);
+                errors += !!kstrncmp(cmp, str, lenth + 1);
+
+                if (lenth)
+                {
+                    pos = lib_bench_app_random() % lenth;
+                    cmp[pos] = (kchar_t)(lib_bench_app_random() % 255 + 1);
+                    errors += (kstrcmp(cmp, str) != lib_bench_app_ref_strncmp(cmp, str, ~0U));
+                    errors += !!kstrncmp(cmp, str, pos);
+                    errors += (kstrncmp(cmp, str, pos + 1) != lib_bench_app_ref_strncmp(cmp, str, pos + 1));
+
+                    cmp[pos] = '\0';
+                    errors += (kstrcmp(cmp, str) != lib_bench_app_ref_strncmp(cmp, str, ~0U));
+                    errors += (kstrcmp(str, cmp) != lib_bench_app_ref_strncmp(str, cmp, ~0U));
+                }
+
+                /*!< kstrlcpy: none, cut short, just fit, and more room than needed */
+                limits[0] = 0;
+                limits[1] = lenth >> 1;
+                limits[2] = lenth + 1;
+                limits[3] = lenth + 8;
+
+                for (pos = 0; pos < ARRAY_SIZE(limits); pos++)
+                {
+                    lib_bench_app_fill(dst, sizeof(g_lib_bench_app_dst));
+                    lib_bench_app_ref_copy(ref, dst, sizeof(g_lib_bench_app_ref));
+
+                    errors += (kstrlcpy(dst + doff, str, limits[pos]) != lenth);
+                    if (limits[pos])
+                    {
+                        lib_bench_app_ref_copy(ref + doff, str, mrt_ret_min2(limits[pos] - 1, (kusize_t)lenth));
+                        ref[doff + mrt_ret_min2(limits[pos] - 1, (kusize_t)lenth)] = '\0';
+                    }
+
+                    errors += lib_bench_app_ref_compare(dst, ref, sizeof(g_lib_bench_app_dst));
+                }
+            }
+        }
+    }
+
+    return errors;
+}
+
+/*!
+ * @brief  time kstrlen/kstrchr/kmemchr/kstrcmp/kstrlcpy
+ * @param  none
+ * @retval none
+ * @note   the whole string is always walked: kstrchr and kmemchr look for a character which is not in it,
+ *         and kstrcmp compares two equal strings at the same alignment
+ */
+static void lib_bench_app_time_strings(void)
+{
+    kchar_t *src = (kchar_t *)g_lib_bench_app_src;
+    kchar_t *dst = (kchar_t *)g_lib_bench_app_dst;
+    kuint32_t sizes[] = { 8, 64, 1024 };
+    kuint32_t i, lenth, loops, usecs, ref_usecs;
+    kchar_t *str;
+
+    for (i = 0; i < ARRAY_SIZE(sizes); i++)
+    {
+        lenth = sizes[i];
+        loops = LIBBENCHAPP_BYTES / lenth;
+
+        /*!< no 'a' in the string, so that it is not found */
+        for (str = src, lib_bench_app_fill_string(str, lenth); *str; str++)
+        {
+            if ('a' == *str)
+                *str = 'b';
+        }
+        lib_bench_app_ref_copy(dst, src, lenth + 1);
+
+        LIBBENCHAPP_TIMED(usecs, loops, kstrlen(src););
+        LIBBENCHAPP_TIMED(ref_usecs, loops, lib_bench_app_ref_strlen(src););
+        lib_bench_app_report("kstrlen", lenth, loops, usecs, ref_usecs);
+
+        LIBBENCHAPP_TIMED(usecs, loops, kstrchr(src, 'a'););
+        LIBBENCHAPP_TIMED(ref_usecs, loops, lib_bench_app_ref_strchr(src, 'a'););
+        lib_bench_app_report("kstrchr", lenth, loops, usecs, ref_usecs);
+
+        LIBBENCHAPP_TIMED(usecs, loops, kmemchr(src, 'a', lenth););
+        LIBBENCHAPP_TIMED(ref_usecs, loops, lib_bench_app_ref_memchr(src, 'a', lenth););
+        lib_bench_app_report("kmemchr", lenth, loops, usecs, ref_usecs);
+
+        LIBBENCHAPP_TIMED(usecs, loops, kstrcmp(dst, src););
+        LIBBENCHAPP_TIMED(ref_usecs, loops, lib_bench_app_ref_strncmp(dst, src, ~0U););
+        lib_bench_app_report("kstrcmp", lenth, loops, usecs, ref_usecs);
+
+        LIBBENCHAPP_TIMED(usecs, loops, kstrlcpy(dst, src, lenth + 1););
+        LIBBENCHAPP_TIMED(ref_usecs, loops, lib_bench_app_ref_copy(dst, src, lib_bench_app_ref_strlen(src) + 1););
+        lib_bench_app_report("kstrlcpy", lenth, loops, usecs, ref_usecs);
+    }
+}
+
+/*!
+ * @brief  check udiv_integer/sdiv_integer/udiv_remainder/udiv_by_10/udiv_by_1000
+ * @param  none
+ * @retval number of wrong results
+ * @note   against the "/" and "%" of the compiler; divisors are random, powers of 2, and 0
+ *         (which gives 0, and the dividend as the remainder)
+ */
+static kuint32_t lib_bench_app_check_divisions(void)
+{
+    const kuint32_t edges[] = { 0, 1, 9, 10, 999, 1000, 1001, 0x7fffffff, 0x80000000, 0xfffffff9, 0xffffffff };
+    kuint32_t i, dividend, divisor, errors = 0;
+    kint32_t sdividend, sdivisor;
+
+    for (i = 0; i < LIBBENCHAPP_DIV_CHECKS + ARRAY_SIZE(edges); i++)
+    {
+        dividend = (i < ARRAY_SIZE(edges)) ? edges[i] : lib_bench_app_random_word();
+
+        errors += (udiv_by_10(dividend) != dividend / 10);
+        errors += (udiv_by_1000(dividend) != dividend / 1000);
+
+        switch (i & 3)
+        {
+            case 0:
+                divisor = 1U << (lib_bench_app_random() & 31);
+                break;
+
+            case 1:
+                divisor = 0;
+                break;
+
+            default:
+                divisor = lib_bench_app_random_word();
+                break;
+        }
+
+        if (!divisor)
+        {
+            errors += (udiv_integer(dividend, divisor) != 0);
+            errors += (udiv_remainder(dividend, divisor) != dividend);
+            errors += (sdiv_integer((kint32_t)dividend, 0) != 0);
+            continue;
+        }
+
+        errors += (udiv_integer(dividend, divisor) != dividend / divisor);
+        errors += (udiv_remainder(dividend, divisor) != dividend % divisor);
+
+        /*!< the minimum divided by -1 can not be represented */
+        sdividend = (lib_bench_app_random() & 1) ? -(kint32_t)(dividend >> 1) : (kint32_t)(dividend >> 1);
+        sdivisor = (lib_bench_app_random() & 1) ? -(kint32_t)(divisor >> 1) : (kint32_t)(divisor >> 1);
+        if (sdivisor)
+            errors += (sdiv_integer(sdividend, sdivisor) != sdividend / sdivisor);
+    }
+
+    return errors;
+}
+
+/*!
+ * @brief  time udiv_integer/sdiv_integer/udiv_remainder, and the divisions by constant
+ * @param  none
+ * @retval none
+ * @note   the buffers are filled with random dividends and divisors (at least 2 bits set, so neither 0 nor a power of 2);
+ *         the references are the "/" and "%" of the compiler, with the divisor not known at compile time
+ */
+static void lib_bench_app_time_divisions(void)
+{
+    kuint32_t *dividends = g_lib_bench_app_src;
+    kuint32_t *divisors = g_lib_bench_app_dst;
+    kuint32_t calls = LIBBENCHAPP_DIV_ROUNDS * LIBBENCHAPP_BUF_WORDS;
+    kuint32_t idx, usecs, ref_usecs, div, sum = 0;
+
+    for (idx = 0; idx < LIBBENCHAPP_BUF_WORDS; idx++)
+    {
+        dividends[idx] = (lib_bench_app_random() << 16) | lib_bench_app_random();
+        divisors[idx] = lib_bench_app_random_word() | 3;
+    }
+
+    LIBBENCHAPP_TIMED(usecs, LIBBENCHAPP_DIV_ROUNDS,
+        for (idx = 0; idx < LIBBENCHAPP_BUF_WORDS; idx++)
+            sum += udiv_integer(dividends[idx], divisors[idx]););
+    LIBBENCHAPP_TIMED(ref_usecs, LIBBENCHAPP_DIV_ROUNDS,
+        for (idx = 0; idx < LIBBENCHAPP_BUF_WORDS; idx++)
+            sum += dividends[idx] / divisors[idx];);
+    print_info("    udiv_integer: %d ns per call, reference %d ns\n", usecs * 1000 / calls, ref_usecs * 1000 / calls);
+
+    LIBBENCHAPP_TIMED(usecs, LIBBENCHAPP_DIV_ROUNDS,
+        for (idx = 0; idx < LIBBENCHAPP_BUF_WORDS; idx++)
+            sum += udiv_remainder(dividends[idx], divisors[idx]););
+    LIBBENCHAPP_TIMED(ref_usecs, LIBBENCHAPP_DIV_ROUNDS,
+        for (idx = 0; idx < LIBBENCHAPP_BUF_WORDS; idx++)
+            sum += dividends[idx] % divisors[idx];);
+    print_info("    udiv_remainder: %d ns per call, reference %d ns\n", usecs * 1000 / calls, ref_usecs * 1000 / calls);
+
+    LIBBENCHAPP_TIMED(usecs, LIBBENCHAPP_DIV_ROUNDS,
+        for (idx = 0; idx < LIBBENCHAPP_BUF_WORDS; idx++)
+            sum += sdiv_integer((kint32_t)dividends[idx], -(kint32_t)divisors[idx]););
+    LIBBENCHAPP_TIMED(ref_usecs, LIBBENCHAPP_DIV_ROUNDS,
+        for (idx = 0; idx < LIBBENCHAPP_BUF_WORDS; idx++)
+            sum += (kint32_t)dividends[idx] / -(kint32_t)divisors[idx];);
+    print_info("    sdiv_integer: %d ns per call, reference %d ns\n", usecs * 1000 / calls, ref_usecs * 1000 / calls);
+
+    /*!< read back from memory, so that the compiler can not use a constant */
+    divisors[0] = 10;
+    div = divisors[0];
+    LIBBENCHAPP_TIMED(usecs, LIBBENCHAPP_DIV_ROUNDS,
+        for (idx = 0; idx < LIBBENCHAPP_BUF_WORDS; idx++)
+            sum += udiv_by_10(dividends[idx]););
+    LIBBENCHAPP_TIMED(ref_usecs, LIBBENCHAPP_DIV_ROUNDS,
+        for (idx = 0; idx < LIBBENCHAPP_BUF_WORDS; idx++)
+            sum += dividends[idx] / div;);
+    print_info("    udiv_by_10: %d ns per call, reference %d ns\n", usecs * 1000 / calls, ref_usecs * 1000 / calls);
+
+    divisors[0] = 1000;
+    div = divisors[0];
+    LIBBENCHAPP_TIMED(usecs, LIBBENCHAPP_DIV_ROUNDS,
+        for (idx = 0; idx < LIBBENCHAPP_BUF_WORDS; idx++)
+            sum += udiv_by_1000(dividends[idx]););
+    LIBBENCHAPP_TIMED(ref_usecs, LIBBENCHAPP_DIV_ROUNDS,
+        for (idx = 0; idx < LIBBENCHAPP_BUF_WORDS; idx++)
+            sum += dividends[idx] / div;);
+    print_info("    udiv_by_1000: %d ns per call, reference %d ns\n", usecs * 1000 / calls, ref_usecs * 1000 / calls);
+
+    /*!< keep the results in use */
+    dividends[0] = sum;
+}
+
+/*!
+ * @brief  check find_next_bit/find_next_zero_bit/bitmap_set/bitmap_clear/bitmap_weight/bitmap_find_next_zero_area
+ * @param  none
+ * @retval number of wrong results
+ * @note   random bitmaps (sparse, even or dense) of random lenth, the bits after the lenth are random too,
+ *         and must be ignored; they only depend on the arguments, nothing of the board is used
+ */
+static kuint32_t lib_bench_app_check_bitmap(void)
+{
+    kuint32_t *bitmap = g_lib_bench_app_src;
+    kuint32_t *ref = g_lib_bench_app_ref;
+    kuint32_t words = mrt_bitmap_words(LIBBENCHAPP_BITS);
+    kuint32_t i, idx, total, start, nr, errors = 0;
+
+    for (i = 0; i < LIBBENCHAPP_BITMAP_CHECKS; i++)
+    {
+        for (idx = 0; idx < words; idx++)
+        {
+            bitmap[idx] = (lib_bench_app_random() << 16) | lib_bench_app_random();
+
+            if ((i % 3) == 1)
+                bitmap[idx] &= (lib_bench_app_random() << 16) | lib_bench_app_random();
+            else if ((i % 3) == 2)
+                bitmap[idx] |= (lib_bench_app_random() << 16) | lib_bench_app_random();
+
+            /*!< whole empty or full words, so that the searches cross words */
+            if (!(lib_bench_app_random() & 7))
+                bitmap[idx] = (i & 1) ? ~0U : 0;
+        }
+
+        /*!< from a few bits to all, sometimes exactly a number of words */
+        total = (i & 7) ? (lib_bench_app_random() % LIBBENCHAPP_BITS + 1) : ((lib_bench_app_random() % words + 1) << 5);
+        total = mrt_ret_min2(total, (kuint32_t)LIBBENCHAPP_BITS);
+
+        errors += (bitmap_weight(bitmap, total) != lib_bench_app_ref_weight(bitmap, total));
+
+        for (idx = 0; idx < 16; idx++)
+        {
+            start = lib_bench_app_random() % (total + 40);
+            errors += (find_next_bit(bitmap, total, start) != lib_bench_app_ref_find_next(bitmap, total, start, 1));
+            errors += (find_next_zero_bit(bitmap, total, start) != lib_bench_app_ref_find_next(bitmap, total, start, 0));
+
+            nr = lib_bench_app_random() % 40 + 1;
+            errors += (bitmap_find_next_zero_area(bitmap, total, start, nr) !=
+                        lib_bench_app_ref_find_zero_area(bitmap, total, start, nr));
+        }
+
+        /*!< the whole array is compared, so that a bit changed out of range is also found */
+        start = lib_bench_app_random() % total;
+        nr = lib_bench_app_random() % (total - start + 1);
+
+        lib_bench_app_ref_copy(ref, bitmap, words << 2);
+        bitmap_set(bitmap, start, nr);
+        lib_bench_app_ref_update(ref, start, nr, 1);
+        errors += lib_bench_app_ref_compare(bitmap, ref, words << 2);
+
+        start = lib_bench_app_random() % total;
+        nr = lib_bench_app_random() % (total - start + 1);
+
+        bitmap_clear(bitmap, start, nr);
+        lib_bench_app_ref_update(ref, start, nr, 0);
+        errors += lib_bench_app_ref_compare(bitmap, ref, words << 2);
+    }
+
+    return errors;
+}
+
+/*!
+ * @brief  time the bitmap helpers
+ * @param  none
+ * @retval none
+ * @note   the worst case of searching: a bitmap of LIBBENCHAPP_BITS_TIMED bits with only the last one set,
+ *         and the free area at the end, so that the whole bitmap is walked
+ */
+static void lib_bench_app_time_bitmap(void)
+{
+    kuint32_t *bitmap = g_lib_bench_app_src;
+    kuint32_t *full = g_lib_bench_app_dst;
+    kuint32_t words = mrt_bitmap_words(LIBBENCHAPP_BITS_TIMED);
+    kuint32_t loops = LIBBENCHAPP_BYTES / (words << 2);
+    kuint32_t usecs, ref_usecs;
+
+    memory_reset(bitmap, words << 2);
+    bitmap_set(bitmap, LIBBENCHAPP_BITS_TIMED - 1, 1);
+
+    /*!< every other bit, with 64 free bits at the end */
+    memory_set(full, 0x55, words << 2);
+    bitmap_clear(full, LIBBENCHAPP_BITS_TIMED - 64, 64);
+
+    LIBBENCHAPP_TIMED(usecs, loops, find_next_bit(bitmap, LIBBENCHAPP_BITS_TIMED, 0););
+    LIBBENCHAPP_TIMED(ref_usecs, loops, lib_bench_app_ref_find_next(bitmap, LIBBENCHAPP_BITS_TIMED, 0, 1););
+    lib_bench_app_report("find_next_bit", words << 2, loops, usecs, ref_usecs);
+
+    LIBBENCHAPP_TIMED(usecs, loops, bitmap_weight(full, LIBBENCHAPP_BITS_TIMED););
+    LIBBENCHAPP_TIMED(ref_usecs, loops, lib_bench_app_ref_weight(full, LIBBENCHAPP_BITS_TIMED););
+    lib_bench_app_report("bitmap_weight", words << 2, loops, usecs, ref_usecs);
+
+    LIBBENCHAPP_TIMED(usecs, loops, bitmap_find_next_zero_area(full, LIBBENCHAPP_BITS_TIMED, 0, 32););
+    LIBBENCHAPP_TIMED(ref_usecs, loops, lib_bench_app_ref_find_zero_area(full, LIBBENCHAPP_BITS_TIMED, 0, 32););
+    lib_bench_app_report("bitmap_find_next_zero_area", words << 2, loops, usecs, ref_usecs);
+}
+
+/*!
+ * @brief  check the section attributes and fwk_io_remap
+ * @param  uncached: a buffer of the DMA coherent pool
+ * @retval number of wrong results
+ * @note   DDR must be write-back, the DMA pool non-cacheable, and a peripheral device memory;
+ *         a DDR address is remapped to the ioremap window, with its offset in the section kept,
+ *         and the section is shared (it is not accessed, it would alias the cacheable mapping)
+ */
+static kuint32_t lib_bench_app_check_mmu(void *uncached)
+{
+    kuaddr_t cached = (kuaddr_t)g_lib_bench_app_src;
+    kuaddr_t periph = (kuaddr_t)ptr_systick_counter;
+    kuint32_t mask = MMU_SECT_TEX(7) | MMU_SECT_C | MMU_SECT_B;
+    void *virt1, *virt2;
+    kuint32_t errors = 0;
+
+    virt1 = fwk_io_remap((void *)periph);
+    errors += (virt1 != (void *)periph);
+    fwk_io_unmap(virt1);
+
+    if (!mmu_is_enabled())
+        return errors;
+
+    errors += ((mmu_get_section(cached) & mask) != (MMU_SECT_NORMAL & mask));
+    errors += ((mmu_get_section((kuaddr_t)uncached) & mask) != (MMU_SECT_NORMAL_NC & mask));
+    errors += ((mmu_get_section(periph) & mask) != (MMU_SECT_DEVICE & mask));
+
+    /*!< the two words are in the same section */
+    cached &= ~(kuaddr_t)0x7;
+    virt1 = fwk_io_remap((void *)cached);
+    virt2 = fwk_io_remap((void *)(cached + 4));
+
+    if (!isValid(virt1) || !isValid(virt2))
+        errors++;
+    else
+    {
+        errors += (virt1 == (void *)cached);
+        errors += (((kuaddr_t)virt1 ^ cached) & (MMU_SECTION_SIZE - 1)) != 0;
+        errors += ((kuaddr_t)virt2 != (kuaddr_t)virt1 + 4);
+        errors += ((mmu_get_section((kuaddr_t)virt1) & mask) != (MMU_SECT_DEVICE & mask));
+    }
+
+    fwk_io_unmap(virt2);
+    fwk_io_unmap(virt1);
+
+    return errors;
+}
+
+/*!
+ * @brief  time reading, writing and copying a buffer
+ * @param  name, buf, src: a cacheable buffer to copy from
+ * @retval none
+ * @note   MB/s (= bytes per us)
+ */
+static void lib_bench_app_time_memory(const kchar_t *name, void *buf, void *src)
+{
+    volatile kuint32_t *ptr = (volatile kuint32_t *)buf;
+    kuint32_t loops = LIBBENCHAPP_BYTES / LIBBENCHAPP_BUF_SIZE;
+    kuint32_t idx, read_us, write_us, copy_us, sum = 0;
+
+    LIBBENCHAPP_TIMED(read_us, loops,
+        for (idx = 0; idx < (LIBBENCHAPP_BUF_SIZE >> 2); idx++)
+            sum += ptr[idx];);
+    LIBBENCHAPP_TIMED(write_us, loops, memory_set(buf, (kuint8_t)sum, LIBBENCHAPP_BUF_SIZE););
+    LIBBENCHAPP_TIMED(copy_us, loops, memory_copy(buf, src, LIBBENCHAPP_BUF_SIZE););
+
+    print_info("    %s: read %d MB/s, write %d MB/s, copy %d MB/s\n", name,
+                LIBBENCHAPP_BYTES / mrt_ret_max2(read_us, 1U), LIBBENCHAPP_BYTES / mrt_ret_max2(write_us, 1U),
+                LIBBENCHAPP_BYTES / mrt_ret_max2(copy_us, 1U));
+}
+
+/*!
+ * @brief  check the mapping, and compare cacheable DDR with the non-cacheable DMA pool
+ * @param  none
+ * @retval none
+ * @note   both are DDR, the difference is made by the caches only
+ */
+static void lib_bench_app_run_mmu(void)
+{
+    void *uncached;
+    dma_addr_t handle;
+    kuint32_t errors;
+
+    print_info("%s: caches, %d bytes per case, mmu %s\n", __FUNCTION__, LIBBENCHAPP_BYTES,
+                mmu_is_enabled() ? "on" : "off");
+
+    uncached = fwk_dma_alloc_coherent(mrt_nullptr, LIBBENCHAPP_BUF_SIZE, &handle, NR_KMEM_ZERO);
+    if (!isValid(uncached))
+    {
+        print_err("%s: no dma coherent memory\n", __FUNCTION__);
+        return;
+    }
+
+    errors = lib_bench_app_check_mmu(uncached);
+    if (errors)
+        print_err("%s: mmu: %d wrong results\n", __FUNCTION__, errors);
+    else
+    {
+        lib_bench_app_fill(g_lib_bench_app_src, sizeof(g_lib_bench_app_src));
+        lib_bench_app_time_memory("cacheable", g_lib_bench_app_dst, g_lib_bench_app_src);
+        lib_bench_app_time_memory("non-cacheable", uncached, g_lib_bench_app_src);
+    }
+
+    fwk_dma_free_coherent(mrt_nullptr, LIBBENCHAPP_BUF_SIZE, uncached, handle);
+}
+
+/*!
+ * @brief  run one pass
+ * @param  none
+ * @retval none
+ * @note   the results are checked first, the timing is not printed for a wrong case
+ */
+static void lib_bench_app_run(void)
+{
+    kuint32_t errors;
+
+    print_info("%s: memory operations, %d bytes per case\n", __FUNCTION__, LIBBENCHAPP_BYTES);
+
+    errors = lib_bench_app_check_memops();
+    if (errors)
+        print_err("%s: memory operations: %d wrong results\n", __FUNCTION__, errors);
+    else
+        lib_bench_app_time_memops();
+
+    print_info("%s: strings, %d bytes per case\n", __FUNCTION__, LIBBENCHAPP_BYTES);
+
+    errors = lib_bench_app_check_strings();
+    if (errors)
+        print_err("%s: strings: %d wrong results\n", __FUNCTION__, errors);
+    else
+        lib_bench_app_time_strings();
+
+    print_info("%s: divisions, %d calls per case\n", __FUNCTION__, LIBBENCHAPP_DIV_ROUNDS * LIBBENCHAPP_BUF_WORDS);
+
+    errors = lib_bench_app_check_divisions();
+    if (errors)
+        print_err("%s: divisions: %d wrong results\n", __FUNCTION__, errors);
+    else
+        lib_bench_app_time_divisions();
+
+    print_info("%s: bitmaps, %d bytes per case\n", __FUNCTION__, LIBBENCHAPP_BYTES);
+
+    errors = lib_bench_app_check_bitmap();
+    if (errors)
+        print_err("%s: bitmaps: %d wrong results\n", __FUNCTION__, errors);
+    else
+        lib_bench_app_time_bitmap();
+
+    lib_bench_app_run_mmu();
+}
+
+/*!
+ * @brief  library benchmark task
+ * @param  none
+ * @retval none
+ * @note   none
+ */
+static void *lib_bench_app_entry(void *args)
+{
+    while (!ptr_systick_counter)
+        schedule_delay_ms(200);
+
+    for (;;)
+    {
+        lib_bench_app_run();
+        schedule_delay_ms(LIBBENCHAPP_PERIOD_MS);
+    }
+
+    return args;
+}
+
+/*!
+ * @brief	create library benchmark task
+ * @param  	none
+ * @retval 	error code
+ * @note   	none
+ */
+kint32_t lib_bench_app_init(void)
+{
+    struct real_thread_attr *sprt_attr = &sgrt_lib_bench_app_attr;
+    kint32_t retval;
+
+	sprt_attr->detachstate = REAL_THREAD_CREATE_JOINABLE;
+	sprt_attr->inheritsched	= REAL_THREAD_INHERIT_SCHED;
+	sprt_attr->schedpolicy = REAL_THREAD_SCHED_FIFO;
+
+    /*!< thread stack */
+	real_thread_set_stack(sprt_attr, mrt_nullptr, g_lib_bench_app_stack, sizeof(g_lib_bench_app_stack));
+    /*!< lowest priority */
+	real_thread_set_priority(sprt_attr, REAL_THREAD_PROTY_DEFAULT);
+    /*!< default time slice */
+    real_thread_set_time_slice(sprt_attr, REAL_THREAD_TIME_DEFUALT);
+
+    /*!< register thread */
+    retval = real_thread_create(&g_lib_bench_app_tid, sprt_attr, lib_bench_app_entry, mrt_nullptr);
+    return (retval < 0) ? retval : 0;
+}
+
+/*!< end of file */
@@ -0,0 +1,220 @@
+/*
+ * User Thread Instance (path lookup task) Interface
+ *
+ * File Name:   path_lookup_app.c
+ * Author:      Yang Yujun
+ * E-mail:      <yujiantianhu@163.com>
+ * Created on:  2024.07.28
+ *
+ * Copyright (c) 2024   Yang Yujun <yujiantianhu@163.com>
+ *
+ */
+
+/*!< The globals */
+#include <common/basic_types.h>
+#include <common/error_types.h>
+#include <common/generic.h>
+#include <common/io_stream.h>
+#include <common/api_string.h>
+#include <common/time.h>
+#include <platform/fwk_kobj.h>
+#include <platform/fwk_inode.h>
+#include <kernel/kernel.h>
+#include <kernel/sched.h>
+#include <kernel/thread.h>
+#include <kernel/sleep.h>
+
+#include "thread_table.h"
+
+/*!< The defines */
+#define PATHLOOKUPAPP_THREAD_STACK_SIZE                     REAL_THREAD_STACK_HALF(1)    /*!< 1/2 page (2kbytes) */
+
+/*!<
+ * a wide directory of PATHLOOKUPAPP_WIDE files, and a chain of PATHLOOKUPAPP_DEPTH directories;
+ * every case runs PATHLOOKUPAPP_LOOPS lookups, and a pass runs every PATHLOOKUPAPP_PERIOD_MS
+ */
+#define PATHLOOKUPAPP_ROOT                                  FWK_PATH_SYSTEM "lookup_bench/"
+#define PATHLOOKUPAPP_WIDE                                  (256)
+#define PATHLOOKUPAPP_DEPTH                                 (16)
+#define PATHLOOKUPAPP_LOOPS                                 (4096)
+#define PATHLOOKUPAPP_PERIOD_MS                             (10000)
+#define PATHLOOKUPAPP_PATH_MAX                              (160)
+
+/*!< The globals */
+static real_thread_t g_path_lookup_app_tid;
+static struct real_thread_attr sgrt_path_lookup_app_attr;
+static kuint32_t g_path_lookup_app_stack[PATHLOOKUPAPP_THREAD_STACK_SIZE];
+
+/*!< the names end with '_', so that none of them starts with another one */
+static kchar_t g_path_lookup_app_wide[PATHLOOKUPAPP_WIDE][32];
+static struct fwk_kobject *sprt_path_lookup_app_wide[PATHLOOKUPAPP_WIDE];
+static kchar_t g_path_lookup_app_deep[PATHLOOKUPAPP_PATH_MAX];
+static struct fwk_kobject *sprt_path_lookup_app_deep;
+
+/*!< API functions */
+/*!
+ * @brief  create the tree
+ * @param  none
+ * @retval error code
+ * @note   it is kept, the passes only look it up
+ */
+static kint32_t path_lookup_app_build(void)
+{
+    struct fwk_kobject *sprt_kobj;
+    kchar_t *ptr;
+    kuint32_t i;
+
+    for (i = 0; i < PATHLOOKUPAPP_WIDE; i++)
+    {
+        sprintk(g_path_lookup_app_wide[i], PATHLOOKUPAPP_ROOT "wide/f%d_", i);
+
+        sprt_kobj = fwk_kobject_populate(mrt_nullptr, g_path_lookup_app_wide[i]);
+        if (!isValid(sprt_kobj))
+            return -ER_FAILD;
+
+        sprt_path_lookup_app_wide[i] = sprt_kobj;
+    }
+
+    ptr = g_path_lookup_app_deep;
+    ptr += sprintk(ptr, PATHLOOKUPAPP_ROOT "deep/");
+
+    for (i = 0; i < PATHLOOKUPAPP_DEPTH; i++)
+        ptr += sprintk(ptr, "d%d_/", i);
+
+    sprintk(ptr, "leaf");
+
+    sprt_kobj = fwk_kobject_populate(mrt_nullptr, g_path_lookup_app_deep);
+    if (!isValid(sprt_kobj))
+        return -ER_FAILD;
+
+    sprt_path_lookup_app_deep = sprt_kobj;
+
+    return ER_NORMAL;
+}
+
+/*!
+ * @brief  print a case
+ * @param  name, usecs, errors
+ * @retval none
+ * @note   none
+ */
+static void path_lookup_app_report(const kchar_t *name, kuint32_t usecs, kuint32_t errors)
+{
+    print_info("    %s: %d ns per lookup%s\n", name, usecs * 1000 / PATHLOOKUPAPP_LOOPS,
+                errors ? ", WRONG RESULTS" : "");
+}
+
+/*!
+ * @brief  run one pass
+ * @param  none
+ * @retval none
+ * @note   hot: the same file every time (cache hit);
+ *         cold: every file of the wide directory in turn, more than the cache can hold;
+ *         deep: a file under PATHLOOKUPAPP_DEPTH directories;
+ *         miss: a name which is not in the wide directory, so that the whole list is walked
+ */
+static void path_lookup_app_run(void)
+{
+    struct fwk_kobject *sprt_kobj;
+    kuint32_t start, usecs, idx, errors;
+
+    print_info("%s: %d lookups per case, %d files wide, %d directories deep\n",
+                __FUNCTION__, PATHLOOKUPAPP_LOOPS, PATHLOOKUPAPP_WIDE, PATHLOOKUPAPP_DEPTH);
+
+    errors = 0;
+    start = get_time_stamp_usecs();
+    for (idx = 0; idx < PATHLOOKUPAPP_LOOPS; idx++)
+    {
+        sprt_kobj = fwk_find_kobject_by_path(mrt_nullptr, g_path_lookup_app_wide[PATHLOOKUPAPP_WIDE >> 1]);
+        errors += (sprt_kobj != sprt_path_lookup_app_wide[PATHLOOKUPAPP_WIDE >> 1]);
+    }
+    usecs = get_time_stamp_elapsed(start);
+    path_lookup_app_report("hot", usecs, errors);
+
+    errors = 0;
+    start = get_time_stamp_usecs();
+    for (idx = 0; idx < PATHLOOKUPAPP_LOOPS; idx++)
+    {
+        sprt_kobj = fwk_find_kobject_by_path(mrt_nullptr, g_path_lookup_app_wide[idx % PATHLOOKUPAPP_WIDE]);
+        errors += (sprt_kobj != sprt_path_lookup_app_wide[idx % PATHLOOKUPAPP_WIDE]);
+    }
+    usecs = get_time_stamp_elapsed(start);
+    path_lookup_app_report("cold", usecs, errors);
+
+    errors = 0;
+    start = get_time_stamp_usecs();
+    for (idx = 0; idx < PATHLOOKUPAPP_LOOPS; idx++)
+    {
+        sprt_kobj = fwk_find_kobject_by_path(mrt_nullptr, g_path_lookup_app_deep);
+        errors += (sprt_kobj != sprt_path_lookup_app_deep);
+    }
+    usecs = get_time_stamp_elapsed(start);
+    path_lookup_app_report("deep", usecs, errors);
+
+    errors = 0;
+    start = get_time_stamp_usecs();
+    for (idx = 0; idx < PATHLOOKUPAPP_LOOPS; idx++)
+    {
+        sprt_kobj = fwk_find_kobject_by_path(mrt_nullptr, PATHLOOKUPAPP_ROOT "wide/none_");
+        errors += !!sprt_kobj;
+    }
+    usecs = get_time_stamp_elapsed(start);
+    path_lookup_app_report("miss", usecs, errors);
+}
+
+/*!
+ * @brief  path lookup task
+ * @param  none
+ * @retval none
+ * @note   none
+ */
+static void *path_lookup_app_entry(void *args)
+{
+    while (!ptr_systick_counter)
+        schedule_delay_ms(200);
+
+    if (path_lookup_app_build())
+    {
+        print_err("%s: can not create %s, exit\n", __FUNCTION__, PATHLOOKUPAPP_ROOT);
+
+        for (;;)
+            schedule_thread_suspend(mrt_current->tid);
+    }
+
+    for (;;)
+    {
+        path_lookup_app_run();
+        schedule_delay_ms(PATHLOOKUPAPP_PERIOD_MS);
+    }
+
+    return args;
+}
+
+/*!
+ * @brief	create path lookup task
+ * @param  	none
+ * @retval 	error code
+ * @note   	none
+ */
+kint32_t path_lookup_app_init(void)
+{
+    struct real_thread_attr *sprt_attr = &sgrt_path_lookup_app_attr;
+    kint32_t retval;
+
+	sprt_attr->detachstate = REAL_THREAD_CREATE_JOINABLE;
+	sprt_attr->inheritsched	= REAL_THREAD_INHERIT_SCHED;
+	sprt_attr->schedpolicy = REAL_THREAD_SCHED_FIFO;
+
+    /*!< thread stack */
+	real_thread_set_stack(sprt_attr, mrt_nullptr, g_path_lookup_app_stack, sizeof(g_path_lookup_app_stack));
+    /*!< lowest priority */
+	real_thread_set_priority(sprt_attr, REAL_THREAD_PROTY_DEFAULT);
+    /*!< default time slice */
+    real_thread_set_time_slice(sprt_attr, REAL_THREAD_TIME_DEFUALT);
+
+    /*!< register thread */
+    retval = real_thread_create(&g_path_lookup_app_tid, sprt_attr, path_lookup_app_entry, mrt_nullptr);
+    return (retval < 0) ? retval : 0;
+}
+
+/*!< end of file */
@@ -24,6 +24,12 @@ real_thread_init_t g_real_thread_init_tables[] =
     display_app_init,
     tsc_app_init,
     env_monitor_init,
+    latency_app_init,
+    irq_nest_app_init,
+    ioring_app_init,
+    fd_churn_app_init,
+    path_lookup_app_init,
+    lib_bench_app_init,
     
     mrt_nullptr,
 };
@@ -30,5 +30,11 @@ TARGET_EXT kint32_t button_app_init(void);
 TARGET_EXT kint32_t display_app_init(void);
 TARGET_EXT kint32_t tsc_app_init(void);
 TARGET_EXT kint32_t env_monitor_init(void);
+TARGET_EXT kint32_t latency_app_init(void);
+TARGET_EXT kint32_t irq_nest_app_init(void);
+TARGET_EXT kint32_t ioring_app_init(void);
+TARGET_EXT kint32_t fd_churn_app_init(void);
+TARGET_EXT kint32_t path_lookup_app_init(void);
+TARGET_EXT kint32_t lib_bench_app_init(void);
 
 #endif /* __THREAD_TABLE_H_ */
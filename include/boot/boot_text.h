@@ -109,4 +109,11 @@ TARGET_EXT kuaddr_t __mem_pool_end;
 #define MEMORY_POOL_BASE                    ((kuaddr_t)&__mem_pool_start)
 #define MEMORY_POOL_SIZE                    ((kusize_t)((kuaddr_t)(&__mem_pool_end) - (kuaddr_t)(&__mem_pool_start)))
 
+/*!< dma coherent pool */
+TARGET_EXT kuaddr_t __dma_pool_start;
+TARGET_EXT kuaddr_t __dma_pool_end;
+
+#define DMA_POOL_BASE                       ((kuaddr_t)&__dma_pool_start)
+#define DMA_POOL_SIZE                       ((kusize_t)((kuaddr_t)(&__dma_pool_end) - (kuaddr_t)(&__dma_pool_start)))
+
 #endif /* __BOOT_TEXT_H */
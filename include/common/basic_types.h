@@ -86,6 +86,7 @@ typedef	unsigned 	    int		kusize_t;
 typedef unsigned        long    kuaddr_t;
 typedef unsigned        long    kutype_t;
 typedef                 long    kstype_t;
+typedef                 long    kloff_t;
 
 #define __used		            __attribute__((used))
 #define __weak                  __attribute__((weak))
@@ -42,6 +42,9 @@
 #define mrt_is_bitset(val, mask)						((val) & (mask))
 #define mrt_is_bitreset(val, mask)						(0 == ((val) & (mask)))
 
+/*!< index of the lowest set bit; val must not be 0 (rbit + clz on armv7) */
+#define mrt_bit_ffs(val)								((kuint32_t)__builtin_ctz((kuint32_t)(val)))
+
 /*!< compare at least two number */
 #define CMP_GT2(a, b, c, d)								(((a) > (b)) ? (c) : (d))
 #define CMP_LT2(a, b, c, d)								(((a) < (b)) ? (c) : (d))
@@ -245,6 +248,22 @@ __force_inline static inline kbool_t isPower2(kutype_t number)
 	return (number && (0 == (number & (number - 1))));
 }
 
+/*!
+ * @brief   divide by constant 10 and 1000
+ * @param   number
+ * @retval  quotient
+ * @note    multiply by reciprocal: n / d = (n * ceil(2^k / d)) >> k, exact for all 32-bit n
+ */
+__force_inline static inline kuint32_t udiv_by_10(kuint32_t number)
+{
+	return (kuint32_t)(((kuint64_t)number * 0xcccccccdULL) >> 35);
+}
+
+__force_inline static inline kuint32_t udiv_by_1000(kuint32_t number)
+{
+	return (kuint32_t)(((kuint64_t)number * 0x10624dd3ULL) >> 38);
+}
+
 /*!
  * @brief   api_reverse_byte32
  * @param   val
@@ -150,6 +150,26 @@ TARGET_EXT void printk(const kchar_t *ptr_fmt, ...);
             print_debug("%s: %d: " fmt, __FUNCTION__, __LINE__, ##__VA_ARGS__);   \
     } while (0)
 
+/*!< bitmap: bit n is bit (n % 32) of word (n / 32) */
+#define BITMAP_BITS_PER_WORD                            RET_BITS_PER_INT
+#define BITMAP_WORD_SHIFT                               (5)
+#define mrt_bitmap_words(nbits)                         (((nbits) + BITMAP_BITS_PER_WORD - 1) >> BITMAP_WORD_SHIFT)
+#define mrt_bitmap_first_word_mask(start)               (~0U << ((start) & (BITMAP_BITS_PER_WORD - 1)))
+#define mrt_bitmap_last_word_mask(nbits)                (~0U >> (-(nbits) & (BITMAP_BITS_PER_WORD - 1)))
+
+#define DECLARE_BITMAP(name, nbits)                     kuint32_t name[mrt_bitmap_words(nbits)]
+
+TARGET_EXT kint32_t find_next_bit(const kuint32_t *bitmap, kusize_t total_bits, kuint32_t start);
+TARGET_EXT kint32_t find_next_zero_bit(const kuint32_t *bitmap, kusize_t total_bits, kuint32_t start);
+TARGET_EXT void bitmap_set(kuint32_t *bitmap, kuint32_t start, kuint32_t nr);
+TARGET_EXT void bitmap_clear(kuint32_t *bitmap, kuint32_t start, kuint32_t nr);
+TARGET_EXT kuint32_t bitmap_weight(const kuint32_t *bitmap, kusize_t total_bits);
+TARGET_EXT kint32_t bitmap_find_next_zero_area(const kuint32_t *bitmap, kusize_t total_bits, kuint32_t start, kuint32_t nr);
+
+#define find_first_bit(bitmap, total_bits)              find_next_bit(bitmap, total_bits, 0)
+#define find_first_zero_bit(bitmap, total_bits)         find_next_zero_bit(bitmap, total_bits, 0)
+
+/*!< the bitmap passed to these should be 4 bytes aligned, it is accessed by word */
 TARGET_EXT kint32_t bitmap_find_first_zero_bit(void *bitmap, kuint32_t start, kusize_t total_bits);
 TARGET_EXT kint32_t bitmap_find_first_valid_bit(void *bitmap, kuint32_t start, kusize_t total_bits);
 TARGET_EXT kint32_t bitmap_find_nr_zero_bit(void *bitmap, kuint32_t start, kusize_t total_bits, kuint32_t nr);
@@ -20,6 +20,14 @@
 /*!< The defines */
 #define MEMORY_POOL_MAGIC                                   (0xdfa69fe3)
 
+/*!< 
+ * memory operations fast path (arch/arm/lib/memops.S):
+ * size < MEMORY_WORDS_THRESHOLD: byte loop, the cost of function call is higher than copying;
+ * size >= MEMORY_NEON_THRESHOLD: NEON, if it is detected by "__memory_fast_init"
+ */
+#define MEMORY_WORDS_THRESHOLD                              (16)
+#define MEMORY_NEON_THRESHOLD                               (256)
+
 /*!< memory block */
 typedef struct mem_block
 {
@@ -46,7 +54,17 @@ typedef struct mem_info
 
 #define MEM_BLOCK_HEADER_SIZE								(mrt_num_align4(sizeof(struct mem_block)))
 
+/*!< The globals */
+TARGET_EXT kuint32_t g_memory_neon_enabled;
+
 /*!< The functions */
+TARGET_EXT void __memory_fast_init(void);
+TARGET_EXT void __memory_set_words(void *dest, kuint32_t data, kusize_t size);
+TARGET_EXT void __memory_set_neon(void *dest, kuint32_t data, kusize_t size);
+TARGET_EXT void *__memory_copy_words(void *dest, const void *src, kusize_t size);
+TARGET_EXT void *__memory_copy_neon(void *dest, const void *src, kusize_t size);
+TARGET_EXT kuint32_t __memory_compare_words(const void *s1, const void *s2, kusize_t size);
+
 TARGET_EXT kint32_t memory_simple_block_create(struct mem_info *sprt_info, kuaddr_t mem_addr, kusize_t size);
 TARGET_EXT void memory_simple_block_destroy(struct mem_info *sprt_info);
 TARGET_EXT void *alloc_spare_simple_memory(void *ptr_head, kusize_t size);
@@ -62,7 +80,7 @@ TARGET_EXT void malloc_block_destroy(void);
  * @brief   memory_set
  * @param   dest, data, size
  * @retval  none
- * @note    similar to "memset"
+ * @note    similar to "memset"; large block is filled by words (ldm/stm) or NEON
  */
 static inline void memory_set(void *dest, kuint8_t data, kusize_t size)
 {
@@ -71,6 +89,21 @@ static inline void memory_set(void *dest, kuint8_t data, kusize_t size)
 
     if (!dest)
         return;
+
+    if (size >= MEMORY_WORDS_THRESHOLD)
+    {
+        if ((size >= MEMORY_NEON_THRESHOLD) && g_memory_neon_enabled)
+        {
+            /*!< d0 ~ d3 are not saved by context switch, forbid preempt */
+            mrt_preempt_disable();
+            __memory_set_neon(dest, data, size);
+            mrt_preempt_enable();
+        }
+        else
+            __memory_set_words(dest, data, size);
+
+        return;
+    }
     
     start_addr = (kuaddr_t)dest;
     end_addr   = (kuaddr_t)(start_addr + size);
@@ -136,6 +169,9 @@ static inline kuint8_t memory_compare(const void *s1, const void *s2, kusize_t s
     kuaddr_t result1, result2;
     kuint8_t data1, data2, flag = 0;
 
+    if (size >= MEMORY_WORDS_THRESHOLD)
+        return (kuint8_t)__memory_compare_words(s1, s2, size);
+
     s1_addr = (kuaddr_t)s1;
     s2_addr = (kuaddr_t)s2;
     end_addr = (kuaddr_t)(s2_addr + size);
@@ -210,6 +246,21 @@ static inline void *memory_copy(void *dest, const void *src, kusize_t size)
     if (!dest || !src)
         return mrt_nullptr;
 
+    if (size >= MEMORY_WORDS_THRESHOLD)
+    {
+        if ((size >= MEMORY_NEON_THRESHOLD) && g_memory_neon_enabled)
+        {
+            /*!< d0 ~ d3 are not saved by context switch, forbid preempt */
+            mrt_preempt_disable();
+            __memory_copy_neon(dest, src, size);
+            mrt_preempt_enable();
+
+            return dest;
+        }
+
+        return __memory_copy_words(dest, src, size);
+    }
+
     s1_addr = (kuaddr_t)dest;
     s2_addr = (kuaddr_t)src;
     end_addr = (kuaddr_t)(s2_addr + size);
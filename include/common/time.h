@@ -28,12 +28,16 @@ TARGET_EXT kutime_t jiffies;
 TARGET_EXT kutime_t jiffies_out;
 
 TARGET_EXT kutime_t *ptr_systick_counter;
+TARGET_EXT kutime_t *ptr_systick_status;
+TARGET_EXT kutime_t g_systick_status_mask;
 TARGET_EXT kutime_t g_delay_timer_counter;
 
 /*!< The defines */
 #define TICK_HZ                                             CONFIG_HZ
 #define mrt_jiffies                                         (*ptr_systick_counter)
 
+#define TIME_STAMP_USECS_PER_TICK                           (1000000 / TICK_HZ)             /*!< systick runs at 1MHz, and restarts on every tick */
+
 #define JIFFIES_INITVAL                                     (86400000 - 1)
 #define JIFFIES_MAX                                         ((kutime_t)(~0))
 
@@ -119,6 +123,7 @@ TARGET_EXT void del_timer(struct timer_list *sprt_timer);
 TARGET_EXT kbool_t find_timer(struct timer_list *sprt_timer);
 TARGET_EXT void mod_timer(struct timer_list *sprt_timer, kutime_t expires);
 TARGET_EXT void do_timer_event(void);
+TARGET_EXT kuint32_t get_time_stamp(kutime_t *tick);
 
 /*!< API functions */
 /*!< jiffies counter */
@@ -128,6 +133,26 @@ static inline void get_time_counter(void)
     jiffies_out = jiffies ? jiffies_out : (jiffies_out + 1);
 }
 
+/*!< timestamp (us) for measuring short intervals, wraps around */
+static inline kuint32_t get_time_stamp_usecs(void)
+{
+    kutime_t tick;
+    kuint32_t usecs = get_time_stamp(&tick);
+
+    return (kuint32_t)tick * TIME_STAMP_USECS_PER_TICK + usecs;
+}
+
+/*!< 
+ * time (us) passed since a timestamp of get_time_stamp_usecs();
+ * a stamp taken while systick was masked for more than one tick can be ahead of a later one, count it as 0
+ */
+static inline kuint32_t get_time_stamp_elapsed(kuint32_t start)
+{
+    kuint32_t elapsed = get_time_stamp_usecs() - start;
+
+    return ((kint32_t)elapsed < 0) ? 0 : elapsed;
+}
+
 static inline kuint32_t jiffies_to_secs(const kutime_t j)
 {
     return (j / TICK_HZ);
@@ -155,12 +180,12 @@ static inline kutime_t secs_to_jiffies(const kuint32_t s)
 
 static inline kutime_t msecs_to_jiffies(const kuint32_t m)
 {
-    return ((m * TICK_HZ) / 1000);
+    return udiv_by_1000(m * TICK_HZ);
 }
 
 static inline kutime_t usecs_to_jiffies(const kuint32_t u)
 {
-    return ((u * TICK_HZ) / 1000 / 1000);
+    return udiv_by_1000(udiv_by_1000(u * TICK_HZ));
 }
 
 static inline kutime_t nsecs_to_jiffies(kuint64_t n)
@@ -170,12 +195,12 @@ static inline kutime_t nsecs_to_jiffies(kuint64_t n)
 
 static inline kutime_t time_spec_to_msecs(struct time_spec *sprt_tm)
 {
-    return ((sprt_tm->tv_sec * 1000) + (sprt_tm->tv_nsec / 1000 / 1000));
+    return ((sprt_tm->tv_sec * 1000) + udiv_by_1000(udiv_by_1000(sprt_tm->tv_nsec)));
 }
 
 static inline struct time_spec *msecs_to_time_spec(struct time_spec *sprt_tm, const kuint32_t m)
 {
-    sprt_tm->tv_sec  = m / 1000;
+    sprt_tm->tv_sec  = udiv_by_1000(m);
     sprt_tm->tv_nsec = (m - (sprt_tm->tv_sec * 1000)) * 1000 * 1000;
     
     return sprt_tm;
@@ -65,6 +65,14 @@ struct real_thread
 
 #define mrt_thread_is_flags(signal, sprt_tsk)						(!!((sprt_tsk)->flags & mrt_bit(signal)))
 
+/*!< need resched: checked by the IRQ return path (vectors.S), which switches thread if it is set */
+TARGET_EXT kuint32_t g_asm_sched_flag;
+
+#define mrt_set_need_resched()	\
+	do {	\
+		g_asm_sched_flag = true;	\
+	} while (0)
+
 /*!< thread manage table */
 struct scheduler_table
 {
@@ -86,6 +94,7 @@ struct scheduler_table
 
 	struct real_thread **sprt_tids;									/*!< if sprt_tid_array is up to max, new thread form mempool */
 	struct real_thread *sprt_tid_array[REAL_THREAD_MAX_NUM];		/*!< thread maximum, tid = 0 ~ REAL_THREAD_MAX_NUM */
+	DECLARE_BITMAP(wakeup_pending, REAL_THREAD_MAX_NUM);			/*!< wakeups requested while sgrt_lock was held */
 
 	struct spin_lock sgrt_lock;
 
@@ -106,8 +115,12 @@ TARGET_EXT struct spin_lock *scheduler_lock(void);
 TARGET_EXT real_thread_t get_unused_tid_from_scheduler(kuint32_t i_start, kuint32_t count);
 TARGET_EXT kuint64_t scheduler_stats_get(void);
 TARGET_EXT void schedule_self_suspend(void);
+TARGET_EXT void schedule_self_suspend_wakeable(void);
 TARGET_EXT kint32_t schedule_thread_suspend(real_thread_t tid);
 TARGET_EXT kint32_t schedule_thread_wakeup(real_thread_t tid);
+TARGET_EXT void schedule_thread_wakeup_async(real_thread_t tid);
+TARGET_EXT void schedule_wakeup_pending(void);
+TARGET_EXT void schedule_preempt_check(struct real_thread *sprt_thread);
 
 TARGET_EXT kbool_t is_ready_thread_empty(void);
 TARGET_EXT kbool_t is_suspend_thread_empty(void);
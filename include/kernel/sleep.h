@@ -20,6 +20,7 @@
 
 /*!< The functions */
 TARGET_EXT void schedule_timeout(kutime_t count);
+TARGET_EXT void schedule_timeout_wakeable(kutime_t count);
 TARGET_EXT void schedule_delay(kuint32_t seconds);
 TARGET_EXT void schedule_delay_ms(kuint32_t milseconds);
 TARGET_EXT void schedule_delay_us(kuint32_t useconds);
@@ -0,0 +1,94 @@
+/*
+ * DMA Mapping Interface Defines
+ *
+ * File Name:   fwk_dma.h
+ * Author:      Yang Yujun
+ * E-mail:      <yujiantianhu@163.com>
+ * Created on:  2024.06.05
+ *
+ * Copyright (c) 2024   Yang Yujun <yujiantianhu@163.com>
+ *
+ */
+
+#ifndef __FWK_DMA_H
+#define __FWK_DMA_H
+
+/*!< The includes */
+#include <common/generic.h>
+#include <configs/configs.h>
+#include <platform/fwk_mempool.h>
+
+/*!< The defines */
+typedef kuaddr_t dma_addr_t;
+
+enum fwk_dma_data_direction
+{
+    NR_DMA_BIDIRECTIONAL = 0,
+    NR_DMA_TO_DEVICE,                                       /*!< cpu writes, device reads: clean before transfer */
+    NR_DMA_FROM_DEVICE,                                     /*!< device writes, cpu reads: invalidate before and after transfer */
+    NR_DMA_NONE,
+};
+
+/*!< alignment of coherent buffer, it is enough for most of descriptors (e.g. USB QH requires 2KB) */
+#define FWK_DMA_COHERENT_ALIGN                              (4096U)
+#define FWK_DMA_MAPPING_ERROR                               ((dma_addr_t)(~0))
+
+struct fwk_scatterlist
+{
+    void *buf;                                              /*!< virtual address of the segment */
+    kusize_t length;
+
+    dma_addr_t dma_address;                                 /*!< it is filled by fwk_dma_map_sg */
+    kusize_t dma_length;
+};
+
+struct fwk_device;
+
+/*!< The functions */
+TARGET_EXT void *fwk_dma_alloc_coherent(struct fwk_device *sprt_dev, kusize_t size, dma_addr_t *dma_handle, ert_fwk_mempool_t flags);
+TARGET_EXT void fwk_dma_free_coherent(struct fwk_device *sprt_dev, kusize_t size, void *cpu_addr, dma_addr_t dma_handle);
+
+TARGET_EXT dma_addr_t fwk_dma_map_single(struct fwk_device *sprt_dev, void *ptr, kusize_t size, enum fwk_dma_data_direction dir);
+TARGET_EXT void fwk_dma_unmap_single(struct fwk_device *sprt_dev, dma_addr_t addr, kusize_t size, enum fwk_dma_data_direction dir);
+TARGET_EXT void fwk_dma_sync_single_for_cpu(struct fwk_device *sprt_dev, dma_addr_t addr, kusize_t size, enum fwk_dma_data_direction dir);
+TARGET_EXT void fwk_dma_sync_single_for_device(struct fwk_device *sprt_dev, dma_addr_t addr, kusize_t size, enum fwk_dma_data_direction dir);
+
+TARGET_EXT kint32_t fwk_dma_map_sg(struct fwk_device *sprt_dev, struct fwk_scatterlist *sprt_sg, kint32_t nents, enum fwk_dma_data_direction dir);
+TARGET_EXT void fwk_dma_unmap_sg(struct fwk_device *sprt_dev, struct fwk_scatterlist *sprt_sg, kint32_t nents, enum fwk_dma_data_direction dir);
+
+/*!< API functions */
+/*!
+ * @brief   initial scatterlist table
+ * @param   sprt_sg, nents
+ * @retval  none
+ * @note    none
+ */
+static inline void fwk_sg_init_table(struct fwk_scatterlist *sprt_sg, kint32_t nents)
+{
+    memory_reset(sprt_sg, sizeof(*sprt_sg) * nents);
+}
+
+/*!
+ * @brief   set buffer of one segment
+ * @param   sprt_sg, buf, length
+ * @retval  none
+ * @note    none
+ */
+static inline void fwk_sg_set_buf(struct fwk_scatterlist *sprt_sg, void *buf, kusize_t length)
+{
+    sprt_sg->buf = buf;
+    sprt_sg->length = length;
+}
+
+/*!
+ * @brief   check if the address returned by fwk_dma_map_single is valid
+ * @param   sprt_dev, addr
+ * @retval  error code
+ * @note    none
+ */
+static inline kint32_t fwk_dma_mapping_error(struct fwk_device *sprt_dev, dma_addr_t addr)
+{
+    return (addr == FWK_DMA_MAPPING_ERROR) ? -ER_FAULT : ER_NORMAL;
+}
+
+#endif /* __FWK_DMA_H */
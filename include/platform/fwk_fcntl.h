@@ -16,28 +16,39 @@
 /*!< The includes */
 #include <platform/fwk_basic.h>
 #include <platform/fwk_fs.h>
+#include <platform/fwk_poll.h>
 #include <kernel/mutex.h>
 
 /*!< The defines */
-/*!< The maximum number of default file descriptors that can be assigned */
+/*!< The number of file descriptors of the initial (embedded) table */
 #define FILE_DESC_NUM_MAX									(32)
 
-/*!< The maximum number of extension file descriptors that can be assigned */
-#define FILE_DESC_EXP_NUM									(128)
+/*!< The table is doubled on demand, up to this limit */
+#define FILE_DESC_NUM_LIMIT									(4096)
 
 #define FILE_DESC_OVER_BASE(fd)								(fd < DEVICE_MAJOR_BASE)
 
+struct fwk_fdtable
+{
+	kint32_t max_fds;										/*!< size of fd[] and bits of the bitmaps */
+	struct fwk_file **fd;
+	kuint32_t *open_fds;									/*!< bit n is set: fd n is assigned */
+	kuint32_t *close_on_exec;								/*!< bit n is set: fd n is opened with O_CLOEXEC */
+
+	struct fwk_fdtable *sprt_old;							/*!< the table replaced by this one */
+};
+
 struct fwk_file_table
 {
-	kint32_t max_fdarr;										/*!< size of fd_array */
-	kint32_t max_fds; 										/*!< The maximum number of current file objects = max_fdarr + array number of fds */
-	kint32_t max_fdset;										/*!< The maximum number of current file descriptors */
-	kint32_t ref_fdarr; 									/*!< The number of descriptors that have been assigned on fd_array */
+	struct fwk_fdtable *sprt_fdt;							/*!< the current table, can be read without lock */
+	kint32_t next_fd;										/*!< no free descriptor is below it */
 
-	struct fwk_file **fds;
+	struct fwk_fdtable sgrt_fdtab;							/*!< the initial table, and its members below */
 	struct fwk_file *fd_array[FILE_DESC_NUM_MAX];
+	DECLARE_BITMAP(open_fds_init, FILE_DESC_NUM_MAX);
+	DECLARE_BITMAP(close_on_exec_init, FILE_DESC_NUM_MAX);
 
-	struct mutex_lock sgrt_mutex;
+	struct mutex_lock sgrt_mutex;							/*!< serializes allocation, install and expansion */
 };
 
 /*!< for open mode */
@@ -120,6 +131,27 @@ struct fwk_file_table
 #define O_NDELAY											O_NONBLOCK
 #endif
 
+/*!< for lseek */
+#ifndef SEEK_SET
+#define SEEK_SET											0
+#define SEEK_CUR											1
+#define SEEK_END											2
+#endif
+
+/*!< for mmap */
+#ifndef PROT_NONE
+#define PROT_NONE											0x0
+#define PROT_READ											0x1
+#define PROT_WRITE											0x2
+#define PROT_EXEC											0x4
+#endif
+
+#ifndef MAP_SHARED
+#define MAP_SHARED											0x01		/*!< the default, since memory is not copied */
+#define MAP_PRIVATE											0x02		/*!< not supported */
+#define MAP_FIXED											0x10		/*!< addr must be the address of the mapping */
+#endif
+
 #define F_DUPFD												0
 #define F_GETFD												1
 #define F_SETFD												2
@@ -151,43 +183,26 @@ TARGET_EXT kint32_t virt_open(const kchar_t *dev, kuint32_t mode);
 TARGET_EXT void virt_close(kint32_t fd);
 TARGET_EXT kssize_t virt_write(kint32_t fd, const void *buf, kusize_t size);
 TARGET_EXT kssize_t virt_read(kint32_t fd, void *buf, kusize_t size);
+TARGET_EXT kssize_t virt_pwrite(kint32_t fd, const void *buf, kusize_t size, kloff_t offset);
+TARGET_EXT kssize_t virt_pread(kint32_t fd, void *buf, kusize_t size, kloff_t offset);
+TARGET_EXT kloff_t virt_lseek(kint32_t fd, kloff_t offset, kint32_t whence);
+TARGET_EXT kssize_t virt_writev(kint32_t fd, const struct fwk_iovec *sprt_iov, kuint32_t iovcnt);
+TARGET_EXT kssize_t virt_readv(kint32_t fd, const struct fwk_iovec *sprt_iov, kuint32_t iovcnt);
+TARGET_EXT kint32_t virt_poll(struct fwk_pollfd *sprt_fds, kuint32_t nfds, kint32_t timeout_ms);
 TARGET_EXT kssize_t virt_ioctl(kint32_t fd, kuint32_t request, ...);
 TARGET_EXT void *virt_mmap(void *addr, kusize_t length, kint32_t prot, kint32_t flags, kint32_t fd, kuint32_t offset);
 TARGET_EXT kint32_t virt_munmap(void *addr, kusize_t length);
 
 /*!< API function */
 /*!
- * @brief   Get avaliable index
- * @param   none
- * @retval  none
- * @note    none
+ * @brief   get the current fd table
+ * @param   sprt_table
+ * @retval  fd table
+ * @note    lock free: a table is filled up completely before it is published, and never freed
  */
-static inline kint32_t fwk_get_fd_available(struct fwk_file_table *sprt_table)
+static inline struct fwk_fdtable *fwk_files_fdtable(struct fwk_file_table *sprt_table)
 {
-	return (sprt_table->ref_fdarr < sprt_table->max_fdarr) ? (sprt_table->ref_fdarr) : (-1);
+	return *(struct fwk_fdtable * volatile *)&sprt_table->sprt_fdt;
 }
 
-/*!
- * @brief   fwk_fdtable_get
- * @param   none
- * @retval  none
- * @note    none
- */
-static inline void fwk_fdtable_get(struct fwk_file_table *sprt_table)
-{
-	sprt_table->ref_fdarr = (sprt_table->ref_fdarr < sprt_table->max_fdarr) ? (sprt_table->ref_fdarr + 1) : sprt_table->max_fdarr;
-}
-
-/*!
- * @brief   fwk_fdtable_put
- * @param   none
- * @retval  none
- * @note    none
- */
-static inline void fwk_fdtable_put(struct fwk_file_table *sprt_table)
-{
-	sprt_table->ref_fdarr = (sprt_table->ref_fdarr > DEVICE_MAJOR_BASE) ? (sprt_table->ref_fdarr - 1) : DEVICE_MAJOR_BASE;
-}
-
-
 #endif /*!< __FWK_FCNTL_H_ */
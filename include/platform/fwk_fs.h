@@ -25,6 +25,7 @@
 struct fwk_file
 {
 	kuint32_t mode;
+	kloff_t f_pos;											/*!< current offset, used by read/write */
 
 	struct fwk_inode *sprt_inode;
 	struct fwk_file_oprts *sprt_foprts;
@@ -35,20 +36,29 @@ struct fwk_file
 	void *private_data;
 };
 
+struct fwk_poll_table;
+
 /*!< Device operation API */
 struct fwk_file_oprts
 {
 	kint32_t (*open) (struct fwk_inode *, struct fwk_file *);
 	kint32_t (*close) (struct fwk_inode *, struct fwk_file *);
-	kssize_t (*write) (struct fwk_file *, const kbuffer_t *, kssize_t);
-	kssize_t (*read) (struct fwk_file *, kbuffer_t *, kssize_t);
+	kloff_t (*llseek) (struct fwk_file *, kloff_t, kint32_t);
+	kssize_t (*write) (struct fwk_file *, const kbuffer_t *, kssize_t, kloff_t *);
+	kssize_t (*read) (struct fwk_file *, kbuffer_t *, kssize_t, kloff_t *);
+	kssize_t (*write_iter) (struct fwk_file *, const struct fwk_iovec *, kuint32_t, kloff_t *);
+	kssize_t (*read_iter) (struct fwk_file *, const struct fwk_iovec *, kuint32_t, kloff_t *);
 	kint32_t (*unlocked_ioctl) (struct fwk_file *, kuint32_t, kuaddr_t);
 	kint32_t (*compat_ioctl) (struct fwk_file *, kuint32_t, kuaddr_t);
 	kint32_t (*mmap) (struct fwk_file *, struct fwk_vm_area *);
+	kuint32_t (*poll) (struct fwk_file *, struct fwk_poll_table *);
 };
 
 /*!< The functions */
 TARGET_EXT struct fwk_file *fwk_do_filp_open(kchar_t *name, kuint32_t mode);
 TARGET_EXT void fwk_do_filp_close(struct fwk_file *sprt_file);
+TARGET_EXT kloff_t fwk_generic_file_llseek(struct fwk_file *sprt_file, kloff_t offset, kint32_t whence, kloff_t size);
+TARGET_EXT kssize_t fwk_simple_read_from_buffer(kbuffer_t *buf, kssize_t size, kloff_t *pos, const void *from, kssize_t available);
+TARGET_EXT kssize_t fwk_simple_write_to_buffer(void *to, kssize_t available, kloff_t *pos, const kbuffer_t *buf, kssize_t size);
 
 #endif /*!< __FWK_FS_H_ */
@@ -26,6 +26,23 @@
 #define INODE_TYPE_FILE									(0)
 #define INODE_TYPE_DIR									(1)
 
+/*!< I/O statistics of a device node, times are in systick (GPT) counts (us) */
+struct fwk_io_stat
+{
+	kuint32_t ops;
+	kuint32_t errors;
+	kuint64_t bytes;
+	kuint64_t time_total;
+	kuint32_t time_max;
+};
+
+struct fwk_io_stats
+{
+	struct fwk_io_stat sgrt_read;
+	struct fwk_io_stat sgrt_write;
+	struct fwk_io_stat sgrt_ioctl;
+};
+
 struct fwk_inode
 {
 	kchar_t *name;
@@ -34,6 +51,9 @@ struct fwk_inode
 
 	struct fwk_file_oprts *sprt_foprts;
 	struct fwk_kobject *sprt_kobj;
+	struct list_head sgrt_vmas;							/*!< mappings of the device, see virt_mmap */
+	struct fwk_io_stats sgrt_iostats;					/*!< accounted by read/write/ioctl */
+	void *private_data;									/*!< used by sysfs: attribute of a file, or device node of /sys/<device>/ */
 
 	union
 	{
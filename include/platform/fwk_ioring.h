@@ -0,0 +1,179 @@
+/*
+ * Asynchronous I/O Ring Defines
+ *
+ * File Name:   fwk_ioring.h
+ * Author:      Yang Yujun
+ * E-mail:      <yujiantianhu@163.com>
+ * Created on:  2024.07.28
+ *
+ * Copyright (c) 2024   Yang Yujun <yujiantianhu@163.com>
+ *
+ */
+
+#ifndef __FWK_IORING_H_
+#define __FWK_IORING_H_
+
+/*!< The includes */
+#include <platform/fwk_basic.h>
+#include <kernel/wait.h>
+
+/*!< The defines */
+/*!< the maximum number of submission entries of a ring */
+#define FWK_IO_RING_ENTRIES_MAX								(256)
+
+/*!< every ring alive has its own worker thread; this is the maximum number of rings alive at the same time */
+#define FWK_IO_RING_WORKER_MAX								(4)
+
+enum __ERT_IO_RING_OP
+{
+	NR_IO_RING_OP_NOP = 0,
+	NR_IO_RING_OP_READ,
+	NR_IO_RING_OP_WRITE,
+	NR_IO_RING_OP_IOCTL,
+};
+
+/*!< submission queue entry */
+struct fwk_io_sqe
+{
+	kuint8_t opcode;										/*!< NR_IO_RING_OP_* */
+	kint32_t fd;
+	kloff_t offset;											/*!< < 0: use and update f_pos (read/write) */
+	void *addr;												/*!< buffer (read/write), or args (ioctl) */
+	kusize_t len;											/*!< buffer size (read/write) */
+	kuint32_t request;										/*!< ioctl command */
+	kuaddr_t user_data;										/*!< copied to cqe */
+};
+
+/*!< completion queue entry */
+struct fwk_io_cqe
+{
+	kuaddr_t user_data;
+	kssize_t res;											/*!< the return value of the operation */
+};
+
+struct fwk_io_ring_worker;
+
+/*!<
+ * The ring is shared by its owner thread and its worker thread:
+ *  owner:  fills sqes, moves sqe_tail, publishes it to sq_tail on submit; consumes cqes, moves cq_head
+ *  worker: consumes sqes, moves sq_head; fills cqes, moves cq_tail
+ * The heads and tails run freely, and are masked when indexing.
+ * Every sqe completes with exactly one cqe; an sqe is not given out if its cqe may have no room,
+ * so the completion queue never overflows.
+ * The requests of a ring are issued one by one, and may block the worker (not the owner);
+ * the rings of different threads never wait for each other.
+ */
+struct fwk_io_ring
+{
+	kuint32_t sq_entries;
+	kuint32_t cq_entries;
+
+	kuint32_t sq_head;
+	kuint32_t sq_tail;
+	kuint32_t sqe_tail;										/*!< sqes got by the owner, not seen by the worker */
+	kuint32_t cq_head;
+	kuint32_t cq_tail;
+
+	struct fwk_io_sqe *sprt_sqes;
+	struct fwk_io_cqe *sprt_cqes;
+
+	struct fwk_io_ring_worker *sprt_worker;
+	struct wait_queue_head sgrt_wqh;						/*!< woken up on every completion */
+};
+
+#define mrt_io_ring_read(x)									(*(volatile kuint32_t *)&(x))
+#define mrt_io_ring_write(x, val)							do { *(volatile kuint32_t *)&(x) = (val); } while (0)
+
+/*!< The functions */
+TARGET_EXT struct fwk_io_ring *virt_io_ring_setup(kuint32_t entries);
+TARGET_EXT void virt_io_ring_destroy(struct fwk_io_ring *sprt_ring);
+TARGET_EXT kint32_t virt_io_ring_submit(struct fwk_io_ring *sprt_ring);
+TARGET_EXT struct fwk_io_cqe *virt_io_ring_wait_cqe(struct fwk_io_ring *sprt_ring, kint32_t timeout_ms);
+
+/*!< API functions */
+/*!
+ * @brief   get a free submission entry
+ * @param   sprt_ring
+ * @retval  sqe, or mrt_nullptr if the ring is full
+ * @note    the sqe is not seen by the worker until virt_io_ring_submit()
+ */
+static inline struct fwk_io_sqe *fwk_io_ring_get_sqe(struct fwk_io_ring *sprt_ring)
+{
+	kuint32_t tail = sprt_ring->sqe_tail;
+
+	if ((tail - mrt_io_ring_read(sprt_ring->sq_head)) >= sprt_ring->sq_entries)
+		return mrt_nullptr;
+
+	/*!< the cqes of all sqes that are not reaped must fit in the completion queue */
+	if ((tail - sprt_ring->cq_head) >= sprt_ring->cq_entries)
+		return mrt_nullptr;
+
+	sprt_ring->sqe_tail = tail + 1;
+
+	return &sprt_ring->sprt_sqes[tail & (sprt_ring->sq_entries - 1)];
+}
+
+/*!
+ * @brief   get the first completion entry
+ * @param   sprt_ring
+ * @retval  cqe, or mrt_nullptr if nothing is completed
+ * @note    call fwk_io_ring_cqe_seen() after the cqe is used
+ */
+static inline struct fwk_io_cqe *fwk_io_ring_peek_cqe(struct fwk_io_ring *sprt_ring)
+{
+	kuint32_t head = sprt_ring->cq_head;
+
+	if (head == mrt_io_ring_read(sprt_ring->cq_tail))
+		return mrt_nullptr;
+
+	/*!< cqe is read after cq_tail */
+	mrt_dmb();
+
+	return &sprt_ring->sprt_cqes[head & (sprt_ring->cq_entries - 1)];
+}
+
+/*!
+ * @brief   release the first completion entry
+ * @param   sprt_ring
+ * @retval  none
+ * @note    none
+ */
+static inline void fwk_io_ring_cqe_seen(struct fwk_io_ring *sprt_ring)
+{
+	mrt_io_ring_write(sprt_ring->cq_head, sprt_ring->cq_head + 1);
+}
+
+/*!
+ * @brief   prepare a read/write request
+ * @param   sprt_sqe, opcode, fd, buf, len
+ * @param   offset: < 0: use and update f_pos
+ * @param   user_data: copied to cqe
+ * @retval  none
+ * @note    none
+ */
+static inline void fwk_io_ring_prep_rw(struct fwk_io_sqe *sprt_sqe, kuint8_t opcode, kint32_t fd,
+										void *buf, kusize_t len, kloff_t offset, kuaddr_t user_data)
+{
+	sprt_sqe->opcode = opcode;
+	sprt_sqe->fd = fd;
+	sprt_sqe->offset = offset;
+	sprt_sqe->addr = buf;
+	sprt_sqe->len = len;
+	sprt_sqe->request = 0;
+	sprt_sqe->user_data = user_data;
+}
+
+/*!
+ * @brief   prepare an ioctl request
+ * @param   sprt_sqe, fd, request, args, user_data
+ * @retval  none
+ * @note    none
+ */
+static inline void fwk_io_ring_prep_ioctl(struct fwk_io_sqe *sprt_sqe, kint32_t fd,
+										kuint32_t request, void *args, kuaddr_t user_data)
+{
+	fwk_io_ring_prep_rw(sprt_sqe, NR_IO_RING_OP_IOCTL, fd, args, 0, -1, user_data);
+	sprt_sqe->request = request;
+}
+
+#endif /*!< __FWK_IORING_H_ */
@@ -23,6 +23,8 @@ struct spin_lock;
 struct fwk_kobject
 {
 	kchar_t *name;
+	kuint32_t name_hash;									/*!< see fwk_kobject_name_hash() */
+	kuint32_t name_len;
 	struct atomic sgrt_ref;
 
 	struct list_head sgrt_link;
@@ -43,18 +45,26 @@ struct fwk_kset
 #define mrt_fwk_kset_get(sprt_kobj)	\
 	(((sprt_kobj) && (sprt_kobj)->is_dir) ? mrt_container_of(sprt_kobj, struct fwk_kset, sgrt_kobj) : mrt_nullptr)
 
-struct fwk_probes
+/*!< the minor table of a major is at least this large, and grows by doubling */
+#define FWK_KOBJMAP_MINORS_MIN								(8)
+
+/*!< all of the minors mapped under one major, indexed by minor */
+struct fwk_kobj_minors
 {
-	kuint32_t devNum;
-	kuint32_t range;
+	kuint32_t nr_minors;									/*!< size of data[], covers the highest minor mapped */
+	kuint32_t nr_mapped;									/*!< the table is freed when no minor is mapped */
 
-	void *data;
-	struct fwk_probes *sprt_next;
+	void **data;											/*!< follows this struct in the same allocation */
 };
 
+/*!<
+ * (major, minor) ===> data, two-level dense table:
+ *  sprt_majors[major]->data[minor]
+ * lookup is O(1), no matter how many devices have been mapped
+ */
 struct fwk_kobj_map
 {
-	struct fwk_probes *sprt_probes[DEVICE_MAX_NUM];
+	struct fwk_kobj_minors *sprt_majors[DEVICE_MAX_NUM];
 };
 
 /*!< The globals */
@@ -143,4 +153,20 @@ static inline kbool_t fwk_kref_is_zero(struct atomic *sprt_kref)
 	return !!ATOMIC_READ(sprt_kref);
 }
 
+/*!
+ * @brief   hash a name (or a path component)
+ * @param   name, lenth
+ * @retval  hash value
+ * @note    FNV-1a
+ */
+static inline kuint32_t fwk_kobject_name_hash(const kchar_t *name, kusize_t lenth)
+{
+	kuint32_t hash = 2166136261U;
+
+	while (lenth--)
+		hash = (hash ^ (kuint8_t)(*name++)) * 16777619U;
+
+	return hash;
+}
+
 #endif /*!< __FWK_KOBJ_H_ */
@@ -0,0 +1,73 @@
+/*
+ * I/O Multiplexing Defines
+ *
+ * File Name:   fwk_poll.h
+ * Author:      Yang Yujun
+ * E-mail:      <yujiantianhu@163.com>
+ * Created on:  2024.07.27
+ *
+ * Copyright (c) 2024   Yang Yujun <yujiantianhu@163.com>
+ *
+ */
+
+#ifndef __FWK_POLL_H_
+#define __FWK_POLL_H_
+
+/*!< The includes */
+#include <platform/fwk_basic.h>
+#include <kernel/wait.h>
+
+/*!< The defines */
+/*!< events and revents */
+#define POLLIN												0x0001		/*!< data can be read */
+#define POLLPRI												0x0002		/*!< urgent data can be read */
+#define POLLOUT												0x0004		/*!< data can be written */
+#define POLLERR												0x0008		/*!< error, always reported */
+#define POLLHUP												0x0010		/*!< hung up, always reported */
+#define POLLNVAL											0x0020		/*!< fd is not opened, always reported */
+#define POLLRDNORM											0x0040
+#define POLLWRNORM											0x0100
+
+/*!< the maximum number of wait queues that one virt_poll() can sleep on */
+#define FWK_POLL_ENTRIES_MAX								(16)
+
+struct fwk_file;
+
+struct fwk_poll_table_entry
+{
+	struct wait_queue_head *sprt_wqh;
+	struct wait_queue sgrt_wq;
+};
+
+struct fwk_poll_table
+{
+	kuint32_t nr_entries;
+	kint32_t error;											/*!< -ER_MORE: too many wait queues */
+	struct fwk_poll_table_entry sgrt_entries[FWK_POLL_ENTRIES_MAX];
+};
+
+struct fwk_pollfd
+{
+	kint32_t fd;
+	kint16_t events;										/*!< requested */
+	kint16_t revents;										/*!< returned */
+};
+
+/*!< The functions */
+TARGET_EXT void __fwk_poll_wait(struct fwk_file *sprt_file, struct wait_queue_head *sprt_wqh, struct fwk_poll_table *sprt_pt);
+TARGET_EXT void fwk_poll_freewait(struct fwk_poll_table *sprt_pt);
+
+/*!< API functions */
+/*!
+ * @brief   register the wait queue in poll table
+ * @param   sprt_file, sprt_wqh, sprt_pt
+ * @retval  none
+ * @note    it is called by the driver's poll op; sprt_pt is mrt_nullptr if the caller does not sleep
+ */
+static inline void fwk_poll_wait(struct fwk_file *sprt_file, struct wait_queue_head *sprt_wqh, struct fwk_poll_table *sprt_pt)
+{
+	if (sprt_pt && sprt_wqh)
+		__fwk_poll_wait(sprt_file, sprt_wqh, sprt_pt);
+}
+
+#endif /*!< __FWK_POLL_H_ */
@@ -0,0 +1,66 @@
+/*
+ * Gerneral Interface : SysFs Defines
+ *
+ * File Name:   fwk_sysfs.h
+ * Author:      Yang Yujun
+ * E-mail:      <yujiantianhu@163.com>
+ * Created on:  2024.07.29
+ *
+ * Copyright (c) 2024   Yang Yujun <yujiantianhu@163.com>
+ *
+ */
+
+#ifndef __FWK_SYSFS_H_
+#define __FWK_SYSFS_H_
+
+/*!< The includes */
+#include <platform/fwk_basic.h>
+#include <platform/fwk_inode.h>
+#include <platform/fwk_kobj.h>
+#include <platform/fwk_fcntl.h>
+
+/*!< The defines */
+/*!< show() writes at most this size; store() gets at most this size - 1, terminated with '\0' */
+#define FWK_SYSFS_BUF_SIZE									FWK_PAGE_SIZE
+
+struct fwk_attribute
+{
+	const kchar_t *name;
+	kuint32_t mode;											/*!< O_RDONLY, O_WRONLY or O_RDWR */
+
+	kssize_t (*show) (struct fwk_kobject *sprt_kobj, struct fwk_attribute *sprt_attr, kchar_t *buf);
+	kssize_t (*store) (struct fwk_kobject *sprt_kobj, struct fwk_attribute *sprt_attr, const kchar_t *buf, kusize_t count);
+};
+
+struct fwk_attribute_group
+{
+	const kchar_t *name;									/*!< subdirectory, or mrt_nullptr */
+	struct fwk_attribute **sprt_attrs;						/*!< ended with mrt_nullptr */
+};
+
+#define __FWK_ATTR(_name, _mode, _show, _store)	\
+{	\
+	.name	= #_name,	\
+	.mode	= _mode,	\
+	.show	= _show,	\
+	.store	= _store,	\
+}
+
+/*!< "xxx_show" and "xxx_store" should be defined first */
+#define FWK_ATTR_RO(_name)									struct fwk_attribute fwk_attr_##_name = __FWK_ATTR(_name, O_RDONLY, _name##_show, mrt_nullptr)
+#define FWK_ATTR_WO(_name)									struct fwk_attribute fwk_attr_##_name = __FWK_ATTR(_name, O_WRONLY, mrt_nullptr, _name##_store)
+#define FWK_ATTR_RW(_name)									struct fwk_attribute fwk_attr_##_name = __FWK_ATTR(_name, O_RDWR, _name##_show, _name##_store)
+
+/*!< The globals */
+TARGET_EXT struct fwk_kset *sprt_sys_fs;
+TARGET_EXT struct fwk_kset *sprt_devices_fs;
+
+/*!< The functions */
+TARGET_EXT kint32_t fwk_sysfs_create_file(struct fwk_kobject *sprt_kobj, struct fwk_attribute *sprt_attr);
+TARGET_EXT void fwk_sysfs_remove_file(struct fwk_kobject *sprt_kobj, struct fwk_attribute *sprt_attr);
+TARGET_EXT kint32_t fwk_sysfs_create_group(struct fwk_kobject *sprt_kobj, const struct fwk_attribute_group *sprt_grp);
+TARGET_EXT void fwk_sysfs_remove_group(struct fwk_kobject *sprt_kobj, const struct fwk_attribute_group *sprt_grp);
+TARGET_EXT kint32_t fwk_sysfs_iostats_create(struct fwk_inode *sprt_inode, const kchar_t *name);
+TARGET_EXT void fwk_sysfs_iostats_remove(const kchar_t *name);
+
+#endif /*!< __FWK_SYSFS_H_ */
@@ -17,14 +17,53 @@
 #include <platform/fwk_basic.h>
 
 /*!< The defines */
+/*!< mapping granularity of mmap */
+#define FWK_PAGE_SHIFT                                  (12)
+#define FWK_PAGE_SIZE                                   (1UL << FWK_PAGE_SHIFT)
+#define FWK_PAGE_MASK                                   (~(FWK_PAGE_SIZE - 1))
+#define mrt_page_align(x)                               mrt_align(x, FWK_PAGE_SIZE)
+#define mrt_page_aligned(x)                             (!((x) & ~FWK_PAGE_MASK))
+
+struct fwk_inode;
+struct fwk_vm_area;
+
+struct fwk_vm_oprts
+{
+    void (*close) (struct fwk_vm_area *);                   /*!< the last page of the mapping is unmapped */
+};
+
 struct fwk_vm_area
 {
-    kuaddr_t virt_addr;
-    kusize_t size;
+    kuaddr_t virt_addr;                                     /*!< start of the mapping, set by mmap op, and then aligned down to page */
+    kusize_t size;                                          /*!< page aligned */
+    kuint32_t page_off;                                     /*!< the caller gets virt_addr + page_off, if the memory is not page aligned */
+    kuint32_t offset;                                       /*!< offset in the device, page aligned */
+    kint32_t prot;
+    kint32_t flags;
+
+    struct fwk_inode *sprt_inode;
+    const struct fwk_vm_oprts *sprt_vmops;
+    void *private_data;
+
+    struct list_head sgrt_link;                             /*!< all mappings, the newest is the last */
+    struct list_head sgrt_ilink;                            /*!< mappings of the inode */
+};
+
+/*!< the maximum number of segments of readv/writev */
+#define FWK_IOV_MAX                                     (64)
+
+struct fwk_iovec
+{
+    void *iov_base;
+    kusize_t iov_len;
 };
 
 /*!< The functions */
 TARGET_EXT kusize_t fwk_copy_from_user(void *ptr_dst, const void *ptr_user, kusize_t size);
 TARGET_EXT kusize_t fwk_copy_to_user(void *ptr_user, void *ptr_Src, kusize_t size);
+TARGET_EXT kssize_t fwk_iov_length(const struct fwk_iovec *sprt_iov, kuint32_t nr_segs);
+TARGET_EXT kusize_t fwk_copy_from_iovec(void *ptr_dst, const struct fwk_iovec *sprt_iov, kuint32_t nr_segs, kusize_t size);
+TARGET_EXT kusize_t fwk_copy_to_iovec(const struct fwk_iovec *sprt_iov, kuint32_t nr_segs, void *ptr_src, kusize_t size);
+TARGET_EXT kint32_t fwk_vm_iomap_memory(struct fwk_vm_area *sprt_vma, kuaddr_t start, kusize_t len);
 
 #endif /*!< __FWK_UACCESS_H_ */
@@ -32,6 +32,8 @@ typedef struct fwk_irq_chip
 	kbool_t (*irq_ack) (struct fwk_irq_data *sprt_data);
 	kbool_t (*irq_is_enabled) (struct fwk_irq_data *sprt_data);
 	kint32_t (*irq_set_type) (struct fwk_irq_data *sprt_data, kuint32_t type);
+	void (*irq_set_priority) (struct fwk_irq_data *sprt_data, kuint32_t priority);
+	kbool_t (*irq_retrigger) (struct fwk_irq_data *sprt_data);
 
 } srt_fwk_irq_chip_t;
 
@@ -53,8 +55,10 @@ TARGET_EXT struct fwk_irq_chip sgrt_fwk_irq_generic_chip;
 TARGET_EXT void fwk_enable_irq(kint32_t irq);
 TARGET_EXT void fwk_disable_irq(kint32_t irq);
 TARGET_EXT void fwk_irq_set_type(kint32_t irq, kuint32_t flags);
+TARGET_EXT void fwk_irq_set_priority(kint32_t irq, kuint32_t priority);
 TARGET_EXT kbool_t fwk_irq_is_acked(kint32_t irq);
 TARGET_EXT kbool_t fwk_irq_is_enabled(kint32_t irq);
+TARGET_EXT kint32_t fwk_irq_trigger(kint32_t irq);
 
 TARGET_EXT void fwk_irq_setup_generic_chip(kint32_t irq_base, kuint32_t irq_max, struct fwk_irq_generic *sprt_gc, void *chip_data);
 TARGET_EXT void fwk_irq_shutdown_generic_chip(kint32_t irq_base, kuint32_t irq_max);
@@ -38,6 +38,42 @@ TARGET_EXT "C" {
 	} while (0)
 
 #define FWK_IRQ_DESC_NAME_LENTH					(16)
+#define FWK_IRQ_DESC_MAX						(1024)
+
+/*!< storm detection: if IRQ_STORM_THRESHOLD of IRQ_STORM_WINDOW interrupts are unhandled, the line is disabled (defaults, see /sys/irq/) */
+#define FWK_IRQ_STORM_WINDOW					(1000)
+#define FWK_IRQ_STORM_THRESHOLD					(990)
+
+/*!< 
+ * priority, passed to fwk_request_irq() within flags: IRQF_PRIORITY(prio)
+ * 0 is the highest, and 30 is the lowest (the GIC implements 5 bits, and 31 never passes C_PMR);
+ * an IRQ can only be preempted by the IRQs with higher priority
+ */
+#define FWK_IRQ_PRIORITY_HIGHEST				(0)
+#define FWK_IRQ_PRIORITY_HIGH					(8)
+#define FWK_IRQ_PRIORITY_DEFAULT				(16)
+#define FWK_IRQ_PRIORITY_LOW					(24)
+#define FWK_IRQ_PRIORITY_LOWEST					(30)
+
+#define IRQF_PRIORITY_SHIFT						(16)
+#define IRQF_PRIORITY_MASK						(0x1fU << IRQF_PRIORITY_SHIFT)
+#define IRQF_PRIORITY_VALID						(0x1U << 21)
+#define IRQF_PRIORITY(prio)						(IRQF_PRIORITY_VALID | mrt_bit_mask(prio, IRQF_PRIORITY_MASK, IRQF_PRIORITY_SHIFT))
+#define mrt_irqf_get_priority(flags)			(((flags) & IRQF_PRIORITY_MASK) >> IRQF_PRIORITY_SHIFT)
+
+/*!< 
+ * fwk_irq_desc::istate, lazy disable:
+ * fwk_disable_irq() only sets FWK_IRQS_DISABLED; if the interrupt arrives anyway, the hardware is masked
+ * then (FWK_IRQS_MASKED), and the interrupt is kept (FWK_IRQS_PENDING) to be replayed by fwk_enable_irq()
+ */
+#define FWK_IRQS_DISABLED						mrt_bit(0)
+#define FWK_IRQS_MASKED							mrt_bit(1)
+#define FWK_IRQS_PENDING						mrt_bit(2)
+
+/*!< irq_return_t: >= 0, the interrupt is handled; < 0, the device did not raise it */
+#define IRQ_NONE								(-1)
+#define IRQ_HANDLED								(0)
+#define IRQ_WAKE_THREAD							(1)
 
 typedef	kint32_t irq_return_t;
 typedef kint32_t (*irq_handler_t)(void *ptrDev);
@@ -51,6 +87,9 @@ typedef kint32_t (*irq_handler_t)(void *ptrDev);
 #define IRQ_TYPE_LEVEL_MASK						(IRQ_TYPE_LEVEL_LOW | IRQ_TYPE_LEVEL_HIGH)
 #define IRQ_TYPE_SENSE_MASK						(IRQ_TYPE_EDGE_BOTH | IRQ_TYPE_LEVEL_MASK)
 
+/*!< the line can be requested by several devices, every one must pass it, with the same trigger type */
+#define IRQF_SHARED								0x00000080
+
 typedef struct fwk_irq_data
 {
 	unsigned int irq;
@@ -72,24 +111,38 @@ typedef struct fwk_irq_action
 	kchar_t name[FWK_IRQ_DESC_NAME_LENTH];
 	irq_handler_t handler;
 	kuint32_t flags;
-	void *ptrArgs;
+	void *dev_id;								/*!< passed to handler, and identifies the action on a shared line */
 
 	struct list_head sgrt_link;
 
 } srt_fwk_irq_action_t;
 
+typedef struct fwk_irq_stats
+{
+	kuint32_t count;							/*!< interrupts dispatched */
+	kuint32_t unhandled;						/*!< interrupts no action claimed */
+	kuint32_t time_total;						/*!< cumulative handler time, in systick counter ticks */
+	kuint32_t time_max;							/*!< the longest handler time */
+
+	kuint32_t window;							/*!< for storm detection */
+	kuint32_t window_unhandled;
+	kbool_t storm_disabled;
+
+} srt_fwk_irq_stats_t;
+
 typedef struct fwk_irq_desc
 {
 	kint32_t irq;
 
 	kuint32_t flags;
+	kuint32_t istate;
 	kchar_t irq_name[FWK_IRQ_DESC_NAME_LENTH];
 	struct list_head sgrt_action;;
 
 	struct list_head sgrt_link;
-	struct radix_link sgrt_radix;
-	
+
 	struct fwk_irq_data sgrt_data;
+	struct fwk_irq_stats sgrt_stats;
 
 } srt_fwk_irq_desc_t;
 
@@ -110,7 +163,9 @@ TARGET_EXT kint32_t fwk_request_irq(kint32_t irq, irq_handler_t handler, kuint32
 TARGET_EXT void fwk_free_irq(kint32_t irq, void *ptrDev);
 TARGET_EXT void fwk_destroy_irq_action(kint32_t irq);
 TARGET_EXT void fwk_do_irq_handler(kint32_t softIrq);
+TARGET_EXT kbool_t fwk_irq_lazy_mask(struct fwk_irq_desc *sprt_desc);
 TARGET_EXT void fwk_handle_softirq(kint32_t softIrq, kuint32_t event);
+TARGET_EXT kssize_t fwk_irq_stats_show(kbuffer_t *buf, kssize_t size);
 
 #ifdef __cplusplus
 	}
@@ -68,8 +68,9 @@ void start_kernel(void)
     if (run_platform_initcall())
         goto fail;
 
-    /*!< enable interrupt */
+    /*!< enable interrupt; FIQ is only signaled after fwk_request_fiq() */
     mrt_enable_cpu_irq();
+    mrt_enable_cpu_fiq();
 
 #if CONFIG_SCHDULE
     /*!< create thread */
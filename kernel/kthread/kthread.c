@@ -22,8 +22,6 @@
 #define KERL_THREAD_STACK_SIZE                          REAL_THREAD_STACK_HALF(1)   /*!< 1/2 page (2 kbytes) */
 
 /*!< The globals */
-TARGET_EXT kuint32_t g_asm_sched_flag;
-
 static struct real_thread_attr sgrt_kthread_attr;
 static kuint32_t g_kthread_stack[KERL_THREAD_STACK_SIZE];
 static struct timer_list sgrt_kthread_timer;
@@ -64,7 +62,7 @@ static void kthread_schedule_timeout(kuint32_t args)
     /*!< there is a higher priority thread ready */
     if (__THREAD_IS_LOW_PRIO(work_prio, next_prio))
     {
-        g_asm_sched_flag = true;
+        mrt_set_need_resched();
         goto END;
     }
     
@@ -33,6 +33,7 @@ static struct scheduler_table sgrt_real_thread_Tabs =
 	.sprt_work		= mrt_nullptr,
 	.sprt_tids		= mrt_nullptr,
 	.sprt_tid_array	= { mrt_nullptr },
+	.wakeup_pending	= { 0 },
 	.sgrt_lock		= SPIN_LOCK_INIT(),
 };
 
@@ -45,6 +46,13 @@ static struct scheduler_table sgrt_real_thread_Tabs =
 
 #define __SCHED_LOCK								sgrt_real_thread_Tabs.sgrt_lock
 
+/*!< the wakeups recorded while the lock was held are done on release */
+#define __SCHED_UNLOCK()	\
+	do {	\
+		spin_unlock_irqrestore(&__SCHED_LOCK);	\
+		schedule_wakeup_pending();	\
+	} while (0)
+
 /*!< set thread status */
 #define __SET_THREAD_STATUS(tid, value)	\
 	do {	\
@@ -166,12 +174,12 @@ real_thread_t get_unused_tid_from_scheduler(kuint32_t i_start, kuint32_t count)
 	{
 		if (!SCHED_THREAD_HANDLER(i))
 		{
-			spin_unlock_irqrestore(&__SCHED_LOCK);
+			__SCHED_UNLOCK();
 			return i;
 		}
 	}
 
-	spin_unlock_irqrestore(&__SCHED_LOCK);
+	__SCHED_UNLOCK();
 
 	return -ER_MORE;
 }
@@ -208,7 +216,7 @@ kuint64_t scheduler_stats_get(void)
 
 	spin_lock_irqsave(&__SCHED_LOCK);
 	sum = (__REAL_THREAD_MAX_STATS * sprt_tab->sgrt_cnt.cnt_out + sprt_tab->sgrt_cnt.sched_cnt);
-	spin_unlock_irqrestore(&__SCHED_LOCK);
+	__SCHED_UNLOCK();
 
 	return sum;
 }
@@ -223,7 +231,28 @@ void schedule_self_suspend(void)
 {
 	spin_lock_irqsave(&__SCHED_LOCK);
 	__SET_THREAD_STATUS(SCHED_RUNNING_THREAD->tid, NR_THREAD_SUSPEND);
-	spin_unlock_irqrestore(&__SCHED_LOCK);
+	__SCHED_UNLOCK();
+
+    schedule_thread();
+}
+
+/*!
+ * @brief	suspend current thread, unless a wake_up has come
+ * @param  	none
+ * @retval 	none
+ * @note   	the wake_up flag is checked under the scheduler lock: a wake_up which lands after the caller's
+ * 			last check either is found here, or finds the thread suspended and makes it ready again;
+ * 			the flag is left for real_thread_state_pending()
+ */
+void schedule_self_suspend_wakeable(void)
+{
+	struct real_thread *sprt_thread;
+
+	spin_lock_irqsave(&__SCHED_LOCK);
+	sprt_thread = SCHED_RUNNING_THREAD;
+	if (!mrt_thread_is_flags(NR_THREAD_SIG_WAKEUP, sprt_thread))
+		__SET_THREAD_STATUS(sprt_thread->tid, NR_THREAD_SUSPEND);
+	__SCHED_UNLOCK();
 
     schedule_thread();
 }
@@ -248,7 +277,7 @@ kint32_t schedule_thread_suspend(real_thread_t tid)
     __SET_THREAD_STATUS(tid, NR_THREAD_SUSPEND);
 
 	retval = schedule_thread_switch(tid);
-	spin_unlock_irqrestore(&__SCHED_LOCK);
+	__SCHED_UNLOCK();
 	
 	return retval;
 }
@@ -273,12 +302,84 @@ kint32_t schedule_thread_wakeup(real_thread_t tid)
 
     __SET_THREAD_STATUS(tid, NR_THREAD_READY);
 	retval = schedule_thread_switch(tid);
+	if (!retval)
+		schedule_preempt_check(SCHED_THREAD_HANDLER(tid));
 
 END:
 //	spin_unlock(&__SCHED_LOCK);
 	return retval;
 }
 
+/*!
+ * @brief	wake up a suspended thread, from any context
+ * @param  	tid: target thread
+ * @retval 	none
+ * @note   	if the scheduler lock is held (e.g. an ISR interrupted its owner), the wakeup is recorded
+ * 			and done when the owner releases the lock, instead of being dropped
+ */
+void schedule_thread_wakeup_async(real_thread_t tid)
+{
+	kuint32_t flags;
+
+	if ((tid < 0) || (tid >= REAL_THREAD_MAX_NUM))
+		return;
+
+	/*!< a nested ISR may record another wakeup at the same time */
+	mrt_local_irq_save(flags);
+	bitmap_set(sgrt_real_thread_Tabs.wakeup_pending, tid, 1);
+	mrt_local_irq_restore(flags);
+
+	schedule_wakeup_pending();
+}
+
+/*!
+ * @brief	do the wakeups recorded by schedule_thread_wakeup_async()
+ * @param  	none
+ * @retval 	none
+ * @note   	if the lock is held, nothing is done here; its owner calls this again on release
+ */
+void schedule_wakeup_pending(void)
+{
+	kint32_t tid;
+
+	if (spin_try_lock_irqsave(&__SCHED_LOCK))
+		return;
+
+	while ((tid = find_first_bit(sgrt_real_thread_Tabs.wakeup_pending, REAL_THREAD_MAX_NUM)) >= 0)
+	{
+		bitmap_clear(sgrt_real_thread_Tabs.wakeup_pending, tid, 1);
+
+		/*!< the thread may have been woken up by others, or never suspended */
+		if (SCHED_THREAD_HANDLER(tid))
+			schedule_thread_wakeup(tid);
+	}
+
+	/*!< irq is disabled while the lock is held, nothing can be recorded before the release */
+	spin_unlock_irqrestore(&__SCHED_LOCK);
+}
+
+/*!
+ * @brief	request a switch if a ready thread outranks the running one
+ * @param  	sprt_thread: thread just made ready
+ * @retval 	none
+ * @note   	the switch happens on the IRQ return path; so a wakeup from ISR does not wait for the next time slice check
+ */
+void schedule_preempt_check(struct real_thread *sprt_thread)
+{
+	struct real_thread *sprt_running = SCHED_RUNNING_THREAD;
+	kuint32_t work_prio, next_prio;
+
+	if (!sprt_thread || !sprt_running || (sprt_thread == sprt_running))
+		return;
+
+	work_prio = real_thread_get_priority(sprt_running->sprt_attr);
+	next_prio = real_thread_get_priority(sprt_thread->sprt_attr);
+
+	/*!< strictly higher: the same priority still waits for the time slice */
+	if (!__THREAD_IS_LOW_PRIO(next_prio, work_prio))
+		mrt_set_need_resched();
+}
+
 /*!
  * @brief	check if ready list is empty
  * @param  	none
@@ -804,13 +905,13 @@ kint32_t register_new_thread(struct real_thread *sprt_thread, real_thread_t tid)
 	if (retval < 0)
 	{
 		SCHED_THREAD_HANDLER(tid) = mrt_nullptr;
-		spin_unlock_irqrestore(&__SCHED_LOCK);
+		__SCHED_UNLOCK();
 		return retval;
 	}
 
 	/*!< set to ready status */
     __SYNC_THREAD_STATUS(tid, NR_THREAD_READY);
-	spin_unlock_irqrestore(&__SCHED_LOCK);
+	__SCHED_UNLOCK();
 
 	return ER_NORMAL;
 }
@@ -910,14 +1011,14 @@ void schedule_thread(void)
     if (!sprt_context)
         goto END;
 
-	spin_unlock_irqrestore(&__SCHED_LOCK);
+	__SCHED_UNLOCK();
 
 	/*!< sprt_context ===> r0 */
 	context_switch(sprt_context);
 	return;
 
 END:
-	spin_unlock_irqrestore(&__SCHED_LOCK);
+	__SCHED_UNLOCK();
 }
 
 /*!< end of file */
@@ -31,22 +31,19 @@
 static void real_thread_sleep_timeout(kuint32_t args)
 {
     struct real_thread *sprt_thread = (struct real_thread *)args;
-    struct spin_lock *sprt_lock = scheduler_lock();
-
-    if (spin_is_locked(sprt_lock))
-		return;
 
     if (sprt_thread->status == NR_THREAD_SUSPEND)
-        schedule_thread_wakeup(sprt_thread->tid);
+        schedule_thread_wakeup_async(sprt_thread->tid);
 }
 
 /*!
  * @brief   setup timer for sleeping
  * @param   count
+ * @param   wakeable: do not suspend if a wake_up has come (see schedule_self_suspend_wakeable)
  * @retval  none
  * @note    delay and schedule (current thread may convert to suspend status)
  */
-void schedule_timeout(kutime_t count)
+static void __schedule_timeout(kutime_t count, kbool_t wakeable)
 {
     struct timer_list sgrt_tm;
     struct real_thread *sprt_thread = mrt_current;
@@ -58,14 +55,41 @@ void schedule_timeout(kutime_t count)
 	spin_lock_irqsave(sprt_lock);
     setup_timer(&sgrt_tm, real_thread_sleep_timeout, (kuint32_t)sprt_thread);
     spin_unlock_irqrestore(sprt_lock);
+    schedule_wakeup_pending();
     
     mod_timer(&sgrt_tm, count);
     /*!< suspend current thread, and schedule others */
-    schedule_self_suspend();
+    if (wakeable)
+        schedule_self_suspend_wakeable();
+    else
+        schedule_self_suspend();
     
     spin_lock_irqsave(sprt_lock);
     del_timer(&sgrt_tm);
     spin_unlock_irqrestore(sprt_lock);
+    schedule_wakeup_pending();
+}
+
+/*!
+ * @brief   setup timer for sleeping
+ * @param   count
+ * @retval  none
+ * @note    delay and schedule (current thread may convert to suspend status)
+ */
+void schedule_timeout(kutime_t count)
+{
+    __schedule_timeout(count, false);
+}
+
+/*!
+ * @brief   setup timer for sleeping, unless a wake_up has come
+ * @param   count
+ * @retval  none
+ * @note    for waiters which check their condition before sleeping, so that a wake_up in between is not lost
+ */
+void schedule_timeout_wakeable(kutime_t count)
+{
+    __schedule_timeout(count, true);
 }
 
 /*!
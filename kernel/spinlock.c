@@ -92,8 +92,9 @@ kint32_t spin_try_lock(struct spin_lock *sprt_lock)
  */
 void spin_lock_irq(struct spin_lock *sprt_lock)
 {
-    spin_lock(sprt_lock);
+    /*!< irq is disabled first, an ISR taking the same lock can not come in while it is held */
     mrt_disable_cpu_irq();
+    spin_lock(sprt_lock);
 }
 
 /*!
@@ -104,11 +105,15 @@ void spin_lock_irq(struct spin_lock *sprt_lock)
  */
 kint32_t spin_try_lock_irq(struct spin_lock *sprt_lock)
 {
+    mrt_disable_cpu_irq();
+    mrt_barrier();
+
     if (spin_try_lock(sprt_lock))
+    {
+        mrt_enable_cpu_irq();
         return -ER_LOCKED;
+    }
 
-    mrt_barrier();
-    mrt_disable_cpu_irq();
     return ER_NORMAL;
 }
 
@@ -136,9 +141,14 @@ void spin_unlock_irq(struct spin_lock *sprt_lock)
  */
 void spin_lock_irqsave(struct spin_lock *sprt_lock)
 {
+    kuint32_t flags;
+
+    /*!< irq is disabled first, an ISR taking the same lock can not come in while it is held */
+    mrt_local_irq_save(flags);
     spin_lock(sprt_lock);
-    sprt_lock->flag = __get_cpsr();
-    mrt_disable_cpu_irq();
+
+    /*!< flag belongs to the owner, it is written only after the lock is taken */
+    sprt_lock->flag = flags;
 }
 
 /*!
@@ -149,14 +159,18 @@ void spin_lock_irqsave(struct spin_lock *sprt_lock)
  */
 kint32_t spin_try_lock_irqsave(struct spin_lock *sprt_lock)
 {
+    kuint32_t flags;
+
+    mrt_local_irq_save(flags);
+    mrt_barrier();
+
     if (spin_try_lock(sprt_lock))
+    {
+        mrt_local_irq_restore(flags);
         return -ER_LOCKED;
+    }
 
-    sprt_lock->flag = __get_cpsr();
-    sprt_lock->flag &= CPSR_BIT_I;
-
-    mrt_barrier();
-    mrt_disable_cpu_irq();
+    sprt_lock->flag = flags;
 
     return ER_NORMAL;
 }
@@ -169,17 +183,20 @@ kint32_t spin_try_lock_irqsave(struct spin_lock *sprt_lock)
  */
 void spin_unlock_irqrestore(struct spin_lock *sprt_lock)
 {
+    kuint32_t flags;
+
     if (!spin_is_locked(sprt_lock))
         return;
+
+    /*!< the next owner overwrites flag, so take it before unlock */
+    flags = sprt_lock->flag;
+    sprt_lock->flag = 0;
     
     spin_unlock(sprt_lock);
     mrt_barrier();
 
-    /*!< bit4 ~ bit0 is mode bit, which are not equaled to 0 */
-    if (sprt_lock->flag & CPSR_BIT_I)
-        mrt_enable_cpu_irq();
-
-    sprt_lock->flag = 0;
+    /*!< irq is enabled again only if it was enabled before spin_lock_irqsave */
+    mrt_local_irq_restore(flags);
 }
 
 /*!< end of file */
@@ -75,6 +75,15 @@ static void __wake_up_common(struct real_thread *sprt_thread, kuint32_t state)
         return;
     
     real_thread_state_signal(sprt_thread, NR_THREAD_SIG_WAKEUP, true);
+
+    /*!< 
+     * a waiter in schedule_timeout() is made ready at once, instead of on its timeout;
+     * and if it outranks the running thread, it runs on the IRQ return path
+     */
+    if (sprt_thread->status == NR_THREAD_SUSPEND)
+        schedule_thread_wakeup_async(sprt_thread->tid);
+    else if (sprt_thread->status == NR_THREAD_READY)
+        schedule_preempt_check(sprt_thread);
 }
 
 /*!
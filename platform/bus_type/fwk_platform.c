@@ -16,6 +16,7 @@
 #include <platform/fwk_platdrv.h>
 #include <platform/fwk_pinctrl.h>
 #include <platform/fwk_inode.h>
+#include <platform/fwk_sysfs.h>
 
 /*!<
  * One device can only be matched with one driver
@@ -271,8 +272,13 @@ struct fwk_device *fwk_device_create(kuint32_t type, kuint32_t devNum, kchar_t *
 		goto fail1;
 
 	if (sprt_kobj->sprt_inode->type == INODE_TYPE_FILE)
+	{
 		fwk_inode_set_ops(sprt_kobj->sprt_inode, type, devNum);
 
+		/*!< I/O statistics are optional, the device works without them */
+		fwk_sysfs_iostats_create(sprt_kobj->sprt_inode, name);
+	}
+
 	sprt_dev = kzalloc(sizeof(*sprt_dev), GFP_KERNEL);
 	if (!isValid(sprt_dev))
 		goto fail2;
@@ -292,6 +298,7 @@ fail4:
 fail3:
 	kfree(sprt_dev);
 fail2:
+	fwk_sysfs_iostats_remove(name);
 	fwk_kset_kobject_remove(sprt_kobj);
 fail1:
 	kfree(name);
@@ -320,6 +327,7 @@ kint32_t fwk_device_destroy(struct fwk_device *sprt_dev)
 	if (!isValid(sprt_kobj))
 		return -ER_NOTFOUND;
 
+	fwk_sysfs_iostats_remove(mrt_dev_get_name(sprt_dev));
 	fwk_device_del(sprt_dev);
 	fwk_kset_kobject_remove(sprt_kobj);
 
@@ -16,6 +16,9 @@
 /*!< The globals */
 struct fwk_char_device *sgrt_fwk_chrdevs[DEVICE_MAX_NUM];
 
+/*!< bit n is set if major n has any device registered */
+static DECLARE_BITMAP(sgrt_fwk_chrdev_majors, DEVICE_MAX_NUM);
+
 /*!< The functions */
 static struct fwk_char_device *__fwk_register_chrdev(kuint32_t major, kuint32_t baseminor, kuint32_t count, const kchar_t *name);
 static struct fwk_char_device *__fwk_unregister_chrdev(kuint32_t major, kuint32_t baseminor, kuint32_t count);
@@ -39,6 +42,8 @@ kint32_t __plat_init fwk_chrdev_init(void)
 	for (i = 0; i < chrdevMax; i++)
 		*(sprt_chrdev++) = mrt_nullptr;
 
+	bitmap_clear(sgrt_fwk_chrdev_majors, 0, DEVICE_MAX_NUM);
+
 	return ER_NORMAL;
 }
 
@@ -64,6 +69,8 @@ void __plat_exit fwk_chrdev_exit(void)
 		mrt_list_delete_all(*sprt_chrdev, sprt_prev, sprt_list);
 		*sprt_chrdev = mrt_nullptr;
 	}
+
+	bitmap_clear(sgrt_fwk_chrdev_majors, 0, DEVICE_MAX_NUM);
 }
 
 /*!
@@ -87,18 +94,12 @@ static struct fwk_char_device *__fwk_register_chrdev(kuint32_t major, kuint32_t
 
 	if (!major)
 	{
-		sprt_Dst = &sgrt_fwk_chrdevs[chrdevMax - 1];
-
 		/*!< 
 		 * The composite value of the Major + Minor must be less than 2^32, 
-		 * that is, the number of primary device numbers and secondary device numbers is limited 
+		 * that is, the number of primary device numbers and secondary device numbers is limited;
+		 * The majors below NR_CHRDEV_MAJOR_MAX are reserved for the static ones
 		 */
-		for (i = (chrdevMax - 1); i >= 0; i--)
-		{
-			if (!(*(sprt_Dst--)))
-				break;
-		}
-
+		i = find_next_zero_bit(sgrt_fwk_chrdev_majors, chrdevMax, NR_CHRDEV_MAJOR_MAX);
 		if (i < 0)
 			return mrt_nullptr;
 
@@ -178,6 +179,7 @@ static struct fwk_char_device *__fwk_register_chrdev(kuint32_t major, kuint32_t
 	*sprt_Dst = sprt_chrdev;
 
 chrget:
+	bitmap_set(sgrt_fwk_chrdev_majors, major, 1);
 	return sprt_chrdev;
 
 fail:
@@ -222,6 +224,10 @@ static struct fwk_char_device *__fwk_unregister_chrdev(kuint32_t major, kuint32_
 		}
 	}
 
+	/*!< The last device of this major is gone, it can be allocated dynamically again */
+	if (!sgrt_fwk_chrdevs[index])
+		bitmap_clear(sgrt_fwk_chrdev_majors, major, 1);
+
 	return sprt_Rlt;
 }
 
@@ -228,26 +228,139 @@ static kint32_t fwk_fb_close(struct fwk_inode *sprt_inode, struct fwk_file *sprt
 	return ER_NORMAL;
 }
 
+/*!
+ * @brief   get the size of framebuffer memory
+ * @param   sprt_info
+ * @retval  size
+ * @note    none
+ */
+static kssize_t fwk_fb_get_screen_size(struct fwk_fb_info *sprt_info)
+{
+	return sprt_info->screen_size ? sprt_info->screen_size : sprt_info->sgrt_fix.smem_len;
+}
+
+/*!
+ * @brief   get the base address of framebuffer memory
+ * @param   sprt_info
+ * @retval  base address
+ * @note    smem_start is accessed directly if the driver has not mapped it, as fwk_fb_mmap() does
+ */
+static kuint8_t *fwk_fb_get_screen_base(struct fwk_fb_info *sprt_info)
+{
+	return sprt_info->ptr_screen_base ? sprt_info->ptr_screen_base : (kuint8_t *)sprt_info->sgrt_fix.smem_start;
+}
+
+/*!
+ * @brief   fwk_fb_llseek
+ * @param   sprt_file, offset, whence
+ * @retval  new offset
+ * @note    none
+ */
+static kloff_t fwk_fb_llseek(struct fwk_file *sprt_file, kloff_t offset, kint32_t whence)
+{
+	struct fwk_fb_info *sprt_info;
+
+	sprt_info = (struct fwk_fb_info *)sprt_file->private_data;
+	if (!isValid(sprt_info))
+		return -ER_FAULT;
+
+	return fwk_generic_file_llseek(sprt_file, offset, whence, fwk_fb_get_screen_size(sprt_info));
+}
+
 /*!
  * @brief   fwk_fb_write
- * @param   none
- * @retval  none
+ * @param   sprt_file, ptr_buf, size, pos
+ * @retval  bytes written to the framebuffer memory
  * @note    none
  */
-static kssize_t fwk_fb_write(struct fwk_file *sprt_file, const kbuffer_t *ptr_buf, kssize_t size)
+static kssize_t fwk_fb_write(struct fwk_file *sprt_file, const kbuffer_t *ptr_buf, kssize_t size, kloff_t *pos)
 {
-	return ER_NORMAL;
+	struct fwk_fb_info *sprt_info;
+
+	sprt_info = (struct fwk_fb_info *)sprt_file->private_data;
+	if (!isValid(sprt_info) || !fwk_fb_get_screen_base(sprt_info))
+		return -ER_FAULT;
+
+	return fwk_simple_write_to_buffer(fwk_fb_get_screen_base(sprt_info), fwk_fb_get_screen_size(sprt_info), pos, ptr_buf, size);
 }
 
 /*!
  * @brief   fwk_fb_read
- * @param   none
- * @retval  none
+ * @param   sprt_file, ptr_buf, size, pos
+ * @retval  bytes read from the framebuffer memory
  * @note    none
  */
-static kssize_t fwk_fb_read(struct fwk_file *sprt_file, kbuffer_t *ptr_buf, kssize_t size)
+static kssize_t fwk_fb_read(struct fwk_file *sprt_file, kbuffer_t *ptr_buf, kssize_t size, kloff_t *pos)
 {
-	return ER_NORMAL;
+	struct fwk_fb_info *sprt_info;
+
+	sprt_info = (struct fwk_fb_info *)sprt_file->private_data;
+	if (!isValid(sprt_info) || !fwk_fb_get_screen_base(sprt_info))
+		return -ER_FAULT;
+
+	return fwk_simple_read_from_buffer(ptr_buf, size, pos, fwk_fb_get_screen_base(sprt_info), fwk_fb_get_screen_size(sprt_info));
+}
+
+/*!
+ * @brief   fwk_fb_write_iter
+ * @param   sprt_file, sprt_iov, nr_segs, pos
+ * @retval  bytes written to the framebuffer memory
+ * @note    all segments are copied in one call, such as a header and the pixels
+ */
+static kssize_t fwk_fb_write_iter(struct fwk_file *sprt_file, const struct fwk_iovec *sprt_iov, kuint32_t nr_segs, kloff_t *pos)
+{
+	struct fwk_fb_info *sprt_info;
+	kssize_t count, total = 0;
+	kuint32_t idx;
+
+	sprt_info = (struct fwk_fb_info *)sprt_file->private_data;
+	if (!isValid(sprt_info) || !fwk_fb_get_screen_base(sprt_info))
+		return -ER_FAULT;
+
+	for (idx = 0; idx < nr_segs; idx++)
+	{
+		count = fwk_simple_write_to_buffer(fwk_fb_get_screen_base(sprt_info), fwk_fb_get_screen_size(sprt_info), 
+										pos, sprt_iov[idx].iov_base, sprt_iov[idx].iov_len);
+		if (count < 0)
+			return total ? total : count;
+
+		total += count;
+		if (count < (kssize_t)sprt_iov[idx].iov_len)
+			break;
+	}
+
+	return total;
+}
+
+/*!
+ * @brief   fwk_fb_read_iter
+ * @param   sprt_file, sprt_iov, nr_segs, pos
+ * @retval  bytes read from the framebuffer memory
+ * @note    none
+ */
+static kssize_t fwk_fb_read_iter(struct fwk_file *sprt_file, const struct fwk_iovec *sprt_iov, kuint32_t nr_segs, kloff_t *pos)
+{
+	struct fwk_fb_info *sprt_info;
+	kssize_t count, total = 0;
+	kuint32_t idx;
+
+	sprt_info = (struct fwk_fb_info *)sprt_file->private_data;
+	if (!isValid(sprt_info) || !fwk_fb_get_screen_base(sprt_info))
+		return -ER_FAULT;
+
+	for (idx = 0; idx < nr_segs; idx++)
+	{
+		count = fwk_simple_read_from_buffer(sprt_iov[idx].iov_base, sprt_iov[idx].iov_len, 
+										pos, fwk_fb_get_screen_base(sprt_info), fwk_fb_get_screen_size(sprt_info));
+		if (count < 0)
+			return total ? total : count;
+
+		total += count;
+		if (count < (kssize_t)sprt_iov[idx].iov_len)
+			break;
+	}
+
+	return total;
 }
 
 /*!
@@ -297,9 +410,9 @@ static kint32_t fwk_fb_ioctl(struct fwk_file *sprt_file, kuint32_t cmd, kuaddr_t
 
 /*!
  * @brief   fwk_fb_mmap
- * @param   none
- * @retval  none
- * @note    none
+ * @param   sprt_file, vm_area: offset and size are requested
+ * @retval  errno
+ * @note    the video memory is mapped at page granularity, unless the driver maps it by itself
  */
 static kint32_t fwk_fb_mmap(struct fwk_file *sprt_file, struct fwk_vm_area *vm_area)
 {
@@ -318,20 +431,23 @@ static kint32_t fwk_fb_mmap(struct fwk_file *sprt_file, struct fwk_vm_area *vm_a
 			/*!< Open fb device failed */
 			return -ER_ERROR;
 		}
-	}
 
-	vm_area->virt_addr = sprt_info->sgrt_fix.smem_start;
-	vm_area->size = sprt_info->sgrt_fix.smem_len;
+		if (vm_area->virt_addr)
+			return ER_NORMAL;
+	}
 
-	return ER_NORMAL;
+	return fwk_vm_iomap_memory(vm_area, sprt_info->sgrt_fix.smem_start, sprt_info->sgrt_fix.smem_len);
 }
 
 static struct fwk_file_oprts sgrt_fwk_fb_foprts =
 {
 	.open	= fwk_fb_open,
 	.close	= fwk_fb_close,
+	.llseek	= fwk_fb_llseek,
 	.write	= fwk_fb_write,
 	.read	= fwk_fb_read,
+	.write_iter	= fwk_fb_write_iter,
+	.read_iter	= fwk_fb_read_iter,
 	.unlocked_ioctl	= fwk_fb_ioctl,
 	.mmap	= fwk_fb_mmap,
 };
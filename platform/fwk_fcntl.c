@@ -19,20 +19,35 @@
 #include <platform/fwk_fcntl.h>
 #include <kernel/spinlock.h>
 
+/*!< The defines */
+#define mrt_file_iostat(file, op)							((file)->sprt_inode ? &(file)->sprt_inode->sgrt_iostats.op : mrt_nullptr)
+
 /*!< The globals */
 static struct fwk_file_table sgrt_fwk_file_table =
 {
-	.max_fdarr	= 0,
-	.max_fds	= FILE_DESC_NUM_MAX,
-	.max_fdset	= -1,
-	.ref_fdarr	= 0,
+	.sprt_fdt	= &sgrt_fwk_file_table.sgrt_fdtab,
+	.next_fd	= 0,
+
+	.sgrt_fdtab	=
+	{
+		.max_fds		= FILE_DESC_NUM_MAX,
+		.fd				= sgrt_fwk_file_table.fd_array,
+		.open_fds		= sgrt_fwk_file_table.open_fds_init,
+		.close_on_exec	= sgrt_fwk_file_table.close_on_exec_init,
+		.sprt_old		= mrt_nullptr,
+	},
 
-	.fds		= mrt_nullptr,
 	.fd_array	= { mrt_nullptr },
+	.open_fds_init	= { 0 },
+	.close_on_exec_init	= { 0 },
 
 	.sgrt_mutex	= MUTEX_LOCK_INIT(),
 };
 
+/*!< all mappings */
+static DECLARE_LIST_HEAD(sgrt_fwk_vm_list);
+static struct mutex_lock sgrt_fwk_vm_mutex = MUTEX_LOCK_INIT();
+
 static struct fwk_file sgrt_fwk_file_stdio[DEVICE_MAJOR_BASE] =
 {
 	{
@@ -59,28 +74,24 @@ static struct fwk_file sgrt_fwk_file_stdio[DEVICE_MAJOR_BASE] =
 kint32_t __plat_init fwk_file_system_init(void)
 {
 	struct fwk_file_table *sprt_table;
+	struct fwk_fdtable *sprt_fdt;
 	kusize_t  num_farray;
 	kuint32_t fileCnt;
 
 	sprt_table = &sgrt_fwk_file_table;
-	num_farray = ARRAY_SIZE(sprt_table->fd_array);
-
-	if (!sprt_table->max_fds)
-		sprt_table->max_fds	= num_farray;
-
-	sprt_table->max_fdarr = mrt_ret_min2(sprt_table->max_fds, num_farray);
+	sprt_fdt = &sprt_table->sgrt_fdtab;
 	num_farray = ARRAY_SIZE(sgrt_fwk_file_stdio);
 
-	if (sprt_table->max_fdarr < num_farray)
+	if (sprt_fdt->max_fds < num_farray)
 		return -ER_MORE;
 
 	/*!< Occupy the top three */
 	for (fileCnt = 0; fileCnt < num_farray; fileCnt++)
-		sprt_table->fd_array[fileCnt] = &sgrt_fwk_file_stdio[fileCnt];
+		sprt_fdt->fd[fileCnt] = &sgrt_fwk_file_stdio[fileCnt];
 
-	sprt_table->max_fds		= sprt_table->max_fdarr;
-	sprt_table->ref_fdarr	= fileCnt;
-	sprt_table->max_fdset 	= CMP_GT2(num_farray, 0, num_farray - 1, sprt_table->max_fdset);
+	bitmap_set(sprt_fdt->open_fds, 0, num_farray);
+	sprt_table->next_fd = num_farray;
+	sprt_table->sprt_fdt = sprt_fdt;
 
 	mutex_init(&sprt_table->sgrt_mutex);
 
@@ -88,122 +99,91 @@ kint32_t __plat_init fwk_file_system_init(void)
 }
 
 /*!
- * @brief   fwk_get_expand_fdtable
- * @param   none
- * @retval  none
- * @note    none
+ * @brief   fwk_expand_fdtable
+ * @param   sprt_table
+ * @retval  errno
+ * @note    double the current table; must be called with sgrt_mutex held.
+ *          The old table is not freed, since fwk_fd_to_file() may still be reading it without lock;
+ *          as the size is doubled every time, all of the old tables take less memory than the current one.
  */
-static kint32_t fwk_get_expand_fdtable(struct fwk_file_table *sprt_table, kuint32_t flags)
+static kint32_t fwk_expand_fdtable(struct fwk_file_table *sprt_table)
 {
-	kint32_t index;
-
-	/*!< Created for the first time */
-	if (!isValid(sprt_table->fds))
-		sprt_table->fds	= (struct fwk_file **)kcalloc(sizeof(struct fwk_file), FILE_DESC_EXP_NUM, GFP_KERNEL);
-
-	/*!< It still doesn't exist after it was created */
-	if (!isValid(sprt_table->fds))
-		goto fail;
-
-	/*!< Fetch an unused index from fds */
-	for (index = 0; index < FILE_DESC_EXP_NUM; index++)
-	{
-		if (!sprt_table->fds[index])
-			goto fdget;
-	}
-
-	/*!< Not found */
-	goto fail;
-
-fdget:
-	index += sprt_table->max_fdarr;
-	sprt_table->max_fdset = mrt_ret_max2(sprt_table->max_fdset, index);
-	sprt_table->max_fds	= sprt_table->max_fdarr	+ FILE_DESC_EXP_NUM;
-
-	return index;
+	struct fwk_fdtable *sprt_old, *sprt_new;
+	kint32_t max_fds;
+	kusize_t words;
 
-fail:
-	return -ER_ERROR;
-}
+	sprt_old = sprt_table->sprt_fdt;
+	if (sprt_old->max_fds >= FILE_DESC_NUM_LIMIT)
+		return -ER_MORE;
 
-/*!
- * @brief   fwk_put_expand_fdtable
- * @param   none
- * @retval  none
- * @note    none
- */
-static void fwk_put_expand_fdtable(struct fwk_file_table *sprt_table, kint32_t fd)
-{
-	kint32_t index;
+	max_fds	= mrt_ret_min2(sprt_old->max_fds << 1, FILE_DESC_NUM_LIMIT);
+	words = mrt_bitmap_words(max_fds);
 
-	/*!< The array does not exist */
-	if (!isValid(sprt_table->fds) || (fd < sprt_table->max_fdarr))
-		return;
+	/*!< table, fd array and bitmaps are in one block */
+	sprt_new = (struct fwk_fdtable *)kzalloc(sizeof(*sprt_new) +
+						max_fds * sizeof(struct fwk_file *) + ((words * sizeof(kuint32_t)) << 1), GFP_KERNEL);
+	if (!isValid(sprt_new))
+		return -ER_NOMEM;
 
-	index = fd - sprt_table->max_fdarr;
-	sprt_table->fds[index] = mrt_nullptr;
+	sprt_new->max_fds = max_fds;
+	sprt_new->fd = (struct fwk_file **)(sprt_new + 1);
+	sprt_new->open_fds = (kuint32_t *)(sprt_new->fd + max_fds);
+	sprt_new->close_on_exec = sprt_new->open_fds + words;
+	sprt_new->sprt_old = sprt_old;
 
-	sprt_table->max_fdset = CMP_GTS(sprt_table->max_fdset, fd, fd - 1);
+	words = mrt_bitmap_words(sprt_old->max_fds);
+	memory_copy(sprt_new->fd, sprt_old->fd, sprt_old->max_fds * sizeof(struct fwk_file *));
+	memory_copy(sprt_new->open_fds, sprt_old->open_fds, words * sizeof(kuint32_t));
+	memory_copy(sprt_new->close_on_exec, sprt_old->close_on_exec, words * sizeof(kuint32_t));
 
-	/*!< The extended array has all been emptied. Free up space and save memory */
-	if (!index)
-	{
-		kfree(sprt_table->fds);
+	/*!< the new table must be visible before it is published */
+	mrt_dmb();
+	*(struct fwk_fdtable * volatile *)&sprt_table->sprt_fdt = sprt_new;
 
-		sprt_table->fds 	= mrt_nullptr;
-		sprt_table->max_fds = sprt_table->max_fdarr;
-	}
+	return ER_NORMAL;
 }
 
 /*!
  * @brief   fwk_get_unused_fd_flags
- * @param   none
- * @retval  none
- * @note    none
+ * @param   flags: open mode, O_CLOEXEC is recorded
+ * @retval  fd, or errno
+ * @note    the lowest free fd is taken
  */
 static kint32_t fwk_get_unused_fd_flags(kuint32_t flags)
 {
 	struct fwk_file_table *sprt_table;
-	kint32_t index;
+	struct fwk_fdtable *sprt_fdt;
+	kint32_t index, retval;
 
 	sprt_table = &sgrt_fwk_file_table;
 
-	/*!< Check if fd_array are fully assigned */
-	index = fwk_get_fd_available(sprt_table);
-	if (index < 0)
-		goto expand;
-
 	mutex_lock(&sprt_table->sgrt_mutex);
 
-	/*!< Priority is given to backward allocation */
-	index = CMP_LTS(sprt_table->max_fdset + 1, sprt_table->max_fdarr, -1);
-	if (index >= 0)
-	{
-		sprt_table->max_fdset++;
-		goto fdget;
-	}
-
-	/*!< Fetch an unused index from the file_array */
-	for (index = 0; index < sprt_table->max_fdset; index++)
+	sprt_fdt = sprt_table->sprt_fdt;
+	index = find_next_zero_bit(sprt_fdt->open_fds, sprt_fdt->max_fds, sprt_table->next_fd);
+	if (index < 0)
 	{
-		if (!sprt_table->fd_array[index])
-			goto fdget;
-	}
+		/*!< fd has run out, all of the old ones are still in use, the first new one is free */
+		index = sprt_fdt->max_fds;
 
-	mutex_unlock(&sprt_table->sgrt_mutex);
+		retval = fwk_expand_fdtable(sprt_table);
+		if (retval)
+		{
+			mutex_unlock(&sprt_table->sgrt_mutex);
+			return retval;
+		}
 
-	/*!< Fail: fwk_get_fd_available check failed || RET_MIN_SUPER fail to get || for loop calls the overrun */
-	return -ER_MORE;
+		sprt_fdt = sprt_table->sprt_fdt;
+	}
 
-fdget:
-	fwk_fdtable_get(sprt_table);
-	mutex_unlock(&sprt_table->sgrt_mutex);
+	mrt_setbit_towords(index, sprt_fdt->open_fds);
+	if (flags & O_CLOEXEC)
+		mrt_setbit_towords(index, sprt_fdt->close_on_exec);
+	else
+		mrt_clrbit_towords(index, sprt_fdt->close_on_exec);
 
-	return index;
+	sprt_table->next_fd = index + 1;
 
-expand:
-	/*!< fd has run out */
-	index = fwk_get_expand_fdtable(sprt_table, flags);
 	mutex_unlock(&sprt_table->sgrt_mutex);
 
 	return index;
@@ -211,102 +191,89 @@ expand:
 
 /*!
  * @brief   fwk_put_used_fd_flags
- * @param   none
+ * @param   fd
  * @retval  none
  * @note    none
  */
 static void fwk_put_used_fd_flags(kint32_t fd)
 {
 	struct fwk_file_table *sprt_table;
-	kint32_t index;
+	struct fwk_fdtable *sprt_fdt;
 
 	if (FILE_DESC_OVER_BASE(fd))
 		return;
 
 	sprt_table = &sgrt_fwk_file_table;
-	index = fd;
-
-	if (index >= sprt_table->max_fdarr)
-		goto expand;
 
 	mutex_lock(&sprt_table->sgrt_mutex);
 
-	sprt_table->fd_array[index]	= mrt_nullptr;
-	sprt_table->max_fdset = CMP_GTS(sprt_table->max_fdset, fd, fd - 1);
-	fwk_fdtable_put(sprt_table);
-
-	mutex_unlock(&sprt_table->sgrt_mutex);
+	sprt_fdt = sprt_table->sprt_fdt;
+	if (fd < sprt_fdt->max_fds)
+	{
+		sprt_fdt->fd[fd] = mrt_nullptr;
+		mrt_clrbit_towords(fd, sprt_fdt->open_fds);
+		mrt_clrbit_towords(fd, sprt_fdt->close_on_exec);
 
-	return;
+		if (fd < sprt_table->next_fd)
+			sprt_table->next_fd = fd;
+	}
 
-expand:
-	mutex_lock(&sprt_table->sgrt_mutex);
-	/*!< fd has run out */
-	fwk_put_expand_fdtable(sprt_table, fd);
 	mutex_unlock(&sprt_table->sgrt_mutex);
 }
 
 /*!
  * @brief   fwk_fd_install
- * @param   none
- * @retval  none
- * @note    none
+ * @param   fd, sprt_file
+ * @retval  errno
+ * @note    fd must be allocated by fwk_get_unused_fd_flags
  */
 static kint32_t fwk_fd_install(kint32_t fd, struct fwk_file *sprt_file)
 {
 	struct fwk_file_table *sprt_table;
-	struct fwk_file **sprt_fdt;
-	kint32_t index;
+	struct fwk_fdtable *sprt_fdt;
+	kint32_t retval = -ER_UNVALID;
 
 	if (FILE_DESC_OVER_BASE(fd) || !isValid(sprt_file))
 		return -ER_UNVALID;
 
-	sprt_table	= &sgrt_fwk_file_table;
-	sprt_fdt	= sprt_table->fd_array;
-	index		= fd;
+	sprt_table = &sgrt_fwk_file_table;
+
+	/*!< under the lock, so that the slot will not be lost by a concurrent expansion */
+	mutex_lock(&sprt_table->sgrt_mutex);
 
-	if (fd >= sprt_table->max_fdarr)
+	sprt_fdt = sprt_table->sprt_fdt;
+	if ((fd < sprt_fdt->max_fds) && !sprt_fdt->fd[fd] &&
+		mrt_getbit_fromwords(fd, sprt_fdt->open_fds))
 	{
-		sprt_fdt = sprt_table->fds;
-		index = fd - sprt_table->max_fdarr;
+		/*!< the file must be visible before the readers can see it */
+		mrt_dmb();
+		sprt_fdt->fd[fd] = sprt_file;
+		retval = ER_NORMAL;
 	}
 
-	if (sprt_fdt[index])
-		return -ER_UNVALID;
-
-	mutex_lock(&sprt_table->sgrt_mutex);
-	sprt_fdt[index] = sprt_file;
 	mutex_unlock(&sprt_table->sgrt_mutex);
 
-	return ER_NORMAL;
+	return retval;
 }
 
 /*!
  * @brief   fwk_fd_to_file
- * @param   none
- * @retval  none
- * @note    none
+ * @param   fd
+ * @retval  file
+ * @note    lock free
  */
 static struct fwk_file *fwk_fd_to_file(kint32_t fd)
 {
-	struct fwk_file_table *sprt_table;
-	struct fwk_file  **sprt_fdt;
-	kint32_t index;
+	struct fwk_fdtable *sprt_fdt;
 
 	if (FILE_DESC_OVER_BASE(fd))
 		return mrt_nullptr;
 
-	sprt_table	= &sgrt_fwk_file_table;
-	sprt_fdt	= sprt_table->fd_array;
-	index		= fd;
-
-	if (fd >= sprt_table->max_fdarr)
-	{
-		sprt_fdt = sprt_table->fds;
-		index = fd - sprt_table->max_fdarr;
-	}
+	sprt_fdt = fwk_files_fdtable(&sgrt_fwk_file_table);
+	if (fd >= sprt_fdt->max_fds)
+		return mrt_nullptr;
 
-	return sprt_fdt[index];
+	return ((struct fwk_file * volatile *)sprt_fdt->fd)[fd];
 }
 
 /*!
@@ -362,15 +329,45 @@ static void fwk_do_close(kint32_t fd)
 }
 
 /*!
- * @brief   fwk_do_write
- * @param   none
+ * @brief   account an I/O operation of the device node
+ * @param   sprt_stat: mrt_nullptr if the file has no inode
+ * @param   retval: bytes transferred, or errno
+ * @param   start: timestamp before the operation
  * @retval  none
+ * @note    not locked, the counters of a device accessed by several threads at once may be a little off
+ */
+static void fwk_io_account(struct fwk_io_stat *sprt_stat, kssize_t retval, kuint32_t start)
+{
+	kuint32_t elapsed;
+
+	if (!sprt_stat)
+		return;
+
+	elapsed = get_time_stamp_elapsed(start);
+
+	sprt_stat->ops++;
+	if (retval < 0)
+		sprt_stat->errors++;
+	else
+		sprt_stat->bytes += retval;
+
+	sprt_stat->time_total += elapsed;
+	if (elapsed > sprt_stat->time_max)
+		sprt_stat->time_max = elapsed;
+}
+
+/*!
+ * @brief   fwk_do_write
+ * @param   fd, buf, size
+ * @param   pos: offset to write, mrt_nullptr: use and update file's f_pos
+ * @retval  bytes written (may be less than size), or errno
  * @note    none
  */
-static kssize_t fwk_do_write(kint32_t fd, const void *buf, kusize_t size)
+static kssize_t fwk_do_write(kint32_t fd, const void *buf, kusize_t size, kloff_t *pos)
 {
 	struct fwk_file *sprt_file;
-	kint32_t retval;
+	kssize_t retval;
+	kuint32_t start;
 
 	if (fd < 0)
 		return -ER_ERROR;
@@ -382,26 +379,31 @@ static kssize_t fwk_do_write(kint32_t fd, const void *buf, kusize_t size)
 	if ((sprt_file->mode & O_WRONLY) != O_WRONLY)
 		return -ER_FORBID;
 
-	if (sprt_file->sprt_foprts->write)
-	{
-		retval = sprt_file->sprt_foprts->write(sprt_file, (const kbuffer_t *)buf, size);
-		if (!retval)
-			return size;
-	}
+	if (!sprt_file->sprt_foprts->write)
+		return -ER_ERROR;
 
-	return -ER_ERROR;
+	if ((kssize_t)size < 0)
+		return -ER_UNVALID;
+
+	start = get_time_stamp_usecs();
+	retval = sprt_file->sprt_foprts->write(sprt_file, (const kbuffer_t *)buf, size, pos ? pos : &sprt_file->f_pos);
+	fwk_io_account(mrt_file_iostat(sprt_file, sgrt_write), retval, start);
+
+	return retval;
 }
 
 /*!
  * @brief   fwk_do_read
- * @param   none
- * @retval  none
+ * @param   fd, buf, size
+ * @param   pos: offset to read, mrt_nullptr: use and update file's f_pos
+ * @retval  bytes read (may be less than size, 0 means end of file), or errno
  * @note    none
  */
-static kssize_t fwk_do_read(kint32_t fd, void *buf, kusize_t size)
+static kssize_t fwk_do_read(kint32_t fd, void *buf, kusize_t size, kloff_t *pos)
 {
 	struct fwk_file *sprt_file;
-	kint32_t retval;
+	kssize_t retval;
+	kuint32_t start;
 
 	if (fd < 0)
 		return -ER_ERROR;
@@ -413,16 +415,162 @@ static kssize_t fwk_do_read(kint32_t fd, void *buf, kusize_t size)
 	if ((sprt_file->mode & O_RDONLY) != O_RDONLY)
 		return -ER_FORBID;
 
-	if (sprt_file->sprt_foprts->read)
+	if (!sprt_file->sprt_foprts->read)
+		return -ER_ERROR;
+
+	if ((kssize_t)size < 0)
+		return -ER_UNVALID;
+
+	start = get_time_stamp_usecs();
+	retval = sprt_file->sprt_foprts->read(sprt_file, (kbuffer_t *)buf, size, pos ? pos : &sprt_file->f_pos);
+	fwk_io_account(mrt_file_iostat(sprt_file, sgrt_read), retval, start);
+
+	return retval;
+}
+
+/*!
+ * @brief   fwk_do_writev
+ * @param   fd, sprt_iov, iovcnt
+ * @retval  bytes written, or errno
+ * @note    without write_iter, the segments are written one by one, and it stops at a short write
+ */
+static kssize_t fwk_do_writev(kint32_t fd, const struct fwk_iovec *sprt_iov, kuint32_t iovcnt)
+{
+	struct fwk_file *sprt_file;
+	kssize_t total, retval;
+	kuint32_t idx, start;
+
+	if (fd < 0)
+		return -ER_ERROR;
+
+	sprt_file = fwk_fd_to_file(fd);
+	if (!isValid(sprt_file))
+		return -ER_ERROR;
+
+	if ((sprt_file->mode & O_WRONLY) != O_WRONLY)
+		return -ER_FORBID;
+
+	retval = fwk_iov_length(sprt_iov, iovcnt);
+	if (retval <= 0)
+		return retval;
+
+	if (!sprt_file->sprt_foprts->write_iter && !sprt_file->sprt_foprts->write)
+		return -ER_ERROR;
+
+	start = get_time_stamp_usecs();
+
+	if (sprt_file->sprt_foprts->write_iter)
 	{
-		retval = sprt_file->sprt_foprts->read(sprt_file, (kbuffer_t *)buf, size);
-		if (!retval)
-			return size;
-		else if (retval > 0)
-			return retval;
+		total = sprt_file->sprt_foprts->write_iter(sprt_file, sprt_iov, iovcnt, &sprt_file->f_pos);
+		goto out;
 	}
 
-	return -ER_ERROR;
+	for (idx = 0, total = 0; idx < iovcnt; idx++)
+	{
+		if (!sprt_iov[idx].iov_len)
+			continue;
+
+		retval = sprt_file->sprt_foprts->write(sprt_file, (const kbuffer_t *)sprt_iov[idx].iov_base, 
+										sprt_iov[idx].iov_len, &sprt_file->f_pos);
+		if (retval < 0)
+		{
+			total = total ? total : retval;
+			break;
+		}
+
+		total += retval;
+		if (retval < (kssize_t)sprt_iov[idx].iov_len)
+			break;
+	}
+
+out:
+	fwk_io_account(mrt_file_iostat(sprt_file, sgrt_write), total, start);
+
+	return total;
+}
+
+/*!
+ * @brief   fwk_do_readv
+ * @param   fd, sprt_iov, iovcnt
+ * @retval  bytes read, or errno
+ * @note    without read_iter, the segments are read one by one, and it stops at a short read
+ */
+static kssize_t fwk_do_readv(kint32_t fd, const struct fwk_iovec *sprt_iov, kuint32_t iovcnt)
+{
+	struct fwk_file *sprt_file;
+	kssize_t total, retval;
+	kuint32_t idx, start;
+
+	if (fd < 0)
+		return -ER_ERROR;
+
+	sprt_file = fwk_fd_to_file(fd);
+	if (!isValid(sprt_file))
+		return -ER_ERROR;
+
+	if ((sprt_file->mode & O_RDONLY) != O_RDONLY)
+		return -ER_FORBID;
+
+	retval = fwk_iov_length(sprt_iov, iovcnt);
+	if (retval <= 0)
+		return retval;
+
+	if (!sprt_file->sprt_foprts->read_iter && !sprt_file->sprt_foprts->read)
+		return -ER_ERROR;
+
+	start = get_time_stamp_usecs();
+
+	if (sprt_file->sprt_foprts->read_iter)
+	{
+		total = sprt_file->sprt_foprts->read_iter(sprt_file, sprt_iov, iovcnt, &sprt_file->f_pos);
+		goto out;
+	}
+
+	for (idx = 0, total = 0; idx < iovcnt; idx++)
+	{
+		if (!sprt_iov[idx].iov_len)
+			continue;
+
+		retval = sprt_file->sprt_foprts->read(sprt_file, (kbuffer_t *)sprt_iov[idx].iov_base, 
+										sprt_iov[idx].iov_len, &sprt_file->f_pos);
+		if (retval < 0)
+		{
+			total = total ? total : retval;
+			break;
+		}
+
+		total += retval;
+		if (retval < (kssize_t)sprt_iov[idx].iov_len)
+			break;
+	}
+
+out:
+	fwk_io_account(mrt_file_iostat(sprt_file, sgrt_read), total, start);
+
+	return total;
+}
+
+/*!
+ * @brief   fwk_do_lseek
+ * @param   fd, offset, whence
+ * @retval  new offset, or errno
+ * @note    the files without llseek can only be seeked from the beginning or the current offset
+ */
+static kloff_t fwk_do_lseek(kint32_t fd, kloff_t offset, kint32_t whence)
+{
+	struct fwk_file *sprt_file;
+
+	if (fd < 0)
+		return -ER_ERROR;
+
+	sprt_file = fwk_fd_to_file(fd);
+	if (!isValid(sprt_file))
+		return -ER_ERROR;
+
+	if (sprt_file->sprt_foprts->llseek)
+		return sprt_file->sprt_foprts->llseek(sprt_file, offset, whence);
+
+	return fwk_generic_file_llseek(sprt_file, offset, whence, -1);
 }
 
 /*!
@@ -435,6 +583,7 @@ static kint32_t fwk_do_ioctl(kint32_t fd, kuint32_t request, kuaddr_t args)
 {
 	struct fwk_file *sprt_file;
 	kint32_t retval;
+	kuint32_t start;
 
 	if (fd < 0)
 		return -ER_ERROR;
@@ -445,7 +594,10 @@ static kint32_t fwk_do_ioctl(kint32_t fd, kuint32_t request, kuaddr_t args)
 
 	if (sprt_file->sprt_foprts->unlocked_ioctl)
 	{
+		start = get_time_stamp_usecs();
 		retval = sprt_file->sprt_foprts->unlocked_ioctl(sprt_file, request, args);
+		fwk_io_account(mrt_file_iostat(sprt_file, sgrt_ioctl), retval ? -ER_ERROR : 0, start);
+
 		if (!retval)
 			return ER_NORMAL;
 	}
@@ -453,41 +605,293 @@ static kint32_t fwk_do_ioctl(kint32_t fd, kuint32_t request, kuaddr_t args)
 	return -ER_ERROR;
 }
 
+/*!
+ * @brief   check an fd for poll
+ * @param   sprt_pfd, sprt_pt
+ * @retval  revents
+ * @note    the files without poll are always readable and writable
+ */
+static kuint32_t fwk_do_pollfd(struct fwk_pollfd *sprt_pfd, struct fwk_poll_table *sprt_pt)
+{
+	struct fwk_file *sprt_file;
+	kuint32_t mask;
+
+	if (sprt_pfd->fd < 0)
+		return 0;
+
+	sprt_file = fwk_fd_to_file(sprt_pfd->fd);
+	if (!isValid(sprt_file))
+		return POLLNVAL;
+
+	if (sprt_file->sprt_foprts->poll)
+		mask = sprt_file->sprt_foprts->poll(sprt_file, sprt_pt);
+	else
+		mask = POLLIN | POLLOUT | POLLRDNORM | POLLWRNORM;
+
+	/*!< POLLERR and POLLHUP are reported even if not requested */
+	return mask & ((kuint16_t)sprt_pfd->events | POLLERR | POLLHUP);
+}
+
+/*!
+ * @brief   fwk_do_poll
+ * @param   sprt_fds, nfds
+ * @param   timeout_ms: < 0: wait forever; 0: return at once
+ * @retval  the number of fds which have revents, 0 if timed out, or errno
+ * @note    the wait queues are registered by the first pass over the fds, and stay until return;
+ *          any wake_up on them makes current thread check all of the fds again
+ */
+static kint32_t fwk_do_poll(struct fwk_pollfd *sprt_fds, kuint32_t nfds, kint32_t timeout_ms)
+{
+	struct real_thread *sprt_thread = mrt_current;
+	struct fwk_poll_table *sprt_pt = mrt_nullptr, *sprt_wait;
+	kutime_t expires = 0;
+	kuint32_t idx;
+	kint32_t count;
+
+	if ((!sprt_fds && nfds) || (nfds > FILE_DESC_NUM_LIMIT))
+		return -ER_UNVALID;
+
+	if (timeout_ms && sprt_thread)
+	{
+		sprt_pt = (struct fwk_poll_table *)kzalloc(sizeof(*sprt_pt), GFP_KERNEL);
+		if (!isValid(sprt_pt))
+			return -ER_NOMEM;
+
+		real_thread_state_signal(sprt_thread, NR_THREAD_SIG_NORMAL, true);
+	}
+
+	if (timeout_ms > 0)
+		expires = jiffies + msecs_to_jiffies(timeout_ms);
+
+	sprt_wait = sprt_pt;
+
+	for (;;)
+	{
+		count = 0;
+
+		for (idx = 0; idx < nfds; idx++)
+		{
+			sprt_fds[idx].revents = fwk_do_pollfd(&sprt_fds[idx], sprt_wait);
+			if (sprt_fds[idx].revents)
+				count++;
+		}
+
+		sprt_wait = mrt_nullptr;
+
+		if (count || !timeout_ms)
+			break;
+
+		if ((timeout_ms > 0) && mrt_time_after_eq(jiffies, expires))
+			break;
+
+		/*!< without thread (before scheduler starts), keep checking */
+		if (!sprt_thread)
+			continue;
+
+		/*!< woken up while the fds were being checked */
+		if (real_thread_state_pending(sprt_thread))
+			continue;
+
+		/*!<
+		 * a wake_up may still land from here on, while the thread is running;
+		 * the wakeable variants check for it under the scheduler lock, instead of suspending anyway.
+		 * if some of wait queues are not registered, nobody may wake it up, so check again on next tick
+		 */
+		if (sprt_pt->error)
+			schedule_timeout_wakeable(((timeout_ms > 0) && mrt_time_before(expires, jiffies + 1)) ? expires : (jiffies + 1));
+		else if (timeout_ms > 0)
+			schedule_timeout_wakeable(expires);
+		else
+			schedule_self_suspend_wakeable();
+	}
+
+	if (sprt_pt)
+	{
+		fwk_poll_freewait(sprt_pt);
+		real_thread_state_signal(sprt_thread, NR_THREAD_SIG_NORMAL, false);
+		/*!< a late wake_up must not cut a later sleep short */
+		real_thread_state_signal(sprt_thread, NR_THREAD_SIG_WAKEUP, false);
+		kfree(sprt_pt);
+	}
+
+	return count;
+}
+
 /*!
  * @brief   fwk_do_mmap
- * @param   none
- * @retval  none
- * @note    none
+ * @param   addr: hint, or the address required if MAP_FIXED
+ * @param   length, prot, flags, fd
+ * @param   offset: offset in the device, page aligned
+ * @retval  address of the mapping, or mrt_nullptr
+ * @note    memory is not copied, so that every mapping is shared (MAP_PRIVATE is refused);
+ *          the same region can be mapped more than once, and each mapping is tracked by a vma
  */
 static void *fwk_do_mmap(void *addr, kusize_t length, kint32_t prot, kint32_t flags, kint32_t fd, kuint32_t offset)
 {
-	struct fwk_vm_area sgrt_vm;
+	struct fwk_vm_area *sprt_vma;
 	struct fwk_file *sprt_file;
+	struct fwk_inode *sprt_inode;
 	kint32_t retval;
 
-	if (fd < 0)
+	if ((fd < 0) || !length || !mrt_page_aligned(offset) || (flags & MAP_PRIVATE))
 		return mrt_nullptr;
 
 	sprt_file = fwk_fd_to_file(fd);
-	if (!isValid(sprt_file))
+	if (!isValid(sprt_file) || !sprt_file->sprt_foprts->mmap)
 		return mrt_nullptr;
 
-	if (sprt_file->sprt_foprts->mmap)
+	sprt_inode = sprt_file->sprt_inode;
+
+	sprt_vma = (struct fwk_vm_area *)kzalloc(sizeof(*sprt_vma), GFP_KERNEL);
+	if (!isValid(sprt_vma))
+		return mrt_nullptr;
+
+	sprt_vma->size = mrt_page_align(length);
+	sprt_vma->offset = offset;
+	sprt_vma->prot = prot;
+	sprt_vma->flags = flags;
+	sprt_vma->sprt_inode = sprt_inode;
+
+	retval = sprt_file->sprt_foprts->mmap(sprt_file, sprt_vma);
+	if (retval || !sprt_vma->virt_addr)
+		goto fail;
+
+	/*!< the vma always covers whole pages, even if the memory of the device is not page aligned */
+	sprt_vma->page_off = sprt_vma->virt_addr & ~FWK_PAGE_MASK;
+	sprt_vma->virt_addr -= sprt_vma->page_off;
+	sprt_vma->size = mrt_page_align(sprt_vma->size + sprt_vma->page_off);
+
+	if ((flags & MAP_FIXED) && ((kuaddr_t)addr != (sprt_vma->virt_addr + sprt_vma->page_off)))
 	{
-		retval = sprt_file->sprt_foprts->mmap(sprt_file, &sgrt_vm);
-		if (retval)
-			return mrt_nullptr;
+		if (sprt_vma->sprt_vmops && sprt_vma->sprt_vmops->close)
+			sprt_vma->sprt_vmops->close(sprt_vma);
+		goto fail;
 	}
 
-	if ((offset + length) > sgrt_vm.size)
-		return mrt_nullptr;
-	
-	if (!isValid(addr))
-		return (void *)sgrt_vm.virt_addr;
+	mutex_lock(&sgrt_fwk_vm_mutex);
+	list_head_add_tail(&sgrt_fwk_vm_list, &sprt_vma->sgrt_link);
+	if (sprt_inode)
+		list_head_add_tail(&sprt_inode->sgrt_vmas, &sprt_vma->sgrt_ilink);
+	else
+		init_list_head(&sprt_vma->sgrt_ilink);
+	mutex_unlock(&sgrt_fwk_vm_mutex);
+
+	return (void *)(sprt_vma->virt_addr + sprt_vma->page_off);
 
+fail:
+	kfree(sprt_vma);
 	return mrt_nullptr;
 }
 
+/*!
+ * @brief   unmap [start, end)
+ * @param   start, end: page aligned
+ * @param   sprt_free: the vmas no longer used are moved to it
+ * @retval  errno
+ * @note    sgrt_fwk_vm_mutex is held;
+ *          only the newest vma is unmapped where several vmas overlap the same pages,
+ *          so that each virt_munmap() undoes one virt_mmap()
+ */
+static kint32_t fwk_vm_unmap_range(kuaddr_t start, kuaddr_t end, struct list_head *sprt_free)
+{
+	struct fwk_vm_area *sprt_vma, *sprt_new;
+	kuaddr_t vm_start, vm_end;
+	kint32_t retval;
+
+	if (start >= end)
+		return ER_NORMAL;
+
+	foreach_list_prev_entry(sprt_vma, &sgrt_fwk_vm_list, sgrt_link)
+	{
+		vm_start = sprt_vma->virt_addr;
+		vm_end = vm_start + sprt_vma->size;
+
+		if ((vm_end > start) && (vm_start < end))
+			goto found;
+	}
+
+	return ER_NORMAL;
+
+found:
+	if ((start <= vm_start) && (end >= vm_end))
+	{
+		/*!< all */
+		list_head_del(&sprt_vma->sgrt_link);
+		list_head_del(&sprt_vma->sgrt_ilink);
+		list_head_add_tail(sprt_free, &sprt_vma->sgrt_link);
+	}
+	else if (start <= vm_start)
+	{
+		/*!< head */
+		sprt_vma->virt_addr = end;
+		sprt_vma->offset += end - vm_start;
+		sprt_vma->size = vm_end - end;
+	}
+	else if (end >= vm_end)
+	{
+		/*!< tail */
+		sprt_vma->size = start - vm_start;
+	}
+	else
+	{
+		/*!< middle: split into two */
+		sprt_new = (struct fwk_vm_area *)kmalloc(sizeof(*sprt_new), GFP_KERNEL);
+		if (!isValid(sprt_new))
+			return -ER_NOMEM;
+
+		*sprt_new = *sprt_vma;
+		sprt_new->virt_addr = end;
+		sprt_new->offset += end - vm_start;
+		sprt_new->size = vm_end - end;
+		sprt_vma->size = start - vm_start;
+
+		list_head_add_head(&sprt_vma->sgrt_link, &sprt_new->sgrt_link);
+		list_head_add_head(&sprt_vma->sgrt_ilink, &sprt_new->sgrt_ilink);
+	}
+
+	/*!< the rest may be covered by the older vmas */
+	retval = fwk_vm_unmap_range(start, mrt_ret_min2(end, vm_start), sprt_free);
+	if (retval)
+		return retval;
+
+	return fwk_vm_unmap_range(mrt_ret_max2(start, vm_end), end, sprt_free);
+}
+
+/*!
+ * @brief   fwk_do_munmap
+ * @param   addr, length
+ * @retval  errno
+ * @note    a part of a mapping can be unmapped; the vma is freed after its last page is unmapped;
+ *          the whole pages covering [addr, addr + length) are unmapped, as virt_mmap() may return
+ *          an address that is not page aligned
+ */
+static kint32_t fwk_do_munmap(void *addr, kusize_t length)
+{
+	struct fwk_vm_area *sprt_vma, *sprt_temp;
+	DECLARE_LIST_HEAD(sgrt_free);
+	kuaddr_t start = (kuaddr_t)addr & FWK_PAGE_MASK;
+	kint32_t retval;
+
+	if (!length || !addr)
+		return -ER_UNVALID;
+
+	mutex_lock(&sgrt_fwk_vm_mutex);
+	retval = fwk_vm_unmap_range(start, mrt_page_align((kuaddr_t)addr + length), &sgrt_free);
+	mutex_unlock(&sgrt_fwk_vm_mutex);
+
+	foreach_list_next_entry_safe(sprt_vma, sprt_temp, &sgrt_free, sgrt_link)
+	{
+		list_head_del(&sprt_vma->sgrt_link);
+
+		if (sprt_vma->sprt_vmops && sprt_vma->sprt_vmops->close)
+			sprt_vma->sprt_vmops->close(sprt_vma);
+
+		kfree(sprt_vma);
+	}
+
+	return retval;
+}
+
 /*!< ------------------------------------------------------------ */
 /*!
  * @brief   virt_open
@@ -519,7 +923,7 @@ void virt_close(kint32_t fd)
  */
 kssize_t virt_write(kint32_t fd, const void *buf, kusize_t size)
 {
-	return fwk_do_write(fd, buf, size);
+	return fwk_do_write(fd, buf, size, mrt_nullptr);
 }
 
 /*!
@@ -530,7 +934,79 @@ kssize_t virt_write(kint32_t fd, const void *buf, kusize_t size)
  */
 kssize_t virt_read(kint32_t fd, void *buf, kusize_t size)
 {
-	return fwk_do_read(fd, buf, size);
+	return fwk_do_read(fd, buf, size, mrt_nullptr);
+}
+
+/*!
+ * @brief   virt_pwrite
+ * @param   none
+ * @retval  none
+ * @note    The interface is provided for use by the application layer; f_pos is not changed
+ */
+kssize_t virt_pwrite(kint32_t fd, const void *buf, kusize_t size, kloff_t offset)
+{
+	if (offset < 0)
+		return -ER_UNVALID;
+
+	return fwk_do_write(fd, buf, size, &offset);
+}
+
+/*!
+ * @brief   virt_pread
+ * @param   none
+ * @retval  none
+ * @note    The interface is provided for use by the application layer; f_pos is not changed
+ */
+kssize_t virt_pread(kint32_t fd, void *buf, kusize_t size, kloff_t offset)
+{
+	if (offset < 0)
+		return -ER_UNVALID;
+
+	return fwk_do_read(fd, buf, size, &offset);
+}
+
+/*!
+ * @brief   virt_writev
+ * @param   none
+ * @retval  none
+ * @note    The interface is provided for use by the application layer
+ */
+kssize_t virt_writev(kint32_t fd, const struct fwk_iovec *sprt_iov, kuint32_t iovcnt)
+{
+	return fwk_do_writev(fd, sprt_iov, iovcnt);
+}
+
+/*!
+ * @brief   virt_readv
+ * @param   none
+ * @retval  none
+ * @note    The interface is provided for use by the application layer
+ */
+kssize_t virt_readv(kint32_t fd, const struct fwk_iovec *sprt_iov, kuint32_t iovcnt)
+{
+	return fwk_do_readv(fd, sprt_iov, iovcnt);
+}
+
+/*!
+ * @brief   virt_poll
+ * @param   none
+ * @retval  none
+ * @note    The interface is provided for use by the application layer
+ */
+kint32_t virt_poll(struct fwk_pollfd *sprt_fds, kuint32_t nfds, kint32_t timeout_ms)
+{
+	return fwk_do_poll(sprt_fds, nfds, timeout_ms);
+}
+
+/*!
+ * @brief   virt_lseek
+ * @param   none
+ * @retval  none
+ * @note    The interface is provided for use by the application layer
+ */
+kloff_t virt_lseek(kint32_t fd, kloff_t offset, kint32_t whence)
+{
+	return fwk_do_lseek(fd, offset, whence);
 }
 
 /*!
@@ -573,7 +1049,7 @@ void *virt_mmap(void *addr, kusize_t length, kint32_t prot, kint32_t flags, kint
  */
 kint32_t virt_munmap(void *addr, kusize_t length)
 {
-	return 0;
+	return fwk_do_munmap(addr, length);
 }
 
 /*!< end of file */
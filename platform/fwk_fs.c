@@ -12,6 +12,8 @@
 
 /*!< The includes */
 #include <platform/fwk_fs.h>
+#include <platform/fwk_fcntl.h>
+#include <platform/fwk_poll.h>
 
 /*!< API function */
 /*!
@@ -83,4 +85,142 @@ void fwk_do_filp_close(struct fwk_file *sprt_file)
 	kfree(sprt_file);
 }
 
+/*!
+ * @brief   generic llseek
+ * @param   sprt_file, offset, whence
+ * @param   size: size of the file, < 0 if unknown (SEEK_END is not supported then)
+ * @retval  new offset, or errno
+ * @note    can be used by the drivers which have a fixed size
+ */
+kloff_t fwk_generic_file_llseek(struct fwk_file *sprt_file, kloff_t offset, kint32_t whence, kloff_t size)
+{
+	switch (whence)
+	{
+		case SEEK_SET:
+			break;
+
+		case SEEK_CUR:
+			offset += sprt_file->f_pos;
+			break;
+
+		case SEEK_END:
+			if (size < 0)
+				return -ER_UNVALID;
+
+			offset += size;
+			break;
+
+		default:
+			return -ER_UNVALID;
+	}
+
+	if ((offset < 0) || ((size >= 0) && (offset > size)))
+		return -ER_UNVALID;
+
+	sprt_file->f_pos = offset;
+
+	return offset;
+}
+
+/*!
+ * @brief   copy data from a kernel buffer to user
+ * @param   buf, size: user buffer
+ * @param   pos: offset in the kernel buffer, updated on return
+ * @param   from, available: kernel buffer
+ * @retval  bytes copied, 0 if pos reaches the end
+ * @note    none
+ */
+kssize_t fwk_simple_read_from_buffer(kbuffer_t *buf, kssize_t size, kloff_t *pos, const void *from, kssize_t available)
+{
+	kloff_t offset = *pos;
+	kssize_t left;
+
+	if ((offset < 0) || (size < 0))
+		return -ER_UNVALID;
+
+	if ((offset >= available) || !size)
+		return 0;
+
+	/*!< offset < available here, so the rest always fits in kssize_t */
+	left = available - (kssize_t)offset;
+	size = mrt_ret_min2(size, left);
+	fwk_copy_to_user(buf, (kuint8_t *)from + offset, size);
+	*pos = offset + size;
+
+	return size;
+}
+
+/*!
+ * @brief   copy data from user to a kernel buffer
+ * @param   to, available: kernel buffer
+ * @param   pos: offset in the kernel buffer, updated on return
+ * @param   buf, size: user buffer
+ * @retval  bytes copied, 0 if pos reaches the end
+ * @note    none
+ */
+kssize_t fwk_simple_write_to_buffer(void *to, kssize_t available, kloff_t *pos, const kbuffer_t *buf, kssize_t size)
+{
+	kloff_t offset = *pos;
+	kssize_t left;
+
+	if ((offset < 0) || (size < 0))
+		return -ER_UNVALID;
+
+	if ((offset >= available) || !size)
+		return 0;
+
+	/*!< offset < available here, so the rest always fits in kssize_t */
+	left = available - (kssize_t)offset;
+	size = mrt_ret_min2(size, left);
+	fwk_copy_from_user((kuint8_t *)to + offset, buf, size);
+	*pos = offset + size;
+
+	return size;
+}
+
+/*!
+ * @brief   add current thread to the wait queue, and record it in poll table
+ * @param   sprt_file, sprt_wqh, sprt_pt
+ * @retval  none
+ * @note    called by fwk_poll_wait()
+ */
+void __fwk_poll_wait(struct fwk_file *sprt_file, struct wait_queue_head *sprt_wqh, struct fwk_poll_table *sprt_pt)
+{
+	struct fwk_poll_table_entry *sprt_entry;
+	struct real_thread *sprt_thread = mrt_current;
+
+	if (!sprt_thread)
+		return;
+
+	if (sprt_pt->nr_entries >= FWK_POLL_ENTRIES_MAX)
+	{
+		sprt_pt->error = -ER_MORE;
+		return;
+	}
+
+	sprt_entry = &sprt_pt->sgrt_entries[sprt_pt->nr_entries++];
+	sprt_entry->sprt_wqh = sprt_wqh;
+	sprt_entry->sgrt_wq.sprt_task = sprt_thread;
+
+	init_list_head(&sprt_entry->sgrt_wq.sgrt_link);
+	add_wait_queue(sprt_wqh, &sprt_entry->sgrt_wq);
+}
+
+/*!
+ * @brief   remove current thread from all of the wait queues in poll table
+ * @param   sprt_pt
+ * @retval  none
+ * @note    none
+ */
+void fwk_poll_freewait(struct fwk_poll_table *sprt_pt)
+{
+	struct fwk_poll_table_entry *sprt_entry;
+
+	while (sprt_pt->nr_entries)
+	{
+		sprt_entry = &sprt_pt->sgrt_entries[--sprt_pt->nr_entries];
+		remove_wait_queue(sprt_entry->sprt_wqh, &sprt_entry->sgrt_wq);
+	}
+}
+
 /*!< end of file */
@@ -178,6 +178,7 @@ struct fwk_inode *fwk_mk_inode(struct fwk_kobject *sprt_kobj, kuint32_t type, ki
 	sprt_inode->name = sprt_kobj->name;
 	sprt_inode->type = sprt_kobj->is_dir ? INODE_TYPE_DIR : INODE_TYPE_FILE;
 	sprt_inode->sprt_kobj = sprt_kobj;
+	init_list_head(&sprt_inode->sgrt_vmas);
 
 	fwk_inode_set_ops(sprt_inode, type, devNum);
 
@@ -0,0 +1,402 @@
+/*
+ * Asynchronous I/O Ring
+ *
+ * File Name:   fwk_ioring.c
+ * Author:      Yang Yujun
+ * E-mail:      <yujiantianhu@163.com>
+ * Created on:  2024.07.28
+ *
+ * Copyright (c) 2024   Yang Yujun <yujiantianhu@163.com>
+ *
+ */
+
+/*!< The includes */
+#include <platform/fwk_fcntl.h>
+#include <platform/fwk_ioring.h>
+#include <kernel/sched.h>
+#include <kernel/sleep.h>
+#include <kernel/thread.h>
+#include <kernel/spinlock.h>
+
+/*!< The defines */
+#define FWK_IO_RING_WORKER_STACK_SIZE						REAL_THREAD_STACK_HALF(1)	/*!< 1/2 page (2 kbytes) */
+
+/*!< an idle worker checks its ring again after this, in case a wakeup came just before it slept */
+#define FWK_IO_RING_IDLE_PERIOD								(200)						/*!< unit: ms */
+
+/*!<
+ * Worker threads can not exit, so they are created on demand and kept:
+ * a worker serves one ring from setup to destroy, and then waits for the next ring
+ */
+struct fwk_io_ring_worker
+{
+	real_thread_t tid;
+	kbool_t created;
+	kbool_t running;										/*!< the ring is being used by the worker */
+
+	struct fwk_io_ring *sprt_ring;							/*!< mrt_nullptr: free */
+	struct wait_queue_head sgrt_wqh;						/*!< woken up on submission */
+	struct real_thread_attr sgrt_attr;
+};
+
+/*!< The globals */
+static struct fwk_io_ring_worker sgrt_fwk_io_ring_workers[FWK_IO_RING_WORKER_MAX];
+static kuint32_t g_fwk_io_ring_stack[FWK_IO_RING_WORKER_MAX][FWK_IO_RING_WORKER_STACK_SIZE];
+static DECLARE_SPIN_LOCK(sgrt_fwk_io_ring_lock);
+
+/*!< API function */
+/*!
+ * @brief   issue a request
+ * @param   sprt_sqe
+ * @retval  the return value of the operation
+ * @note    run by the worker of the ring
+ */
+static kssize_t fwk_io_ring_issue(struct fwk_io_sqe *sprt_sqe)
+{
+	switch (sprt_sqe->opcode)
+	{
+		case NR_IO_RING_OP_NOP:
+			return ER_NORMAL;
+
+		case NR_IO_RING_OP_READ:
+			if (sprt_sqe->offset < 0)
+				return virt_read(sprt_sqe->fd, sprt_sqe->addr, sprt_sqe->len);
+			return virt_pread(sprt_sqe->fd, sprt_sqe->addr, sprt_sqe->len, sprt_sqe->offset);
+
+		case NR_IO_RING_OP_WRITE:
+			if (sprt_sqe->offset < 0)
+				return virt_write(sprt_sqe->fd, sprt_sqe->addr, sprt_sqe->len);
+			return virt_pwrite(sprt_sqe->fd, sprt_sqe->addr, sprt_sqe->len, sprt_sqe->offset);
+
+		case NR_IO_RING_OP_IOCTL:
+			return virt_ioctl(sprt_sqe->fd, sprt_sqe->request, sprt_sqe->addr);
+
+		default:
+			return -ER_NSUPPORT;
+	}
+}
+
+/*!
+ * @brief   consume all submitted requests
+ * @param   sprt_ring
+ * @retval  none
+ * @note    run by the worker of the ring; the requests of a ring are completed in order
+ */
+static void fwk_io_ring_work(struct fwk_io_ring *sprt_ring)
+{
+	struct fwk_io_sqe *sprt_sqe;
+	struct fwk_io_cqe *sprt_cqe;
+	kuint32_t head, tail;
+	kssize_t res;
+
+	head = sprt_ring->sq_head;
+
+	for (;;)
+	{
+		tail = mrt_io_ring_read(sprt_ring->sq_tail);
+		if (head == tail)
+			break;
+
+		/*!< sqe is read after sq_tail */
+		mrt_dmb();
+
+		sprt_sqe = &sprt_ring->sprt_sqes[head & (sprt_ring->sq_entries - 1)];
+		res = fwk_io_ring_issue(sprt_sqe);
+
+		sprt_cqe = &sprt_ring->sprt_cqes[sprt_ring->cq_tail & (sprt_ring->cq_entries - 1)];
+		sprt_cqe->user_data = sprt_sqe->user_data;
+		sprt_cqe->res = res;
+
+		/*!< cqe is written before cq_tail, and sqe is no longer used after sq_head */
+		mrt_dmb();
+		mrt_io_ring_write(sprt_ring->sq_head, ++head);
+		mrt_io_ring_write(sprt_ring->cq_tail, sprt_ring->cq_tail + 1);
+
+		wake_up(&sprt_ring->sgrt_wqh);
+	}
+}
+
+/*!
+ * @brief   check if the ring of a worker has requests submitted
+ * @param   sprt_worker
+ * @retval  true / false
+ * @note    the ring is read under the lock, since fwk_io_ring_worker_detach() may unbind it and free it at any time
+ */
+static kbool_t fwk_io_ring_worker_pending(struct fwk_io_ring_worker *sprt_worker)
+{
+	struct fwk_io_ring *sprt_ring;
+	kbool_t pending;
+
+	spin_lock_irqsave(&sgrt_fwk_io_ring_lock);
+	sprt_ring = sprt_worker->sprt_ring;
+	pending = sprt_ring && (mrt_io_ring_read(sprt_ring->sq_tail) != sprt_ring->sq_head);
+	spin_unlock_irqrestore(&sgrt_fwk_io_ring_lock);
+
+	return pending;
+}
+
+/*!
+ * @brief   worker thread entry
+ * @param   args: worker
+ * @retval  none
+ * @note    the requests may block here, instead of blocking kworker or the owner of the ring
+ */
+static void *fwk_io_ring_worker_entry(void *args)
+{
+	struct fwk_io_ring_worker *sprt_worker = (struct fwk_io_ring_worker *)args;
+	struct fwk_io_ring *sprt_ring;
+
+	for (;;)
+	{
+		wait_event_timeout(&sprt_worker->sgrt_wqh, fwk_io_ring_worker_pending(sprt_worker),
+							jiffies + msecs_to_jiffies(FWK_IO_RING_IDLE_PERIOD));
+
+		spin_lock_irqsave(&sgrt_fwk_io_ring_lock);
+		sprt_ring = sprt_worker->sprt_ring;
+		sprt_worker->running = !!sprt_ring;
+		spin_unlock_irqrestore(&sgrt_fwk_io_ring_lock);
+
+		if (sprt_ring)
+			fwk_io_ring_work(sprt_ring);
+
+		spin_lock_irqsave(&sgrt_fwk_io_ring_lock);
+		sprt_worker->running = false;
+		spin_unlock_irqrestore(&sgrt_fwk_io_ring_lock);
+	}
+
+	return args;
+}
+
+/*!
+ * @brief   bind a worker to a ring
+ * @param   sprt_ring
+ * @retval  errno
+ * @note    a worker thread is created if none of the existing ones is free
+ */
+static kint32_t fwk_io_ring_worker_attach(struct fwk_io_ring *sprt_ring)
+{
+	struct fwk_io_ring_worker *sprt_worker = mrt_nullptr;
+	struct real_thread_attr *sprt_attr;
+	kuint32_t i;
+	kint32_t retval;
+
+	spin_lock_irqsave(&sgrt_fwk_io_ring_lock);
+
+	for (i = 0; i < FWK_IO_RING_WORKER_MAX; i++)
+	{
+		if (!sgrt_fwk_io_ring_workers[i].sprt_ring && !sgrt_fwk_io_ring_workers[i].running)
+		{
+			sprt_worker = &sgrt_fwk_io_ring_workers[i];
+			sprt_worker->sprt_ring = sprt_ring;
+			break;
+		}
+	}
+
+	spin_unlock_irqrestore(&sgrt_fwk_io_ring_lock);
+
+	if (!sprt_worker)
+		return -ER_MORE;
+
+	sprt_ring->sprt_worker = sprt_worker;
+	if (sprt_worker->created)
+		return ER_NORMAL;
+
+	init_waitqueue_head(&sprt_worker->sgrt_wqh);
+
+	sprt_attr = &sprt_worker->sgrt_attr;
+	sprt_attr->detachstate = REAL_THREAD_CREATE_JOINABLE;
+	sprt_attr->inheritsched	= REAL_THREAD_INHERIT_SCHED;
+	sprt_attr->schedpolicy = REAL_THREAD_SCHED_FIFO;
+
+	/*!< thread stack */
+	real_thread_set_stack(sprt_attr, mrt_nullptr, g_fwk_io_ring_stack[i], sizeof(g_fwk_io_ring_stack[i]));
+	/*!< above the applications, below kworker */
+	real_thread_set_priority(sprt_attr, __THREAD_HIGHER_DEFAULT(3));
+	/*!< default time slice */
+	real_thread_set_time_slice(sprt_attr, REAL_THREAD_TIME_DEFUALT);
+
+	retval = kernel_thread_create(&sprt_worker->tid, sprt_attr, fwk_io_ring_worker_entry, sprt_worker);
+	if (retval < 0)
+	{
+		sprt_ring->sprt_worker = mrt_nullptr;
+
+		spin_lock_irqsave(&sgrt_fwk_io_ring_lock);
+		sprt_worker->sprt_ring = mrt_nullptr;
+		spin_unlock_irqrestore(&sgrt_fwk_io_ring_lock);
+
+		return retval;
+	}
+
+	sprt_worker->created = true;
+
+	return ER_NORMAL;
+}
+
+/*!
+ * @brief   unbind the worker from a ring
+ * @param   sprt_ring
+ * @retval  none
+ * @note    returns after the worker has stopped using the ring
+ */
+static void fwk_io_ring_worker_detach(struct fwk_io_ring *sprt_ring)
+{
+	struct fwk_io_ring_worker *sprt_worker = sprt_ring->sprt_worker;
+	kbool_t running;
+
+	spin_lock_irqsave(&sgrt_fwk_io_ring_lock);
+	sprt_worker->sprt_ring = mrt_nullptr;
+	spin_unlock_irqrestore(&sgrt_fwk_io_ring_lock);
+
+	for (;;)
+	{
+		spin_lock_irqsave(&sgrt_fwk_io_ring_lock);
+		running = sprt_worker->running;
+		spin_unlock_irqrestore(&sgrt_fwk_io_ring_lock);
+
+		if (!running)
+			break;
+
+		schedule_delay_ms(1);
+	}
+
+	sprt_ring->sprt_worker = mrt_nullptr;
+}
+
+/*!
+ * @brief   check if completion queue is not empty
+ * @param   sprt_ring
+ * @retval  true / false
+ * @note    none
+ */
+static kbool_t fwk_io_ring_has_cqe(struct fwk_io_ring *sprt_ring)
+{
+	return !!fwk_io_ring_peek_cqe(sprt_ring);
+}
+
+/*!
+ * @brief   check if all of the submitted requests are finished
+ * @param   sprt_ring
+ * @retval  true / false
+ * @note    none
+ */
+static kbool_t fwk_io_ring_is_idle(struct fwk_io_ring *sprt_ring)
+{
+	return mrt_io_ring_read(sprt_ring->sq_head) == sprt_ring->sq_tail;
+}
+
+/*!< ------------------------------------------------------------ */
+/*!
+ * @brief   create a ring
+ * @param   entries: size of submission queue, rounded up to power of 2
+ * @retval  ring, or mrt_nullptr
+ * @note    The interface is provided for use by the application layer;
+ *          the completion queue is twice as large as the submission queue;
+ *          at most FWK_IO_RING_WORKER_MAX rings can be alive at the same time
+ */
+struct fwk_io_ring *virt_io_ring_setup(kuint32_t entries)
+{
+	struct fwk_io_ring *sprt_ring;
+	kuint32_t sq_entries = 1;
+
+	if (!entries || (entries > FWK_IO_RING_ENTRIES_MAX))
+		return mrt_nullptr;
+
+	while (sq_entries < entries)
+		sq_entries <<= 1;
+
+	sprt_ring = (struct fwk_io_ring *)kzalloc(sizeof(*sprt_ring) +
+						sq_entries * sizeof(struct fwk_io_sqe) + (sq_entries << 1) * sizeof(struct fwk_io_cqe), GFP_KERNEL);
+	if (!isValid(sprt_ring))
+		return mrt_nullptr;
+
+	sprt_ring->sq_entries = sq_entries;
+	sprt_ring->cq_entries = sq_entries << 1;
+	sprt_ring->sprt_sqes = (struct fwk_io_sqe *)(sprt_ring + 1);
+	sprt_ring->sprt_cqes = (struct fwk_io_cqe *)(sprt_ring->sprt_sqes + sq_entries);
+
+	init_waitqueue_head(&sprt_ring->sgrt_wqh);
+
+	if (fwk_io_ring_worker_attach(sprt_ring))
+	{
+		kfree(sprt_ring);
+		return mrt_nullptr;
+	}
+
+	return sprt_ring;
+}
+
+/*!
+ * @brief   destroy a ring
+ * @param   sprt_ring
+ * @retval  none
+ * @note    The interface is provided for use by the application layer;
+ *          the cqes not reaped are dropped; it waits for the requests submitted,
+ *          so a request that blocks forever also blocks here
+ */
+void virt_io_ring_destroy(struct fwk_io_ring *sprt_ring)
+{
+	if (!isValid(sprt_ring))
+		return;
+
+	/*!< the sqes submitted are finished by the worker, and the ones not submitted are dropped */
+	wait_event_timeout(&sprt_ring->sgrt_wqh, fwk_io_ring_is_idle(sprt_ring),
+						jiffies + msecs_to_jiffies(FWK_IO_RING_IDLE_PERIOD));
+
+	fwk_io_ring_worker_detach(sprt_ring);
+	kfree(sprt_ring);
+}
+
+/*!
+ * @brief   submit all of the sqes got
+ * @param   sprt_ring
+ * @retval  the number of sqes not finished
+ * @note    The interface is provided for use by the application layer;
+ *          one call for any number of requests, the worker is only woken up if the ring has work
+ */
+kint32_t virt_io_ring_submit(struct fwk_io_ring *sprt_ring)
+{
+	kuint32_t pending;
+
+	if (!isValid(sprt_ring))
+		return -ER_UNVALID;
+
+	/*!< sqes are written before the worker can see sq_tail */
+	mrt_dmb();
+	mrt_io_ring_write(sprt_ring->sq_tail, sprt_ring->sqe_tail);
+
+	pending = sprt_ring->sqe_tail - mrt_io_ring_read(sprt_ring->sq_head);
+	if (pending)
+		wake_up(&sprt_ring->sprt_worker->sgrt_wqh);
+
+	return pending;
+}
+
+/*!
+ * @brief   wait for a completion
+ * @param   sprt_ring
+ * @param   timeout_ms: < 0: wait forever; 0: return at once
+ * @retval  cqe, or mrt_nullptr if timed out
+ * @note    The interface is provided for use by the application layer;
+ *          call fwk_io_ring_cqe_seen() after the cqe is used
+ */
+struct fwk_io_cqe *virt_io_ring_wait_cqe(struct fwk_io_ring *sprt_ring, kint32_t timeout_ms)
+{
+	if (!isValid(sprt_ring))
+		return mrt_nullptr;
+
+	if (timeout_ms < 0)
+		wait_event_timeout(&sprt_ring->sgrt_wqh, fwk_io_ring_has_cqe(sprt_ring),
+							jiffies + msecs_to_jiffies(FWK_IO_RING_IDLE_PERIOD));
+
+	else if (timeout_ms > 0)
+	{
+		kutime_t expires = jiffies + msecs_to_jiffies(timeout_ms);
+
+		wait_event_timeout(&sprt_ring->sgrt_wqh,
+							fwk_io_ring_has_cqe(sprt_ring) || mrt_time_after_eq(jiffies, expires), expires);
+	}
+
+	return fwk_io_ring_peek_cqe(sprt_ring);
+}
+
+/*!< end of file */
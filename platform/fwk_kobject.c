@@ -15,10 +15,156 @@
 #include <platform/fwk_inode.h>
 #include <kernel/spinlock.h>
 
+/*!< The defines */
+/*!< path lookup cache, direct mapped */
+#define FWK_KOBJ_CACHE_BITS							(6)
+#define FWK_KOBJ_CACHE_SIZE							(1 << FWK_KOBJ_CACHE_BITS)
+#define FWK_KOBJ_CACHE_MASK							(FWK_KOBJ_CACHE_SIZE - 1)
+
+struct fwk_kobj_cache
+{
+	struct fwk_kset *sprt_kset;							/*!< parent directory */
+	struct fwk_kobject *sprt_kobj;						/*!< child found */
+	kuint32_t hash;										/*!< name hash of the child */
+	kuint32_t generation;								/*!< 0: empty */
+};
+
 /*!< The globals */
 static struct fwk_kset sgrt_fwk_kset_root;
 
+static struct fwk_kobj_cache sgrt_fwk_kobj_cache[FWK_KOBJ_CACHE_SIZE];
+static kuint32_t g_fwk_kobj_cache_generation = 1;
+static DECLARE_SPIN_LOCK(sgrt_fwk_kobj_cache_lock);
+
 /*!< API function */
+/*!
+ * @brief   invalidate path lookup cache
+ * @param   none
+ * @retval  none
+ * @note    every entry is dropped by changing the generation, since a kobject (or its children)
+ *          removed may be freed, and the memory may be reused by a new one
+ */
+static void fwk_kobject_cache_invalidate(void)
+{
+	spin_lock_irqsave(&sgrt_fwk_kobj_cache_lock);
+
+	/*!< wrapped around, the entries left may be mistaken for valid */
+	if (!(++g_fwk_kobj_cache_generation))
+	{
+		memory_reset(sgrt_fwk_kobj_cache, sizeof(sgrt_fwk_kobj_cache));
+		g_fwk_kobj_cache_generation = 1;
+	}
+
+	spin_unlock_irqrestore(&sgrt_fwk_kobj_cache_lock);
+}
+
+/*!
+ * @brief   get cache entry
+ * @param   sprt_kset, hash
+ * @retval  entry
+ * @note    none
+ */
+static inline struct fwk_kobj_cache *fwk_kobject_cache_entry(struct fwk_kset *sprt_kset, kuint32_t hash)
+{
+	kuint32_t index = hash ^ ((kuaddr_t)sprt_kset >> 4);
+
+	return &sgrt_fwk_kobj_cache[(index ^ (index >> FWK_KOBJ_CACHE_BITS)) & FWK_KOBJ_CACHE_MASK];
+}
+
+/*!
+ * @brief   check if kobject's name matches
+ * @param   sprt_kobj, name, lenth, hash, is_dir
+ * @retval  true: match
+ * @note    none
+ */
+static inline kbool_t fwk_kobject_name_match(struct fwk_kobject *sprt_kobj, const kchar_t *name,
+									kusize_t lenth, kuint32_t hash, kbool_t is_dir)
+{
+	if (!sprt_kobj->name || (sprt_kobj->name_hash != hash) || (sprt_kobj->name_len != lenth))
+		return false;
+
+	/*!< it is possible that file and directory have the same name */
+	if (sprt_kobj->is_dir != is_dir)
+		return false;
+
+	return !strncmp(name, sprt_kobj->name, lenth);
+}
+
+/*!
+ * @brief   find child (a path component) from directory
+ * @param   sprt_kset: directory
+ * @param   name, lenth: not '\0' terminated
+ * @param   is_dir: look for a directory or a file
+ * @retval  kobject found
+ * @note    the cache is looked up first, and the child list is walked on miss
+ */
+static struct fwk_kobject *fwk_kobject_lookup_child(struct fwk_kset *sprt_kset, const kchar_t *name,
+									kusize_t lenth, kbool_t is_dir)
+{
+	struct fwk_kobj_cache *sprt_cache;
+	struct fwk_kobject *sprt_kobj, *sprt_found = mrt_nullptr;
+	kuint32_t hash, generation;
+
+	hash = fwk_kobject_name_hash(name, lenth);
+	sprt_cache = fwk_kobject_cache_entry(sprt_kset, hash);
+
+	spin_lock_irqsave(&sgrt_fwk_kobj_cache_lock);
+
+	if ((sprt_cache->generation == g_fwk_kobj_cache_generation) &&
+		(sprt_cache->sprt_kset == sprt_kset) && (sprt_cache->hash == hash) &&
+		fwk_kobject_name_match(sprt_cache->sprt_kobj, name, lenth, hash, is_dir))
+		sprt_found = sprt_cache->sprt_kobj;
+
+	generation = g_fwk_kobj_cache_generation;
+	spin_unlock_irqrestore(&sgrt_fwk_kobj_cache_lock);
+
+	if (sprt_found)
+		return sprt_found;
+
+	spin_lock(&sprt_kset->sgrt_kobj.sgrt_lock);
+
+	foreach_list_next_entry(sprt_kobj, &sprt_kset->sgrt_list, sgrt_link)
+	{
+		if (fwk_kobject_name_match(sprt_kobj, name, lenth, hash, is_dir))
+		{
+			sprt_found = sprt_kobj;
+			break;
+		}
+	}
+
+	spin_unlock(&sprt_kset->sgrt_kobj.sgrt_lock);
+
+	if (!sprt_found)
+		return mrt_nullptr;
+
+	spin_lock_irqsave(&sgrt_fwk_kobj_cache_lock);
+
+	/*!< not cached if anything is changed during the walking */
+	if (generation == g_fwk_kobj_cache_generation)
+	{
+		sprt_cache->sprt_kset = sprt_kset;
+		sprt_cache->sprt_kobj = sprt_found;
+		sprt_cache->hash = hash;
+		sprt_cache->generation = generation;
+	}
+
+	spin_unlock_irqrestore(&sgrt_fwk_kobj_cache_lock);
+
+	return sprt_found;
+}
+
+/*!
+ * @brief   update kobject's name hash and lenth
+ * @param   sprt_kobj
+ * @retval  none
+ * @note    call it whenever the name is changed
+ */
+static void fwk_kobject_hash_name(struct fwk_kobject *sprt_kobj)
+{
+	sprt_kobj->name_len = sprt_kobj->name ? kstrlen(sprt_kobj->name) : 0;
+	sprt_kobj->name_hash = fwk_kobject_name_hash(sprt_kobj->name, sprt_kobj->name_len);
+}
+
 /*!
  * @brief   join the new kobject to kset
  * @param   sprt_kobj
@@ -59,6 +205,8 @@ static kint32_t fwk_kobject_join_to_kset(struct fwk_kobject *sprt_kobj)
 	sprt_kobj->sprt_parent = sprt_parent;
 	spin_unlock(&sprt_kobj->sgrt_lock);
 
+	fwk_kobject_cache_invalidate();
+
 	return ER_NORMAL;
 
 fail:
@@ -80,6 +228,8 @@ static void fwk_kobject_detach_from_kset(struct fwk_kobject *sprt_kobj)
 	spin_lock(&sprt_kobj->sgrt_lock);
 	list_head_del_safe(&sprt_kobj->sprt_kset->sgrt_list, &sprt_kobj->sgrt_link);
 	spin_unlock(&sprt_kobj->sgrt_lock);
+
+	fwk_kobject_cache_invalidate();
 }
 
 /*!
@@ -207,6 +357,8 @@ kint32_t fwk_kobject_add_vargs(struct fwk_kobject *sprt_kobj, struct fwk_kobject
  */
 void fwk_kobject_del(struct fwk_kobject *sprt_kobj)
 {
+	fwk_kobject_cache_invalidate();
+
 	fwk_rm_inode(sprt_kobj->sprt_inode);
 	fwk_kobject_del_name(sprt_kobj);
 	fwk_kobject_detach_from_kset(sprt_kobj);
@@ -260,6 +412,7 @@ static struct fwk_kobject *__fwk_kobject_populate_dir(struct fwk_kobject *sprt_p
         
         kstrlcpy(new_name, name, lenth + 1);
         sprt_kobj->name = new_name;
+        fwk_kobject_hash_name(sprt_kobj);
 
         sprt_kobj->sprt_kset = mrt_fwk_kset_get(sprt_parent);
         if (!sprt_kobj->sprt_kset || fwk_kset_register(sprt_kset))
@@ -403,7 +556,7 @@ struct fwk_kobject *fwk_find_kobject_by_path(struct fwk_kobject *sprt_head, cons
 	kusize_t lenth;
 	struct fwk_kobject *sprt_kobj;
 	struct fwk_kset *sprt_kset;
-	kbool_t found, is_root;
+	kbool_t is_root;
 
 	sprt_kset = sprt_head ? mrt_fwk_kset_get(sprt_head) : &sgrt_fwk_kset_root;
 	if (!sprt_kset)
@@ -436,47 +589,18 @@ struct fwk_kobject *fwk_find_kobject_by_path(struct fwk_kobject *sprt_head, cons
 		/*!< if '/' can be found, str_start is a directory */
 		str_end = kstrchr(str_start, '/');
 		is_root = true;
-        found = false;
         lenth = str_end ? (kusize_t)(str_end - str_start) : kstrlen(str_start);
 
-		spin_lock(&sprt_kset->sgrt_kobj.sgrt_lock);
-
-		foreach_list_next_entry(sprt_kobj, &sprt_kset->sgrt_list, sgrt_link)
-		{
-			if (!sprt_kobj->name)
-				continue;
-
-			if (!strncmp(str_start, sprt_kobj->name, lenth))
-			{               
-				/*!< str_end ? directory : file; if file is existed, file is repeated */
-				if (!str_end)
-                {
-                    if (!sprt_kobj->is_dir)
-					{
-						spin_unlock(&sprt_kset->sgrt_kobj.sgrt_lock);
-                        return sprt_kobj;
-					}
-                    
-                    continue;
-                }
-                
-                /*!< otherwise, it is a directory */
-                /*!< it is possible that file and directory have the same name */
-                if (!sprt_kobj->is_dir)
-                    continue;
-
-				spin_unlock(&sprt_kset->sgrt_kobj.sgrt_lock);
-                
-                found = true;
-                sprt_kset = mrt_fwk_kset_get(sprt_kobj);
-                goto out;
-			}
-		}
+		/*!< str_end ? directory : file */
+		sprt_kobj = fwk_kobject_lookup_child(sprt_kset, str_start, lenth, !!str_end);
+		if (!sprt_kobj)
+			break;
 
-		spin_unlock(&sprt_kset->sgrt_kobj.sgrt_lock);
+		if (!str_end)
+			return sprt_kobj;
 
-out:
-		if (!found || !sprt_kset)
+		sprt_kset = mrt_fwk_kset_get(sprt_kobj);
+		if (!sprt_kset)
 			break;
 	}
 
@@ -505,6 +629,8 @@ kint32_t fwk_kobject_set_name_args(struct fwk_kobject *sprt_kobj, const kchar_t
 		kfree(sprt_kobj->name);
 
 	sprt_kobj->name = ptr;
+	fwk_kobject_hash_name(sprt_kobj);
+
 	return ER_NORMAL;
 }
 
@@ -541,6 +667,10 @@ kint32_t fwk_kobject_rename(struct fwk_kobject *sprt_kobj, const kchar_t *fmt, .
 	retval = fwk_kobject_set_name_args(sprt_kobj, fmt, sprt_list);
 	va_end(sprt_list);
 
+	/*!< the cached entry is found by the old name */
+	if (!retval)
+		fwk_kobject_cache_invalidate();
+
 	return retval;
 }
 
@@ -556,6 +686,7 @@ void fwk_kobject_del_name(struct fwk_kobject *sprt_kobj)
 		kfree(sprt_kobj->name);
 
 	sprt_kobj->name = mrt_nullptr;
+	fwk_kobject_hash_name(sprt_kobj);
 }
 
 /*!
@@ -42,16 +42,16 @@ kint32_t __plat_init fwk_kobjmap_init(void)
 		goto fail3;
 
 	/*!< Initialize the character device matching table */
-	for (i = 0; i < ARRAY_SIZE(sprt_fwk_chrdev_map->sprt_probes); i++)
-		sprt_fwk_chrdev_map->sprt_probes[i] = mrt_nullptr;
+	for (i = 0; i < ARRAY_SIZE(sprt_fwk_chrdev_map->sprt_majors); i++)
+		sprt_fwk_chrdev_map->sprt_majors[i] = mrt_nullptr;
 
 	/*!< Initialize the block device matching table */
-	for (i = 0; i < ARRAY_SIZE(sprt_fwk_blkdev_map->sprt_probes); i++)
-		sprt_fwk_blkdev_map->sprt_probes[i] = mrt_nullptr;
+	for (i = 0; i < ARRAY_SIZE(sprt_fwk_blkdev_map->sprt_majors); i++)
+		sprt_fwk_blkdev_map->sprt_majors[i] = mrt_nullptr;
 
 	/*!< Initialize the net device matching table */
-	for (i = 0; i < ARRAY_SIZE(sprt_fwk_netdev_map->sprt_probes); i++)
-		sprt_fwk_netdev_map->sprt_probes[i] = mrt_nullptr;
+	for (i = 0; i < ARRAY_SIZE(sprt_fwk_netdev_map->sprt_majors); i++)
+		sprt_fwk_netdev_map->sprt_majors[i] = mrt_nullptr;
 
 	return ER_NORMAL;
 
@@ -66,207 +66,234 @@ fail1:
 }
 
 /*!
- * @brief   fwk_kobjmap_del
- * @param   none
+ * @brief   free all of the minor tables of a domain
+ * @param   domain
  * @retval  none
  * @note    none
  */
-void __plat_exit fwk_kobjmap_del(void)
+static void fwk_kobjmap_clear(struct fwk_kobj_map *domain)
 {
-	struct fwk_probes *sprt_prev;
-	struct fwk_probes *sprt_list;
-	kusize_t mapsize;
 	kuint32_t i;
 
-	/*!< Destroy the character device matching table */
-	mapsize	= isValid(sprt_fwk_chrdev_map) ? ARRAY_SIZE(sprt_fwk_chrdev_map->sprt_probes) : 0;
-	for (i = 0; i < mapsize; i++)
+	if (!isValid(domain))
+		return;
+
+	for (i = 0; i < ARRAY_SIZE(domain->sprt_majors); i++)
 	{
-		mrt_list_delete_all(sprt_fwk_chrdev_map->sprt_probes[i],
-										sprt_prev, sprt_list);
-		sprt_fwk_chrdev_map->sprt_probes[i] = mrt_nullptr;
+		if (domain->sprt_majors[i])
+			kfree(domain->sprt_majors[i]);
+
+		domain->sprt_majors[i] = mrt_nullptr;
 	}
+}
+
+/*!
+ * @brief   fwk_kobjmap_del
+ * @param   none
+ * @retval  none
+ * @note    none
+ */
+void __plat_exit fwk_kobjmap_del(void)
+{
+	/*!< Destroy the character device matching table */
+	fwk_kobjmap_clear(sprt_fwk_chrdev_map);
 	kfree(sprt_fwk_chrdev_map);
 	sprt_fwk_chrdev_map = mrt_nullptr;
 
 	/*!< Destroy the block device matching table */
-	mapsize	= isValid(sprt_fwk_blkdev_map) ? ARRAY_SIZE(sprt_fwk_blkdev_map->sprt_probes) : 0;
-	for (i = 0; i < mapsize; i++)
-	{
-		mrt_list_delete_all(sprt_fwk_blkdev_map->sprt_probes[i],
-										sprt_prev, sprt_list);
-		sprt_fwk_blkdev_map->sprt_probes[i] = mrt_nullptr;
-	}
+	fwk_kobjmap_clear(sprt_fwk_blkdev_map);
 	kfree(sprt_fwk_blkdev_map);
 	sprt_fwk_blkdev_map = mrt_nullptr;
 
 	/*!< Destroy the net device matching table */
-	mapsize	= isValid(sprt_fwk_netdev_map) ? ARRAY_SIZE(sprt_fwk_netdev_map->sprt_probes) : 0;
-	for (i = 0; i < mapsize; i++)
-	{
-		mrt_list_delete_all(sprt_fwk_netdev_map->sprt_probes[i],
-										sprt_prev, sprt_list);
-		sprt_fwk_netdev_map->sprt_probes[i] = mrt_nullptr;
-	}
+	fwk_kobjmap_clear(sprt_fwk_netdev_map);
 	kfree(sprt_fwk_netdev_map);
 	sprt_fwk_netdev_map = mrt_nullptr;
 }
 
 /*!
- * @brief   fwk_kobj_map
- * @param   none
- * @retval  none
- * @note    none
+ * @brief   get the minor table of a major, large enough to hold the minor
+ * @param   domain, major, minor
+ * @retval  minor table, or mrt_nullptr if no memory
+ * @note    the table grows by doubling, the mapped minors are copied to the new one
+ */
+static struct fwk_kobj_minors *fwk_kobjmap_expand(struct fwk_kobj_map *domain, kuint32_t major, kuint32_t minor)
+{
+	struct fwk_kobj_minors *sprt_old;
+	struct fwk_kobj_minors *sprt_new;
+	kuint32_t nr_minors;
+
+	sprt_old = domain->sprt_majors[major];
+	if (sprt_old && (minor < sprt_old->nr_minors))
+		return sprt_old;
+
+	nr_minors = sprt_old ? sprt_old->nr_minors : FWK_KOBJMAP_MINORS_MIN;
+	while (nr_minors <= minor)
+		nr_minors <<= 1;
+
+	sprt_new = (struct fwk_kobj_minors *)kzalloc(sizeof(*sprt_new) + nr_minors * sizeof(void *), GFP_KERNEL);
+	if (!isValid(sprt_new))
+		return mrt_nullptr;
+
+	sprt_new->nr_minors = nr_minors;
+	sprt_new->data = (void **)(sprt_new + 1);
+
+	if (sprt_old)
+	{
+		sprt_new->nr_mapped = sprt_old->nr_mapped;
+		memory_copy(sprt_new->data, sprt_old->data, sprt_old->nr_minors * sizeof(void *));
+	}
+
+	domain->sprt_majors[major] = sprt_new;
+	if (sprt_old)
+		kfree(sprt_old);
+
+	return sprt_new;
+}
+
+/*!
+ * @brief   map (devNum ~ devNum + range - 1) to data
+ * @param   domain, devNum, range, data
+ * @retval  errno
+ * @note    every minor of the range points to data;
+ *          a minor which has been mapped cannot be mapped again
  */
 kint32_t fwk_kobj_map(struct fwk_kobj_map *domain, kuint32_t devNum, kuint32_t range, void *data)
 {
-	struct fwk_probes *sprt_probe;
-	kuint32_t major;
-	kuint32_t majorCnt;
-	kuint32_t i;
-	kusize_t probeMax;
+	struct fwk_kobj_minors *sprt_minors;
+	kuint32_t major, minor;
+	kuint32_t n, next, last;
+	kint32_t retval;
 
-	if (!isValid(domain) || (!isValid(data)))
+	if (!isValid(domain) || (!isValid(data)) || (!range))
 		return -ER_FAULT;
 
-	/*!< The maximum number of primary devices that can be supported */
-	probeMax = ARRAY_SIZE(domain->sprt_probes);
+	last = devNum + range - 1;
+	if ((last < devNum) || (GET_DEV_MAJOR(last) >= ARRAY_SIZE(domain->sprt_majors)))
+		return -ER_MORE;
 
-	/*!< The number of master devices, that is, the number of array members occupied by probes */
-	major = GET_DEV_MAJOR(devNum);
-	major = mrt_ret_min2(probeMax, major);
-	majorCnt = GET_DEV_MAJOR(devNum + range) - major + 1;
-	majorCnt = CMP_GT2(major + majorCnt, probeMax, probeMax - major, majorCnt);
+	/*!< A range may cross majors, each major is mapped on its own minor table */
+	for (n = devNum; n <= last; n = next)
+	{
+		major = GET_DEV_MAJOR(n);
+		next = MKE_DEV_NUM(major + 1, 0);
+		next = mrt_ret_min2(last + 1, next);
 
-	sprt_probe = (struct fwk_probes *)kzalloc(sizeof(struct fwk_probes) * majorCnt, GFP_KERNEL);
-	if (!isValid(sprt_probe))
-		return -ER_NOMEM;
+		sprt_minors = fwk_kobjmap_expand(domain, major, GET_DEV_MINOR(next - 1));
+		if (!isValid(sprt_minors))
+		{
+			retval = -ER_NOMEM;
+			goto fail;
+		}
 
-	for (i = 0; i < majorCnt; i++)
-	{
-		struct fwk_probes *sprt_Temp;
-		struct fwk_probes **sprt_Dst;
-		kuint32_t index;
-
-		index = (major + i) % probeMax;
-		sprt_Dst = &domain->sprt_probes[index];
-		sprt_Temp = &sprt_probe[i];
-
-		/*!<
-		 * Regardless of whether the master devices are the same, as long as the same driver calls this API, the data of the master devices is the same
-		 * Each sprt_Temp belongs to the same (devNum ~ devNum + range) range, and the data is the same; and:
-		 * 		1) kobj doesn't need to worry about invalid or duplicate device numbers, as this step has already been done in the fwk_register_chrdev
-		 * 		2) Apply for a sprt_Temp according to the main device number, the purpose is to fill the probes array, 
-		 * 		so as to facilitate the quick location of the master device number;
-		 * 		3) When looking for a device, you just need to determine if the device number is located in (devNum ~ devNum + range), 
-		 * 		you don't have to think about anything else, because:
-		 * 			fwk_register_chrdev have ensured that this range of device numbers cannot be illegal!
-		 */
-		sprt_Temp->data = data;
-		sprt_Temp->devNum = devNum;
-		sprt_Temp->range = range;
-
-		/*!< Sorting: Sort by range, from smallest to largest */
-		/*!< Actually, the ranking here doesn't make much sense, and it's okay not to rank */
-		while ((isValid(*sprt_Dst)) && ((*sprt_Dst)->range < range))
-			sprt_Dst = &(*(sprt_Dst))->sprt_next;
-
-		sprt_Temp->sprt_next = *sprt_Dst;
-		*sprt_Dst = sprt_Temp;
+		/*!< Check first, so that a failure never touches the minors of other devices */
+		for (minor = GET_DEV_MINOR(n); minor <= GET_DEV_MINOR(next - 1); minor++)
+		{
+			if (sprt_minors->data[minor])
+			{
+				retval = -ER_EXISTED;
+				goto fail;
+			}
+		}
+
+		for (minor = GET_DEV_MINOR(n); minor <= GET_DEV_MINOR(next - 1); minor++)
+			sprt_minors->data[minor] = data;
+
+		sprt_minors->nr_mapped += next - n;
 	}
 
 	return ER_NORMAL;
+
+fail:
+	/*!< The number of devices that have been mapped: n - devNum */
+	fwk_kobj_unmap(domain, devNum, n - devNum);
+
+	/*!< The table of the failed major may have been just created */
+	sprt_minors = domain->sprt_majors[GET_DEV_MAJOR(n)];
+	if (sprt_minors && (!sprt_minors->nr_mapped))
+	{
+		domain->sprt_majors[GET_DEV_MAJOR(n)] = mrt_nullptr;
+		kfree(sprt_minors);
+	}
+
+	return retval;
 }
 
 /*!
- * @brief   fwk_kobj_unmap
- * @param   none
- * @retval  none
- * @note    none
+ * @brief   unmap (devNum ~ devNum + range - 1)
+ * @param   domain, devNum, range
+ * @retval  errno
+ * @note    the minor table of a major is freed when nothing is left on it
  */
 kint32_t fwk_kobj_unmap(struct fwk_kobj_map *domain, kuint32_t devNum, kuint32_t range)
 {
-	struct fwk_probes *sprt_Rlt;
-	kuint32_t major;
-	kuint32_t majorCnt;
-	kuint32_t i;
-	kusize_t probeMax;
+	struct fwk_kobj_minors *sprt_minors;
+	kuint32_t major, minor;
+	kuint32_t n, next, last;
 
 	if (!isValid(domain))
 		return -ER_FAULT;
 
-	/*!< The maximum number of primary devices that can be supported */
-	probeMax = ARRAY_SIZE(domain->sprt_probes);
+	if (!range)
+		return ER_NORMAL;
 
-	/*!< The number of master devices, that is, the number of array members occupied by probes */
-	major = GET_DEV_MAJOR(devNum);
-	major = mrt_ret_min2(probeMax, major);
-	majorCnt = GET_DEV_MAJOR(devNum + range) - major + 1;
-	majorCnt = CMP_GT2(major + majorCnt, probeMax, probeMax - major, majorCnt);;
+	last = devNum + range - 1;
+	if ((last < devNum) || (GET_DEV_MAJOR(last) >= ARRAY_SIZE(domain->sprt_majors)))
+		return -ER_MORE;
 
-	for (i = 0, sprt_Rlt = mrt_nullptr; i < majorCnt; i++)
+	for (n = devNum; n <= last; n = next)
 	{
-		struct fwk_probes *sprt_Temp;
-		struct fwk_probes **sprt_Dst;
-		kuint32_t index;
+		major = GET_DEV_MAJOR(n);
+		next = MKE_DEV_NUM(major + 1, 0);
+		next = mrt_ret_min2(last + 1, next);
 
-		index = (major + i) % probeMax;
-		sprt_Dst = &domain->sprt_probes[index];
+		sprt_minors = domain->sprt_majors[major];
+		if (!sprt_minors)
+			continue;
 
-		while (*sprt_Dst)
+		for (minor = GET_DEV_MINOR(n); (minor <= GET_DEV_MINOR(next - 1)) && (minor < sprt_minors->nr_minors); minor++)
 		{
-			if (((*sprt_Dst)->devNum == devNum) && ((*sprt_Dst)->range == range))
+			if (sprt_minors->data[minor])
 			{
-				/*!< Delete the list node */
-				sprt_Temp = *sprt_Dst;
-				*sprt_Dst = sprt_Temp->sprt_next;
-
-				sprt_Rlt = sprt_Rlt ? sprt_Rlt : sprt_Temp;
-				break;
+				sprt_minors->data[minor] = mrt_nullptr;
+				sprt_minors->nr_mapped--;
 			}
+		}
 
-			sprt_Dst = &(*(sprt_Dst))->sprt_next;
+		if (!sprt_minors->nr_mapped)
+		{
+			domain->sprt_majors[major] = mrt_nullptr;
+			kfree(sprt_minors);
 		}
 	}
 
-	if (sprt_Rlt)
-		kfree(sprt_Rlt);
-
 	return ER_NORMAL;
 }
 
 /*!
- * @brief   fwk_kobjmap_lookup
- * @param   none
- * @retval  none
- * @note    none
+ * @brief   find the data mapped to devNum
+ * @param   domain, devNum
+ * @retval  data, or mrt_nullptr if devNum is not mapped
+ * @note    O(1): indexed by major, and then by minor
  */
 void *fwk_kobjmap_lookup(struct fwk_kobj_map *domain, kuint32_t devNum)
 {
-	struct fwk_probes *sprt_Temp;
-	kuint32_t index;
-	void *data;
-	kusize_t probeMax;
+	struct fwk_kobj_minors *sprt_minors;
+	kuint32_t major, minor;
 
 	if (!isValid(domain))
 		return mrt_nullptr;
 
-	/*!< The maximum number of primary devices that can be supported */
-	probeMax = ARRAY_SIZE(domain->sprt_probes);
-	index = GET_DEV_MAJOR(devNum);
-
-	for (sprt_Temp = domain->sprt_probes[index % probeMax]; sprt_Temp; sprt_Temp = sprt_Temp->sprt_next)
-	{
-		/*!< Already found? */
-		/*!< It is determined by the range of device numbers */
-		if ((devNum >= sprt_Temp->devNum) && (devNum <= (sprt_Temp->devNum + sprt_Temp->range - 1)))
-			break;
-	}
+	major = GET_DEV_MAJOR(devNum);
+	minor = GET_DEV_MINOR(devNum);
+	if (major >= ARRAY_SIZE(domain->sprt_majors))
+		return mrt_nullptr;
 
-	data = sprt_Temp ? sprt_Temp->data : mrt_nullptr;
+	sprt_minors = domain->sprt_majors[major];
+	if (!sprt_minors || (minor >= sprt_minors->nr_minors))
+		return mrt_nullptr;
 
-	return (data);
+	return sprt_minors->data[minor];
 }
 
-
 /*!< end of file */
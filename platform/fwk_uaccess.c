@@ -40,4 +40,100 @@ kusize_t fwk_copy_to_user(void *ptr_user, void *ptr_Src, kusize_t size)
 	return size;
 }
 
+/*!
+ * @brief   get the total lenth of iovec
+ * @param   sprt_iov, nr_segs
+ * @retval  total lenth, or errno if the segments are too many or too large
+ * @note    none
+ */
+kssize_t fwk_iov_length(const struct fwk_iovec *sprt_iov, kuint32_t nr_segs)
+{
+	kusize_t total = 0;
+	kuint32_t idx;
+
+	if (!sprt_iov || (nr_segs > FWK_IOV_MAX))
+		return -ER_UNVALID;
+
+	for (idx = 0; idx < nr_segs; idx++)
+	{
+		if ((kssize_t)sprt_iov[idx].iov_len < 0)
+			return -ER_UNVALID;
+
+		/*!< the sum must fit in kssize_t */
+		if (sprt_iov[idx].iov_len > ((kusize_t)(~0U >> 1) - total))
+			return -ER_UNVALID;
+
+		total += sprt_iov[idx].iov_len;
+	}
+
+	return total;
+}
+
+/*!
+ * @brief   gather iovec to a buffer
+ * @param   ptr_dst, sprt_iov, nr_segs, size
+ * @retval  bytes copied
+ * @note    none
+ */
+kusize_t fwk_copy_from_iovec(void *ptr_dst, const struct fwk_iovec *sprt_iov, kuint32_t nr_segs, kusize_t size)
+{
+	kusize_t count, copied = 0;
+	kuint32_t idx;
+
+	for (idx = 0; (idx < nr_segs) && (copied < size); idx++)
+	{
+		count = mrt_ret_min2(sprt_iov[idx].iov_len, size - copied);
+		copied += fwk_copy_from_user((kuint8_t *)ptr_dst + copied, sprt_iov[idx].iov_base, count);
+	}
+
+	return copied;
+}
+
+/*!
+ * @brief   scatter a buffer to iovec
+ * @param   sprt_iov, nr_segs, ptr_src, size
+ * @retval  bytes copied
+ * @note    none
+ */
+kusize_t fwk_copy_to_iovec(const struct fwk_iovec *sprt_iov, kuint32_t nr_segs, void *ptr_src, kusize_t size)
+{
+	kusize_t count, copied = 0;
+	kuint32_t idx;
+
+	for (idx = 0; (idx < nr_segs) && (copied < size); idx++)
+	{
+		count = mrt_ret_min2(sprt_iov[idx].iov_len, size - copied);
+		copied += fwk_copy_to_user(sprt_iov[idx].iov_base, (kuint8_t *)ptr_src + copied, count);
+	}
+
+	return copied;
+}
+
+/*!
+ * @brief   map device memory to a vma
+ * @param   sprt_vma: offset and size are requested by caller
+ * @param   start, len: the memory of the device
+ * @retval  errno
+ * @note    it is called by the driver's mmap op; the memory is accessed directly,
+ *          so that the mapping is just a window of [start, start + len) at vma offset;
+ *          start needs not be page aligned, see fwk_do_mmap()
+ */
+kint32_t fwk_vm_iomap_memory(struct fwk_vm_area *sprt_vma, kuaddr_t start, kusize_t len)
+{
+	kusize_t pages_len = mrt_page_align(len);
+
+	if (!start || !len)
+		return -ER_NSUPPORT;
+
+	if (!mrt_page_aligned(sprt_vma->offset) || (sprt_vma->offset >= pages_len))
+		return -ER_UNVALID;
+
+	if (sprt_vma->size > (pages_len - sprt_vma->offset))
+		return -ER_MORE;
+
+	sprt_vma->virt_addr = start + sprt_vma->offset;
+
+	return ER_NORMAL;
+}
+
 /*!< end of file */
@@ -14,6 +14,7 @@
 #include <platform/fwk_basic.h>
 #include <platform/irq/fwk_irq_types.h>
 #include <platform/irq/fwk_irq_chip.h>
+#include <asm/interrupt.h>
 
 /*!< API function */
 static void fwk_irq_chip_dummy(struct fwk_irq_data *sprt_data) {}
@@ -214,44 +215,121 @@ struct fwk_irq_generic *fwk_irq_get_generic_data(struct fwk_irq_data *sprt_data)
 	return sprt_gc;
 }
 
+/*!
+ * @brief   enable the line on the interrupt controller
+ * @param   sprt_data
+ * @retval  none
+ * @note    none
+ */
+static void __fwk_irq_hw_enable(struct fwk_irq_data *sprt_data)
+{
+	if (sprt_data->sprt_chip->irq_enable)
+		sprt_data->sprt_chip->irq_enable(sprt_data);
+	else if (sprt_data->sprt_chip->irq_unmask)
+		sprt_data->sprt_chip->irq_unmask(sprt_data);
+}
+
+/*!
+ * @brief   disable the line on the interrupt controller
+ * @param   sprt_data
+ * @retval  none
+ * @note    none
+ */
+static void __fwk_irq_hw_disable(struct fwk_irq_data *sprt_data)
+{
+	if (sprt_data->sprt_chip->irq_disable)
+		sprt_data->sprt_chip->irq_disable(sprt_data);
+	else if (sprt_data->sprt_chip->irq_mask)
+		sprt_data->sprt_chip->irq_mask(sprt_data);
+}
+
 /*!
  * @brief   irq enable
  * @param   irq
  * @retval  none
- * @note    none
+ * @note    the hardware is only touched if the line was really masked;
+ *          an edge held back while disabled is resent through the controller
  */
 void fwk_enable_irq(kint32_t irq)
 {
 	struct fwk_irq_data *sprt_data;
+	struct fwk_irq_desc *sprt_desc;
+	kuint32_t istate, flags;
 
 	sprt_data = fwk_irq_get_data(irq);
 	if (!sprt_data)
 		return;
 
-	if (sprt_data->sprt_chip->irq_enable)
-		sprt_data->sprt_chip->irq_enable(sprt_data);
-	else if (sprt_data->sprt_chip->irq_mask)
-		sprt_data->sprt_chip->irq_mask(sprt_data);
+	sprt_desc = fwk_irq_data_to_desc(sprt_data);
+
+	mrt_local_irq_save(flags);
+
+	istate = sprt_desc->istate;
+	sprt_desc->istate = 0;
+
+	if (istate & FWK_IRQS_MASKED)
+		__fwk_irq_hw_enable(sprt_data);
+
+	mrt_local_irq_restore(flags);
+
+	/*!< a level interrupt is raised again by the device itself once unmasked */
+	if (!(istate & FWK_IRQS_PENDING) || (sprt_desc->flags & IRQ_TYPE_LEVEL_MASK))
+		return;
+
+	/*!< resent through the controller, so that it is handled on the IRQ path like any other */
+	if (!fwk_irq_trigger(irq))
+		return;
+
+	/*!< the controller can not resend it, so run the handlers here, as if it arrived now */
+	exec_irq_replay(irq);
 }
 
 /*!
  * @brief   irq disable
  * @param   irq
  * @retval  none
- * @note    none
+ * @note    lazy: only a flag is set, the hardware is masked by fwk_irq_lazy_mask() if the interrupt comes
  */
 void fwk_disable_irq(kint32_t irq)
 {
 	struct fwk_irq_data *sprt_data;
+	struct fwk_irq_desc *sprt_desc;
+	kuint32_t flags;
 
 	sprt_data = fwk_irq_get_data(irq);
 	if (!sprt_data)
 		return;
 
-	if (sprt_data->sprt_chip->irq_disable)
-		sprt_data->sprt_chip->irq_disable(sprt_data);
-	else if (sprt_data->sprt_chip->irq_mask)
-		sprt_data->sprt_chip->irq_unmask(sprt_data);
+	sprt_desc = fwk_irq_data_to_desc(sprt_data);
+
+	mrt_local_irq_save(flags);
+	sprt_desc->istate |= FWK_IRQS_DISABLED;
+	mrt_local_irq_restore(flags);
+}
+
+/*!
+ * @brief   hold back an interrupt which arrives while disabled
+ * @param   sprt_desc
+ * @retval  true if the interrupt must not be handled now
+ * @note    called on the IRQ path before the handlers
+ */
+kbool_t fwk_irq_lazy_mask(struct fwk_irq_desc *sprt_desc)
+{
+	kuint32_t flags;
+
+	if (mrt_likely(!(sprt_desc->istate & FWK_IRQS_DISABLED)))
+		return false;
+
+	mrt_local_irq_save(flags);
+
+	if (!(sprt_desc->istate & FWK_IRQS_MASKED))
+		__fwk_irq_hw_disable(&sprt_desc->sgrt_data);
+
+	sprt_desc->istate |= FWK_IRQS_MASKED | FWK_IRQS_PENDING;
+
+	mrt_local_irq_restore(flags);
+
+	return true;
 }
 
 /*!
@@ -280,6 +358,27 @@ void fwk_irq_set_type(kint32_t irq, kuint32_t flags)
 		sprt_data->sprt_chip->irq_set_type(sprt_data, type);
 }
 
+/*!
+ * @brief   set irq priority
+ * @param   irq, priority: FWK_IRQ_PRIORITY_HIGHEST ~ FWK_IRQ_PRIORITY_LOWEST
+ * @retval  none
+ * @note    none
+ */
+void fwk_irq_set_priority(kint32_t irq, kuint32_t priority)
+{
+	struct fwk_irq_data *sprt_data;
+
+	sprt_data = fwk_irq_get_data(irq);
+	if (!sprt_data)
+		return;
+
+	if (priority > FWK_IRQ_PRIORITY_LOWEST)
+		priority = FWK_IRQ_PRIORITY_LOWEST;
+
+	if (sprt_data->sprt_chip->irq_set_priority)
+		sprt_data->sprt_chip->irq_set_priority(sprt_data, priority);
+}
+
 /*!
  * @brief   check if irq is happend
  * @param   irq
@@ -314,10 +413,34 @@ kbool_t fwk_irq_is_enabled(kint32_t irq)
 	if (!sprt_data)
 		return false;
 
+	/*!< lazily disabled: the hardware may still be enabled */
+	if (fwk_irq_data_to_desc(sprt_data)->istate & FWK_IRQS_DISABLED)
+		return false;
+
 	if (sprt_data->sprt_chip->irq_is_enabled)
 		return sprt_data->sprt_chip->irq_is_enabled(sprt_data);
 
 	return false;
 }
 
+/*!
+ * @brief   raise an interrupt by software
+ * @param   irq
+ * @retval  error code
+ * @note    the line is set pending on the interrupt controller, and then handled on the IRQ path as usual
+ */
+kint32_t fwk_irq_trigger(kint32_t irq)
+{
+	struct fwk_irq_data *sprt_data;
+
+	sprt_data = fwk_irq_get_data(irq);
+	if (!sprt_data)
+		return -ER_NODEV;
+
+	if (!sprt_data->sprt_chip->irq_retrigger)
+		return -ER_NSUPPORT;
+
+	return sprt_data->sprt_chip->irq_retrigger(sprt_data) ? ER_NORMAL : -ER_FAILD;
+}
+
 /*!< end of file */
@@ -18,23 +18,19 @@
 #include <platform/irq/fwk_irq_chip.h>
 
 /*!< The defines */
-#define FWK_IRQ_DESC_RADIXTREE				(1)
-#define FWK_IRQ_DESC_MAX					(1024)
-
-/*!< The globals */
-/*!
- * @brief   malloc for radix_node
- * @param   size
- * @retval  none
- * @note    none
+/*!<
+ * virq ---> irq_desc: two-level sparse table
+ * the first level is indexed by (virq >> FWK_IRQ_DESC_CHUNK_SHIFT), the second level by the low bits;
+ * a second-level chunk is allocated on the first irq that falls into it, and is never released
  */
-static void *fwk_irq_radix_node_malloc(kusize_t size)
-{
-	return kmalloc(size, GFP_KERNEL);
-}
+#define FWK_IRQ_DESC_CHUNK_SHIFT			(5)
+#define FWK_IRQ_DESC_CHUNK_SIZE				(1 << FWK_IRQ_DESC_CHUNK_SHIFT)
+#define FWK_IRQ_DESC_CHUNK_MASK				(FWK_IRQ_DESC_CHUNK_SIZE - 1)
+#define FWK_IRQ_DESC_CHUNKS					(FWK_IRQ_DESC_MAX >> FWK_IRQ_DESC_CHUNK_SHIFT)
 
-static DECLARE_RADIX_TREE(sgrt_fwk_irq_radix_tree, fwk_irq_radix_node_malloc, kfree);
-static kuint32_t g_fwk_allocated_irqs[mrt_num_align(FWK_IRQ_DESC_MAX, RET_BITS_PER_INT) / RET_BITS_PER_INT] = { 0 };
+/*!< The globals */
+static struct fwk_irq_desc **g_fwk_irq_desc_table[FWK_IRQ_DESC_CHUNKS] = { mrt_nullptr };
+static DECLARE_BITMAP(g_fwk_allocated_irqs, FWK_IRQ_DESC_MAX) = { 0 };
 
 /*!< API functions */
 /*!
@@ -52,43 +48,42 @@ static struct fwk_irq_desc *fwk_allocate_irq_desc(ert_fwk_mempool_t gfp)
 		return mrt_nullptr;
 
 	init_list_head(&sprt_desc->sgrt_action);
+
+	/*!< the line is off until fwk_enable_irq(), the hardware too */
+	sprt_desc->istate = FWK_IRQS_DISABLED | FWK_IRQS_MASKED;
 		
 	return sprt_desc;
 }
 
 /*!
- * @brief   find irq number that is not used from bitmap
- * @param   bitmap, irq_base, total_bits, nr_irqs
- * @retval  irq number base
+ * @brief   insert irq_desc into the table
+ * @param   virq, sprt_desc (null: remove)
+ * @retval  errno
  * @note    none
  */
-static kint32_t fwk_irq_bitmap_find_areas(kuint32_t *bitmap, kint32_t irq_base, kuint32_t total_bits, kuint32_t nr_irqs)
+static kint32_t fwk_irq_desc_table_set(kuint32_t virq, struct fwk_irq_desc *sprt_desc)
 {
-	kuint32_t index = 0, temp = 0;
+	struct fwk_irq_desc **sprt_chunk;
 
-	index = (irq_base >= 0) ? irq_base : 0;
+	if (virq >= FWK_IRQ_DESC_MAX)
+		return -ER_MORE;
 
-	do 
+	sprt_chunk = g_fwk_irq_desc_table[virq >> FWK_IRQ_DESC_CHUNK_SHIFT];
+	if (!sprt_chunk)
 	{
-		if ((index + nr_irqs) >= total_bits)
-			return -ER_MORE;
+		if (!sprt_desc)
+			return ER_NORMAL;
 
-		/*!< get the first non-zero bit  */
-		index = bitmap_find_first_zero_bit(bitmap, index, total_bits);
-		if (index < 0)
-			return -ER_NOTFOUND;
+		sprt_chunk = (struct fwk_irq_desc **)kzalloc(FWK_IRQ_DESC_CHUNK_SIZE * sizeof(*sprt_chunk), GFP_KERNEL);
+		if (!isValid(sprt_chunk))
+			return -ER_NOMEM;
 
-		/*!< base on index, get nr_irqs consecutive non-zero bits; if success, return 0; otherwise, return index that causing failed */
-		temp = bitmap_find_nr_zero_bit(bitmap, index, total_bits, nr_irqs);
-		if (temp)
-		{
-			index = temp + 1;
-			continue;
-		}
+		g_fwk_irq_desc_table[virq >> FWK_IRQ_DESC_CHUNK_SHIFT] = sprt_chunk;
+	}
 
-	} while (temp);
+	sprt_chunk[virq & FWK_IRQ_DESC_CHUNK_MASK] = sprt_desc;
 
-	return index;
+	return ER_NORMAL;
 }
 
 /*!
@@ -128,26 +123,44 @@ static kint32_t irq_domain_alloc_irq_data(struct fwk_irq_domain *sprt_domain, ku
 static kint32_t fwk_irq_domain_alloc_descs(kint32_t irq_base, kuint32_t nr_irqs)
 {
 	struct fwk_irq_desc *sprt_desc;
-	kuint32_t virq;
+	kint32_t virq;
 
-	virq = fwk_irq_bitmap_find_areas(g_fwk_allocated_irqs, irq_base, FWK_IRQ_DESC_MAX, nr_irqs);
+	/*!< find nr_irqs consecutive irq numbers that are not used */
+	virq = bitmap_find_next_zero_area(g_fwk_allocated_irqs, FWK_IRQ_DESC_MAX, (irq_base >= 0) ? irq_base : 0, nr_irqs);
 	if (virq < 0)
-		return virq;
+		return -ER_MORE;
 
 	/*!< create desc for every irq */
 	for (kuint32_t i = 0; i < nr_irqs; i++)
 	{
 		sprt_desc = fwk_allocate_irq_desc(GFP_KERNEL);
 		if (!isValid(sprt_desc))
-			return -ER_NOMEM;
+			goto fail;
 
 		sprt_desc->irq = virq + i;
-		radix_tree_add(&sgrt_fwk_irq_radix_tree, virq + i, &sprt_desc->sgrt_radix);
+		if (fwk_irq_desc_table_set(virq + i, sprt_desc))
+		{
+			kfree(sprt_desc);
+			goto fail;
+		}
 	}
 
-	bitmap_set_nr_bit_valid(g_fwk_allocated_irqs, virq, FWK_IRQ_DESC_MAX, nr_irqs);
+	bitmap_set(g_fwk_allocated_irqs, virq, nr_irqs);
 
 	return virq;
+
+fail:
+	for (kuint32_t i = 0; i < nr_irqs; i++)
+	{
+		sprt_desc = fwk_irq_to_desc(virq + i);
+		if (!sprt_desc)
+			break;
+
+		fwk_irq_desc_table_set(virq + i, mrt_nullptr);
+		kfree(sprt_desc);
+	}
+
+	return -ER_NOMEM;
 }
 
 /*!< ----------------------------------------------------------- */
@@ -159,10 +172,14 @@ static kint32_t fwk_irq_domain_alloc_descs(kint32_t irq_base, kuint32_t nr_irqs)
  */
 struct fwk_irq_desc *fwk_irq_to_desc(kuint32_t virq)
 {
-	if (virq < 0)
+	struct fwk_irq_desc **sprt_chunk;
+
+	/*!< a negative virq is converted to a large unsigned number, and also rejected here */
+	if (virq >= FWK_IRQ_DESC_MAX)
 		return mrt_nullptr;
-	
-	return radix_tree_next_entry(&sgrt_fwk_irq_radix_tree, struct fwk_irq_desc, sgrt_radix, virq);
+
+	sprt_chunk = g_fwk_irq_desc_table[virq >> FWK_IRQ_DESC_CHUNK_SHIFT];
+	return sprt_chunk ? sprt_chunk[virq & FWK_IRQ_DESC_CHUNK_MASK] : mrt_nullptr;
 }
 
 /*!
@@ -287,11 +304,14 @@ void fwk_irq_desc_free(kint32_t irq)
 	struct fwk_irq_data *sprt_data;
 
 	sprt_desc = fwk_irq_to_desc(irq);
+	if (!isValid(sprt_desc))
+		return;
+
 	sprt_data = &sprt_desc->sgrt_data;
 
-	bitmap_set_nr_bit_zero(g_fwk_allocated_irqs, sprt_data->irq, FWK_IRQ_DESC_MAX, 1);
+	bitmap_clear(g_fwk_allocated_irqs, sprt_data->irq, 1);
 	fwk_destroy_irq_action(sprt_data->irq);
-	radix_tree_del(&sgrt_fwk_irq_radix_tree, sprt_data->irq);
+	fwk_irq_desc_table_set(sprt_data->irq, mrt_nullptr);
 
 	kfree(sprt_desc);
 }
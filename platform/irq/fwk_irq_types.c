@@ -16,8 +16,17 @@
 #include <platform/irq/fwk_irq_chip.h>
 #include <platform/irq/fwk_irq_domain.h>
 #include <platform/of/fwk_of.h>
+#include <platform/fwk_inode.h>
+#include <platform/fwk_fs.h>
+#include <platform/fwk_kobj.h>
+#include <platform/fwk_sysfs.h>
+#include <common/time.h>
+#include <asm/interrupt.h>
 
 /*!< The globals */
+/*!< storm detection, tunable in /sys/irq/ */
+static kuint32_t g_fwk_irq_storm_window = FWK_IRQ_STORM_WINDOW;
+static kuint32_t g_fwk_irq_storm_threshold = FWK_IRQ_STORM_THRESHOLD;
 
 /*!< API function */
 /*!
@@ -52,81 +61,173 @@ void *fwk_find_irq_action(kint32_t irq, const kchar_t *name, void *ptrDev)
 		if (name)
 			retval = strncmp(sprt_action->name, name, FWK_IRQ_DESC_NAME_LENTH);
 
-		if (!retval && (sprt_action->ptrArgs == ptrDev))
+		if (!retval && (sprt_action->dev_id == ptrDev))
 			return sprt_action;
 	}
 
 	return mrt_nullptr;
 }
 
+/*!
+ * @brief  check if a new action can share the line
+ * @param  sprt_desc, flags: of the new action
+ * @retval error code
+ * @note   every action must pass IRQF_SHARED, and the trigger types must not conflict
+ */
+static kint32_t fwk_irq_check_shared(struct fwk_irq_desc *sprt_desc, kuint32_t flags)
+{
+	struct fwk_irq_action *sprt_first;
+	kuint32_t type, new_type;
+
+	sprt_first = mrt_list_first_valid_entry(&sprt_desc->sgrt_action, struct fwk_irq_action, sgrt_link);
+	if (!sprt_first)
+		return ER_NORMAL;
+
+	if (!(sprt_first->flags & flags & IRQF_SHARED))
+		return -ER_BUSY;
+
+	/*!< IRQ_TYPE_NONE keeps the type of the line */
+	type = sprt_first->flags & IRQ_TYPE_SENSE_MASK;
+	new_type = flags & IRQ_TYPE_SENSE_MASK;
+	if (type && new_type && (type != new_type))
+		return -ER_UNVALID;
+
+	return ER_NORMAL;
+}
+
+/*!
+ * @brief  get the trigger type of the line from its actions
+ * @param  sprt_desc
+ * @retval IRQ_TYPE_*, IRQ_TYPE_NONE if no action gives the type
+ * @note   the types of the actions do not conflict, see fwk_irq_check_shared
+ */
+static kuint32_t fwk_irq_actions_type(struct fwk_irq_desc *sprt_desc)
+{
+	struct fwk_irq_action *sprt_action;
+	kuint32_t type = IRQ_TYPE_NONE;
+
+	foreach_list_next_entry(sprt_action, &sprt_desc->sgrt_action, sgrt_link)
+		type |= sprt_action->flags & IRQ_TYPE_SENSE_MASK;
+
+	return type;
+}
+
 /*!
  * @brief  fwk_request_irq
- * @param  none
- * @retval none
- * @note   irq register
+ * @param  irq, handler, flags: IRQ_TYPE_*, IRQF_SHARED, IRQF_PRIORITY()
+ * @param  name, ptrDev: dev_id, must be unique on the line
+ * @retval error code
+ * @note   irq register; the first action sets up and enables the line, the others only join it
  */
 kint32_t fwk_request_irq(kint32_t irq, irq_handler_t handler, kuint32_t flags, const kchar_t *name, void *ptrDev)
 {
 	struct fwk_irq_desc *sprt_desc;
 	struct fwk_irq_action *sprt_action;
 	kuint32_t len = kstrlen(name);
+	kuint32_t irq_flags, type;
+	kbool_t first;
+	kint32_t retval;
 
 	if ((!name) || (!ptrDev))
 		return -ER_FAULT;
 
-	if (fwk_find_irq_action(irq, name, ptrDev))
+	if (len >= sizeof(sprt_action->name))
+		return -ER_CHECKERR;
+
+	if (fwk_find_irq_action(irq, mrt_nullptr, ptrDev))
 		return -ER_EXISTED;
 
 	sprt_desc = fwk_irq_to_desc(irq);
 	if (!isValid(sprt_desc))
 		return -ER_NOMEM;
 
+	retval = fwk_irq_check_shared(sprt_desc, flags);
+	if (retval)
+		return retval;
+
 	sprt_action = (struct fwk_irq_action *)kzalloc(sizeof(*sprt_action), GFP_KERNEL);
 	if (!isValid(sprt_action))
 		return -ER_NOMEM;
 
 	sprt_action->handler = handler ? handler : fwk_default_irq_isr;
 	sprt_action->flags = flags;
-	sprt_action->ptrArgs = ptrDev;
-
-	if (len >= sizeof(sprt_action->name))
-		goto fail;
-	
+	sprt_action->dev_id = ptrDev;
 	kstrcpy(sprt_action->name, name);
-	
-	fwk_irq_set_type(irq, flags);
+
+	type = flags & IRQ_TYPE_SENSE_MASK;
+	first = mrt_list_head_empty(&sprt_desc->sgrt_action);
+
+	/*!< the line takes the type of its actions, instead of the types of all mappings */
+	if (first || (type && (type != (sprt_desc->flags & IRQ_TYPE_SENSE_MASK))))
+	{
+		if (type)
+			sprt_desc->flags = (sprt_desc->flags & ~IRQ_TYPE_SENSE_MASK) | type;
+
+		fwk_irq_set_type(irq, flags);
+	}
+
+	if (first)
+	{
+		sprt_desc->sgrt_stats.storm_disabled = false;
+
+		if (flags & IRQF_PRIORITY_VALID)
+			fwk_irq_set_priority(irq, mrt_irqf_get_priority(flags));
+	}
+
+	/*!< the IRQ path walks the list */
+	mrt_local_irq_save(irq_flags);
 	list_head_add_tail(&sprt_desc->sgrt_action, &sprt_action->sgrt_link);
+	mrt_local_irq_restore(irq_flags);
 
-	fwk_enable_irq(irq);
+	if (first)
+		fwk_enable_irq(irq);
 
 	return ER_NORMAL;
-
-fail:
-	kfree(sprt_action);
-	return -ER_CHECKERR;
 }
 
 /*!
  * @brief  fwk_free_irq
- * @param  none
+ * @param  irq, ptrDev: dev_id passed to fwk_request_irq
  * @retval none
- * @note   irq unregister
+ * @note   irq unregister; only the action of ptrDev is removed, the line is disabled with the last one
  */
 void fwk_free_irq(kint32_t irq, void *ptrDev)
 {
+	struct fwk_irq_desc *sprt_desc;
 	struct fwk_irq_action *sprt_action;
+	kuint32_t irq_flags, type;
+	kbool_t last;
 
 	if ((irq < 0) || (!ptrDev))
 		return;
 
-	fwk_disable_irq(irq);
+	sprt_desc = fwk_irq_to_desc(irq);
+	if (!isValid(sprt_desc))
+		return;
 
 	sprt_action = fwk_find_irq_action(irq, mrt_nullptr, ptrDev);
-	if (isValid(sprt_action))
-	{
-		list_head_del(&sprt_action->sgrt_link);
-		kfree(sprt_action);
-	}
+	if (!isValid(sprt_action))
+		return;
+
+	mrt_local_irq_save(irq_flags);
+	list_head_del(&sprt_action->sgrt_link);
+	last = mrt_list_head_empty(&sprt_desc->sgrt_action);
+
+	/*!< the type of the freed action should not be left on a shared line */
+	type = fwk_irq_actions_type(sprt_desc);
+	if (type && (type != (sprt_desc->flags & IRQ_TYPE_SENSE_MASK)))
+		sprt_desc->flags = (sprt_desc->flags & ~IRQ_TYPE_SENSE_MASK) | type;
+	else
+		type = IRQ_TYPE_NONE;
+
+	mrt_local_irq_restore(irq_flags);
+
+	if (last)
+		fwk_disable_irq(irq);
+	else if (type)
+		fwk_irq_set_type(irq, type);
+
+	kfree(sprt_action);
 }
 
 /*!
@@ -151,6 +252,45 @@ void fwk_destroy_irq_action(kint32_t irq)
 	}
 }
 
+/*!
+ * @brief   account an interrupt, and disable the line if it is storming
+ * @param   sprt_desc, handled, elapsed
+ * @retval  none
+ * @note    none
+ */
+static void fwk_irq_account(struct fwk_irq_desc *sprt_desc, kbool_t handled, kuint32_t elapsed)
+{
+	struct fwk_irq_stats *sprt_stats = &sprt_desc->sgrt_stats;
+
+	sprt_stats->count++;
+	sprt_stats->time_total += elapsed;
+	if (elapsed > sprt_stats->time_max)
+		sprt_stats->time_max = elapsed;
+
+	sprt_stats->window++;
+	if (!handled)
+	{
+		sprt_stats->unhandled++;
+		sprt_stats->window_unhandled++;
+	}
+
+	if (sprt_stats->window < g_fwk_irq_storm_window)
+		return;
+
+	/*!< nobody claims the interrupt, but it keeps coming: a stuck line */
+	if (sprt_stats->window_unhandled >= g_fwk_irq_storm_threshold)
+	{
+		fwk_disable_irq(sprt_desc->irq);
+		sprt_stats->storm_disabled = true;
+
+		print_warn("irq %d: %d of %d interrupts unhandled, disabled\n", 
+						sprt_desc->irq, sprt_stats->window_unhandled, sprt_stats->window);
+	}
+
+	sprt_stats->window = 0;
+	sprt_stats->window_unhandled = 0;
+}
+
 /*!
  * @brief   fwk_do_irq_handler
  * @param   none
@@ -162,6 +302,8 @@ void fwk_do_irq_handler(kint32_t softIrq)
 	struct fwk_irq_desc *sprt_desc;
 	struct fwk_irq_action *sprt_action;
 	kint32_t retval;
+	kuint32_t start;
+	kbool_t handled = false, edge;
 
 	if (softIrq < 0)
 		return;
@@ -169,22 +311,97 @@ void fwk_do_irq_handler(kint32_t softIrq)
 	sprt_desc = fwk_irq_to_desc(softIrq);
 	if (!isValid(sprt_desc))
 		return;
-		
+
+	if (fwk_irq_lazy_mask(sprt_desc))
+		return;
+
+	start = get_time_stamp_usecs();
+
+	sprt_action = mrt_list_first_valid_entry(&sprt_desc->sgrt_action, struct fwk_irq_action, sgrt_link);
+	if (!sprt_action)
+		goto out;
+
+	/*!< exclusive line: only one action */
+	if (mrt_likely(!(sprt_action->flags & IRQF_SHARED)))
+	{
+		handled = (sprt_action->handler(sprt_action->dev_id) >= IRQ_HANDLED);
+		goto out;
+	}
+
+	/*!< 
+	 * shared line: stop at the first device which claims it; a level line is raised again if
+	 * another device is still asserting it, but an edge would be lost, so all edge handlers run
+	 */
+	edge = !!(sprt_desc->flags & IRQ_TYPE_EDGE_BOTH);
+
 	foreach_list_next_entry(sprt_action, &sprt_desc->sgrt_action, sgrt_link)
 	{
-		retval = sprt_action->handler ? sprt_action->handler(sprt_action->ptrArgs) : -1;
-		switch (retval)
+		retval = sprt_action->handler(sprt_action->dev_id);
+		if (retval >= IRQ_HANDLED)
 		{
-			case 0:
+			handled = true;
+			if (!edge)
 				break;
+		}
+	}
 
-			case 1:
-				break;
+out:
+	fwk_irq_account(sprt_desc, handled, get_time_stamp_elapsed(start));
+}
+
+/*!
+ * @brief   print statistics of all irqs, like /proc/interrupts
+ * @param   buf, size
+ * @retval  bytes written
+ * @note    one line per irq that has actions or has been triggered
+ */
+kssize_t fwk_irq_stats_show(kbuffer_t *buf, kssize_t size)
+{
+	struct fwk_irq_desc *sprt_desc;
+	struct fwk_irq_action *sprt_action;
+	struct fwk_irq_stats *sprt_stats;
+	kchar_t line[128];
+	kssize_t offset = 0, lenth;
+	kuint32_t virq;
+
+	if (!buf || (size <= 0))
+		return 0;
 
-			default:
+	lenth = sprintk(line, "irq\thwirq\tcount\tunhandled\ttime_total\ttime_max\tactions\n");
+	lenth = mrt_ret_min2(lenth, size);
+	memory_copy(buf, line, lenth);
+	offset += lenth;
+
+	for (virq = 0; (virq < FWK_IRQ_DESC_MAX) && (offset < size); virq++)
+	{
+		sprt_desc = fwk_irq_to_desc(virq);
+		if (!sprt_desc)
+			continue;
+
+		sprt_stats = &sprt_desc->sgrt_stats;
+		if (mrt_list_head_empty(&sprt_desc->sgrt_action) && !sprt_stats->count)
+			continue;
+
+		lenth = sprintk(line, "%d\t%d\t%d\t%d\t%d\t%d\t", virq, (kint32_t)sprt_desc->sgrt_data.hwirq, 
+						sprt_stats->count, sprt_stats->unhandled, sprt_stats->time_total, sprt_stats->time_max);
+
+		foreach_list_next_entry(sprt_action, &sprt_desc->sgrt_action, sgrt_link)
+		{
+			/*!< leave space for name, and "[disabled]\n" */
+			if ((lenth + FWK_IRQ_DESC_NAME_LENTH + 16) >= (kssize_t)sizeof(line))
 				break;
+
+			lenth += sprintk(line + lenth, "%s ", sprt_action->name);
 		}
+
+		lenth += sprintk(line + lenth, sprt_stats->storm_disabled ? "[disabled]\n" : "\n");
+
+		lenth = mrt_ret_min2(lenth, size - offset);
+		memory_copy(buf + offset, line, lenth);
+		offset += lenth;
 	}
+
+	return offset;
 }
 
 /*!
@@ -209,4 +426,204 @@ void fwk_handle_softirq(kint32_t softIrq, kuint32_t event)
 	}
 }
 
+/*!< -------------------------------------------------------------------------- */
+/*!
+ * @brief   read /sys/interrupts
+ * @param   sprt_file, buf, size, pos
+ * @retval  bytes read
+ * @note    none
+ */
+static kssize_t fwk_irq_stats_file_read(struct fwk_file *sprt_file, kbuffer_t *buf, kssize_t size, kloff_t *pos)
+{
+	kssize_t retval;
+
+	/*!< the whole table is shown by the first read, and the next one reaches the end */
+	if (*pos)
+		return 0;
+
+	retval = fwk_irq_stats_show(buf, size);
+	if (retval > 0)
+		*pos += retval;
+
+	return retval;
+}
+
+static struct fwk_file_oprts sgrt_fwk_irq_stats_oprts =
+{
+	.read = fwk_irq_stats_file_read,
+};
+
+/*!
+ * @brief   show /sys/irq/storm_window
+ * @param   sprt_kobj, sprt_attr, buf
+ * @retval  bytes written
+ * @note    none
+ */
+static kssize_t storm_window_show(struct fwk_kobject *sprt_kobj, struct fwk_attribute *sprt_attr, kchar_t *buf)
+{
+	return sprintk(buf, "%d\n", g_fwk_irq_storm_window);
+}
+
+/*!
+ * @brief   set /sys/irq/storm_window
+ * @param   sprt_kobj, sprt_attr, buf, count
+ * @retval  count, or errno
+ * @note    the window must not be less than the threshold
+ */
+static kssize_t storm_window_store(struct fwk_kobject *sprt_kobj, struct fwk_attribute *sprt_attr, const kchar_t *buf, kusize_t count)
+{
+	kuint32_t value;
+
+	if (kstrtou32(buf, &value) || !value || (value < g_fwk_irq_storm_threshold))
+		return -ER_UNVALID;
+
+	g_fwk_irq_storm_window = value;
+
+	return count;
+}
+
+/*!
+ * @brief   show /sys/irq/storm_threshold
+ * @param   sprt_kobj, sprt_attr, buf
+ * @retval  bytes written
+ * @note    none
+ */
+static kssize_t storm_threshold_show(struct fwk_kobject *sprt_kobj, struct fwk_attribute *sprt_attr, kchar_t *buf)
+{
+	return sprintk(buf, "%d\n", g_fwk_irq_storm_threshold);
+}
+
+/*!
+ * @brief   set /sys/irq/storm_threshold
+ * @param   sprt_kobj, sprt_attr, buf, count
+ * @retval  count, or errno
+ * @note    0 < threshold <= window
+ */
+static kssize_t storm_threshold_store(struct fwk_kobject *sprt_kobj, struct fwk_attribute *sprt_attr, const kchar_t *buf, kusize_t count)
+{
+	kuint32_t value;
+
+	if (kstrtou32(buf, &value) || !value || (value > g_fwk_irq_storm_window))
+		return -ER_UNVALID;
+
+	g_fwk_irq_storm_threshold = value;
+
+	return count;
+}
+
+/*!
+ * @brief   get a copy of the exception entry counters
+ * @param   sprt_stats: copy to
+ * @retval  none
+ * @note    copied with irq disabled, so that the values shown are from the same moment
+ */
+static void fwk_irq_entry_stats_get(struct irq_entry_stats *sprt_stats)
+{
+	kuint32_t flags;
+
+	mrt_local_irq_save(flags);
+	memory_copy(sprt_stats, exec_irq_get_entry_stats(), sizeof(*sprt_stats));
+	mrt_local_irq_restore(flags);
+}
+
+/*!
+ * @brief   show /sys/irq/entry_stats
+ * @param   sprt_kobj, sprt_attr, buf
+ * @retval  bytes written
+ * @note    counters of the IRQ exception entry (drain, coalescing and nesting)
+ */
+static kssize_t entry_stats_show(struct fwk_kobject *sprt_kobj, struct fwk_attribute *sprt_attr, kchar_t *buf)
+{
+	struct irq_entry_stats sgrt_stats;
+
+	fwk_irq_entry_stats_get(&sgrt_stats);
+
+	return sprintk(buf, "entries %d\nhandled %d\nspurious %d\nbudget_exhausted %d\nmax_coalesced %d\n"
+						"nested %d\nmax_nest_level %d\nreplayed %d\n",
+					sgrt_stats.entries, sgrt_stats.handled, sgrt_stats.spurious, sgrt_stats.budget_exhausted,
+					sgrt_stats.max_coalesced, sgrt_stats.nested, sgrt_stats.max_nest_level, sgrt_stats.replayed);
+}
+
+/*!
+ * @brief   show /sys/irq/coalesced
+ * @param   sprt_kobj, sprt_attr, buf
+ * @retval  bytes written
+ * @note    one line per count of interrupts dispatched by an entry, 0 ~ IRQ_DRAIN_BUDGET
+ */
+static kssize_t coalesced_show(struct fwk_kobject *sprt_kobj, struct fwk_attribute *sprt_attr, kchar_t *buf)
+{
+	struct irq_entry_stats sgrt_stats;
+	kssize_t lenth = 0;
+	kuint32_t idx;
+
+	fwk_irq_entry_stats_get(&sgrt_stats);
+
+	for (idx = 0; idx < ARRAY_SIZE(sgrt_stats.coalesced); idx++)
+		lenth += sprintk(buf + lenth, "%d %d\n", idx, sgrt_stats.coalesced[idx]);
+
+	return lenth;
+}
+
+/*!
+ * @brief   show /sys/irq/fiq_stats
+ * @param   sprt_kobj, sprt_attr, buf
+ * @retval  bytes written
+ * @note    none
+ */
+static kssize_t fiq_stats_show(struct fwk_kobject *sprt_kobj, struct fwk_attribute *sprt_attr, kchar_t *buf)
+{
+	struct irq_entry_stats sgrt_stats;
+
+	fwk_irq_entry_stats_get(&sgrt_stats);
+
+	return sprintk(buf, "entries %d\nspurious %d\n", sgrt_stats.fiq_entries, sgrt_stats.fiq_spurious);
+}
+
+static FWK_ATTR_RW(storm_window);
+static FWK_ATTR_RW(storm_threshold);
+static FWK_ATTR_RO(entry_stats);
+static FWK_ATTR_RO(coalesced);
+static FWK_ATTR_RO(fiq_stats);
+
+static struct fwk_attribute *sprt_fwk_irq_attrs[] =
+{
+	&fwk_attr_storm_window,
+	&fwk_attr_storm_threshold,
+	&fwk_attr_entry_stats,
+	&fwk_attr_coalesced,
+	&fwk_attr_fiq_stats,
+	mrt_nullptr,
+};
+
+static const struct fwk_attribute_group sgrt_fwk_irq_attr_group =
+{
+	.name		= "irq",
+	.sprt_attrs	= sprt_fwk_irq_attrs,
+};
+
+/*!
+ * @brief   create /sys/interrupts and /sys/irq/
+ * @param   none
+ * @retval  errno
+ * @note    none
+ */
+kint32_t __plat_init fwk_irq_stats_init(void)
+{
+	struct fwk_kobject *sprt_kobj;
+
+	sprt_kobj = fwk_kobject_populate(mrt_nullptr, FWK_PATH_SYSTEM "interrupts");
+	if (!isValid(sprt_kobj))
+		return PTR_ERR(sprt_kobj);
+
+	sprt_kobj->sprt_inode->sprt_foprts = &sgrt_fwk_irq_stats_oprts;
+
+	/*!< the tunables and counters are optional, storm detection works with the defaults */
+	sprt_kobj = fwk_find_kobject_by_path(mrt_nullptr, FWK_PATH_SYSTEM);
+	if (isValid(sprt_kobj))
+		fwk_sysfs_create_group(sprt_kobj, &sgrt_fwk_irq_attr_group);
+
+	return ER_NORMAL;
+}
+IMPORT_PLATFORM_INIT(fwk_irq_stats_init);
+
 /* end of file */
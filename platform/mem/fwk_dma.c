@@ -0,0 +1,255 @@
+/*
+ * DMA Mapping Management
+ *
+ * File Name:   fwk_dma.c
+ * Author:      Yang Yujun
+ * E-mail:      <yujiantianhu@163.com>
+ * Created on:  2024.06.05
+ *
+ * Copyright (c) 2024   Yang Yujun <yujiantianhu@163.com>
+ *
+ */
+
+/*!< The includes */
+#include <boot/boot_text.h>
+#include <platform/fwk_dma.h>
+#include <kernel/spinlock.h>
+
+/*!< The globals */
+/*!<
+ * coherent buffers are allocated from ".dma_pool" (see cpu_ramboot.lds),
+ * this area is mapped as normal uncached memory, so that cpu and device can always see the same data
+ */
+static struct mem_info sgrt_fwk_dma_mem_info =
+{
+	.base	= 0,
+	.lenth	= 0,
+
+	.sprt_mem = mrt_nullptr,
+};
+
+static DECLARE_SPIN_LOCK(sgrt_fwk_dma_lock);
+
+/*!< API function */
+/*!
+ * @brief   check if address is in dma coherent pool
+ * @param   addr
+ * @retval  yes or not
+ * @note    none
+ */
+static kbool_t fwk_dma_is_coherent(kuaddr_t addr)
+{
+	return ((addr >= DMA_POOL_BASE) && (addr < (DMA_POOL_BASE + DMA_POOL_SIZE)));
+}
+
+/*!
+ * @brief   allocate coherent memory
+ * @param   sprt_dev: reserved for per-device pool
+ * @param   size, dma_handle: device address
+ * @param   flags: GFP_KERNEL, GFP_ZERO, ...
+ * @retval  cpu address
+ * @note    the address is aligned with FWK_DMA_COHERENT_ALIGN
+ */
+void *fwk_dma_alloc_coherent(struct fwk_device *sprt_dev, kusize_t size, dma_addr_t *dma_handle, ert_fwk_mempool_t flags)
+{
+	struct mem_info *sprt_info = &sgrt_fwk_dma_mem_info;
+	kuaddr_t raw, addr;
+
+	if (!size || !dma_handle)
+		return mrt_nullptr;
+
+	spin_lock_irqsave(&sgrt_fwk_dma_lock);
+
+	if (!isValid(sprt_info->sprt_mem))
+		memory_simple_block_create(sprt_info, DMA_POOL_BASE, DMA_POOL_SIZE);
+
+	/*!< the real address is saved in front of the aligned address, which is used by free */
+	raw = (kuaddr_t)alloc_spare_simple_memory(sprt_info->sprt_mem, size + FWK_DMA_COHERENT_ALIGN + sizeof(kuaddr_t));
+
+	spin_unlock_irqrestore(&sgrt_fwk_dma_lock);
+
+	if (!raw)
+		return mrt_nullptr;
+
+	addr = mrt_align(raw + sizeof(kuaddr_t), FWK_DMA_COHERENT_ALIGN);
+	*((kuaddr_t *)addr - 1) = raw;
+
+	if (flags & NR_KMEM_ZERO)
+		memory_reset((void *)addr, size);
+
+	*dma_handle = (dma_addr_t)addr;
+
+	return (void *)addr;
+}
+
+/*!
+ * @brief   free coherent memory
+ * @param   sprt_dev, size, cpu_addr, dma_handle
+ * @retval  none
+ * @note    none
+ */
+void fwk_dma_free_coherent(struct fwk_device *sprt_dev, kusize_t size, void *cpu_addr, dma_addr_t dma_handle)
+{
+	struct mem_info *sprt_info = &sgrt_fwk_dma_mem_info;
+
+	if (!isValid(cpu_addr) || !fwk_dma_is_coherent((kuaddr_t)cpu_addr))
+		return;
+
+	spin_lock_irqsave(&sgrt_fwk_dma_lock);
+	free_employ_simple_memory(sprt_info->sprt_mem, (void *)(*((kuaddr_t *)cpu_addr - 1)));
+	spin_unlock_irqrestore(&sgrt_fwk_dma_lock);
+}
+
+/*!
+ * @brief   hand over the buffer to device
+ * @param   addr, size, dir
+ * @retval  none
+ * @note    none
+ */
+static void __fwk_dma_sync_for_device(kuaddr_t addr, kusize_t size, enum fwk_dma_data_direction dir)
+{
+	if (!size || fwk_dma_is_coherent(addr))
+		return;
+
+	switch (dir)
+	{
+		case NR_DMA_TO_DEVICE:
+			hw_dcache_clean_range(addr, addr + size);
+			break;
+
+		/*!< 
+		 * the lines must be dropped before device writes:
+		 * if a dirty line is evicted during transfer, it will overwrite the data written by device
+		 */
+		case NR_DMA_FROM_DEVICE:
+			hw_dcache_inv_range(addr, addr + size);
+			break;
+
+		case NR_DMA_BIDIRECTIONAL:
+			hw_dcache_flush_range(addr, addr + size);
+			break;
+
+		default:
+			break;
+	}
+}
+
+/*!
+ * @brief   hand over the buffer to cpu
+ * @param   addr, size, dir
+ * @retval  none
+ * @note    cpu may prefetch lines speculatively during transfer, drop them again
+ */
+static void __fwk_dma_sync_for_cpu(kuaddr_t addr, kusize_t size, enum fwk_dma_data_direction dir)
+{
+	if (!size || fwk_dma_is_coherent(addr))
+		return;
+
+	if ((dir == NR_DMA_FROM_DEVICE) || (dir == NR_DMA_BIDIRECTIONAL))
+		hw_dcache_inv_range(addr, addr + size);
+}
+
+/*!
+ * @brief   map a buffer for streaming DMA
+ * @param   sprt_dev, ptr, size, dir
+ * @retval  device address
+ * @note    buffer of NR_DMA_FROM_DEVICE should be aligned with cache line, 
+ *          otherwise the data sharing the edge lines may be lost
+ */
+dma_addr_t fwk_dma_map_single(struct fwk_device *sprt_dev, void *ptr, kusize_t size, enum fwk_dma_data_direction dir)
+{
+	if (!isValid(ptr) || (dir >= NR_DMA_NONE))
+		return FWK_DMA_MAPPING_ERROR;
+
+	__fwk_dma_sync_for_device((kuaddr_t)ptr, size, dir);
+
+	/*!< physical address = virtual address */
+	return (dma_addr_t)ptr;
+}
+
+/*!
+ * @brief   unmap a buffer of streaming DMA
+ * @param   sprt_dev, addr, size, dir
+ * @retval  none
+ * @note    call it after transfer, before cpu accesses the buffer
+ */
+void fwk_dma_unmap_single(struct fwk_device *sprt_dev, dma_addr_t addr, kusize_t size, enum fwk_dma_data_direction dir)
+{
+	if (addr == FWK_DMA_MAPPING_ERROR)
+		return;
+
+	__fwk_dma_sync_for_cpu((kuaddr_t)addr, size, dir);
+}
+
+/*!
+ * @brief   give the mapped buffer back to cpu temporarily
+ * @param   sprt_dev, addr, size, dir
+ * @retval  none
+ * @note    none
+ */
+void fwk_dma_sync_single_for_cpu(struct fwk_device *sprt_dev, dma_addr_t addr, kusize_t size, enum fwk_dma_data_direction dir)
+{
+	__fwk_dma_sync_for_cpu((kuaddr_t)addr, size, dir);
+}
+
+/*!
+ * @brief   give the mapped buffer back to device
+ * @param   sprt_dev, addr, size, dir
+ * @retval  none
+ * @note    none
+ */
+void fwk_dma_sync_single_for_device(struct fwk_device *sprt_dev, dma_addr_t addr, kusize_t size, enum fwk_dma_data_direction dir)
+{
+	__fwk_dma_sync_for_device((kuaddr_t)addr, size, dir);
+}
+
+/*!
+ * @brief   map scatterlist for streaming DMA
+ * @param   sprt_dev, sprt_sg, nents, dir
+ * @retval  the number of mapped segments, 0 if failed
+ * @note    segments are not merged
+ */
+kint32_t fwk_dma_map_sg(struct fwk_device *sprt_dev, struct fwk_scatterlist *sprt_sg, kint32_t nents, enum fwk_dma_data_direction dir)
+{
+	kint32_t idx;
+
+	if (!isValid(sprt_sg) || (nents <= 0))
+		return 0;
+
+	for (idx = 0; idx < nents; idx++)
+	{
+		sprt_sg[idx].dma_address = fwk_dma_map_single(sprt_dev, sprt_sg[idx].buf, sprt_sg[idx].length, dir);
+		if (sprt_sg[idx].dma_address == FWK_DMA_MAPPING_ERROR)
+			goto fail;
+
+		sprt_sg[idx].dma_length = sprt_sg[idx].length;
+	}
+
+	return nents;
+
+fail:
+	fwk_dma_unmap_sg(sprt_dev, sprt_sg, idx, dir);
+	return 0;
+}
+
+/*!
+ * @brief   unmap scatterlist
+ * @param   sprt_dev, sprt_sg, nents: the same as the one passed to fwk_dma_map_sg
+ * @retval  none
+ * @note    none
+ */
+void fwk_dma_unmap_sg(struct fwk_device *sprt_dev, struct fwk_scatterlist *sprt_sg, kint32_t nents, enum fwk_dma_data_direction dir)
+{
+	kint32_t idx;
+
+	if (!isValid(sprt_sg))
+		return;
+
+	for (idx = 0; idx < nents; idx++)
+	{
+		fwk_dma_unmap_single(sprt_dev, sprt_sg[idx].dma_address, sprt_sg[idx].dma_length, dir);
+		sprt_sg[idx].dma_length = 0;
+	}
+}
+
+/* end of file */
@@ -0,0 +1,120 @@
+/*
+ * Device Memory Mapping
+ *
+ * File Name:   fwk_ioremap.c
+ * Author:      Yang Yujun
+ * E-mail:      <yujiantianhu@163.com>
+ * Created on:  2024.06.08
+ *
+ * Copyright (c) 2024   Yang Yujun <yujiantianhu@163.com>
+ *
+ */
+
+/*!< The includes */
+#include <platform/fwk_basic.h>
+#include <kernel/spinlock.h>
+#include <asm/mmu.h>
+
+/*!< The defines */
+/*!< virtual window after DDR, it is not used by physical memory */
+#define FWK_IOREMAP_BASE									(CONFIG_RAM_DDR_ORIGIN + CONFIG_RAM_DDR_LENTH)
+#define FWK_IOREMAP_SLOTS									(32)
+
+struct fwk_ioremap_slot
+{
+	kuaddr_t phys;											/*!< section address */
+	kuint32_t refcnt;
+};
+
+/*!< The globals */
+static struct fwk_ioremap_slot sgrt_fwk_ioremap_slots[FWK_IOREMAP_SLOTS];
+static DECLARE_SPIN_LOCK(sgrt_fwk_ioremap_lock);
+
+/*!< API function */
+/*!
+ * @brief   get mapped address
+ * @param   phy_addr
+ * @retval  virtual address (mrt_nullptr if failed)
+ * @note    peripherals (lower than DDR) are flat mapped as device memory by "_mmu_page_init",
+ *          the physical address is returned directly;
+ *          others are mapped to ioremap window by section, and sections are shared between callers.
+ *          do not access the same memory via cacheable address at the same time
+ */
+void *fwk_io_remap(void *phy_addr)
+{
+	struct fwk_ioremap_slot *sprt_slot;
+	kuaddr_t phys, section;
+	kint32_t idx, free = -1;
+
+	phys = (kuaddr_t)phy_addr;
+	if (!phys)
+		return mrt_nullptr;
+
+	if ((!mmu_is_enabled()) || (phys < CONFIG_RAM_DDR_ORIGIN))
+		return phy_addr;
+
+	section = phys & ~(MMU_SECTION_SIZE - 1);
+
+	spin_lock_irqsave(&sgrt_fwk_ioremap_lock);
+
+	for (idx = 0; idx < FWK_IOREMAP_SLOTS; idx++)
+	{
+		sprt_slot = &sgrt_fwk_ioremap_slots[idx];
+
+		if (sprt_slot->refcnt && (sprt_slot->phys == section))
+		{
+			sprt_slot->refcnt++;
+			goto found;
+		}
+
+		if ((!sprt_slot->refcnt) && (free < 0))
+			free = idx;
+	}
+
+	if (free < 0)
+	{
+		spin_unlock_irqrestore(&sgrt_fwk_ioremap_lock);
+		return mrt_nullptr;
+	}
+
+	idx = free;
+	sprt_slot = &sgrt_fwk_ioremap_slots[idx];
+	sprt_slot->phys = section;
+	sprt_slot->refcnt = 1;
+
+	mmu_section_map(FWK_IOREMAP_BASE + (idx << MMU_SECTION_SHIFT), section, MMU_SECTION_SIZE, MMU_SECT_DEVICE);
+
+found:
+	spin_unlock_irqrestore(&sgrt_fwk_ioremap_lock);
+
+	return (void *)(FWK_IOREMAP_BASE + (idx << MMU_SECTION_SHIFT) + (phys - section));
+}
+
+/*!
+ * @brief   put mapped address
+ * @param   virt_addr
+ * @retval  none
+ * @note    release virt_addr, the section is unmapped when it is no longer used
+ */
+void fwk_io_unmap(void *virt_addr)
+{
+	struct fwk_ioremap_slot *sprt_slot;
+	kuaddr_t virt;
+	kuint32_t idx;
+
+	virt = (kuaddr_t)virt_addr;
+	if ((virt < FWK_IOREMAP_BASE) || (virt >= (FWK_IOREMAP_BASE + (FWK_IOREMAP_SLOTS << MMU_SECTION_SHIFT))))
+		return;
+
+	idx = (virt - FWK_IOREMAP_BASE) >> MMU_SECTION_SHIFT;
+	sprt_slot = &sgrt_fwk_ioremap_slots[idx];
+
+	spin_lock_irqsave(&sgrt_fwk_ioremap_lock);
+
+	if (sprt_slot->refcnt && !(--sprt_slot->refcnt))
+		mmu_section_unmap(FWK_IOREMAP_BASE + (idx << MMU_SECTION_SHIFT), MMU_SECTION_SIZE);
+
+	spin_unlock_irqrestore(&sgrt_fwk_ioremap_lock);
+}
+
+/* end of file */